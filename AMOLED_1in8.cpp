@@ -249,10 +249,20 @@ void AMOLED_1IN8_DisplayWindows(uint32_t Xstart, uint32_t Ystart, uint32_t Xend,
     QSPI_4Wrie_Mode(&qspi);
     channel_config_set_dreq(&c, pio_get_dreq(qspi.pio, qspi.sm, true));
 
+    // Full-width rows are contiguous in the framebuffer: one transfer
+    if (Xstart == 0 && Xend == AMOLED_1IN8.WIDTH) {
+        dma_channel_configure(dma_tx, &c, &qspi.pio->txf[qspi.sm],
+                              (UBYTE *)Image + Ystart * AMOLED_1IN8.WIDTH * 2,
+                              (Yend - Ystart) * AMOLED_1IN8.WIDTH * 2, true);
+        while(dma_channel_is_busy(dma_tx));
+        QSPI_Deselect(qspi);
+        return;
+    }
+
     int i;
     uint32_t pixel_offset;
     UBYTE *partial_image;
-    for (i = Ystart; i < Yend - 1; i++) {
+    for (i = Ystart; i < Yend; i++) {
         pixel_offset = (i * AMOLED_1IN8.WIDTH + Xstart) * 2;
         partial_image = (UBYTE *)Image + pixel_offset;
         dma_channel_configure(dma_tx, 
@@ -48,6 +48,9 @@ void AMOLED_1IN8_Init();
 void AMOLED_1IN8_SetBrightness(uint8_t brightness);
 void AMOLED_1IN8_SetWindows(uint32_t Xstart, uint32_t Ystart, uint32_t Xend, uint32_t Yend);
 void AMOLED_1IN8_Display(UWORD *Image);
+// Send Image's rectangle [Xstart, Xend) x [Ystart, Yend) to the same place on the panel.
+// The panel takes windows in 2-pixel units: Xstart, Ystart and the width and
+// height must all be even, or the update is drawn misplaced.
 void AMOLED_1IN8_DisplayWindows(uint32_t Xstart, uint32_t Ystart, uint32_t Xend, uint32_t Yend, UWORD *Image);
 void AMOLED_1IN8_Clear(UWORD Color);
 
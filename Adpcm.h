@@ -0,0 +1,123 @@
+/*
+ * Adpcm.h - IMA-ADPCM codec for flash-resident audio clips
+ *
+ * Mono IMA-ADPCM in independent blocks, as in IMA WAV files: each block
+ * starts with the first sample verbatim and the step index, followed by
+ * 4-bit codes (low nibble first), so a block decodes without any earlier
+ * state and a clip of N bytes holds about 2N samples (4:1 against
+ * 16-bit PCM). A clip is an AdpcmHeader followed by its blocks; the last
+ * block may be partly unused.
+ *
+ * The codec is inline and dependency-free so the host tools
+ * (tools/adpcm_encoder, tools/asset_packer) produce exactly what
+ * SamplePlayer decodes.
+ */
+
+#ifndef ADPCM_H
+#define ADPCM_H
+
+#include <stdint.h>
+
+#define ADPCM_BLOCK_BYTES  256       // default: 505 samples per block
+
+struct AdpcmHeader {
+  uint32_t sample_count;
+  uint16_t block_bytes;              // including the 4-byte block header
+  uint16_t reserved;
+};
+
+struct AdpcmState {
+  int32_t predictor;
+  int32_t index;
+};
+
+static const int16_t ADPCM_STEPS[89] = {
+  7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+  50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+  253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+  1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+  3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+  11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+  32767
+};
+
+static const int8_t ADPCM_INDEX_ADJUST[16] = {
+  -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+static inline uint32_t adpcm_samples_per_block(uint16_t block_bytes) {
+  return (uint32_t)(block_bytes - 4) * 2 + 1;
+}
+
+static inline int16_t adpcm_decode_nibble(AdpcmState &st, uint8_t code) {
+  int32_t step = ADPCM_STEPS[st.index];
+  int32_t diff = step >> 3;
+  if (code & 1) diff += step >> 2;
+  if (code & 2) diff += step >> 1;
+  if (code & 4) diff += step;
+  st.predictor += (code & 8) ? -diff : diff;
+  if (st.predictor > 32767) st.predictor = 32767;
+  if (st.predictor < -32768) st.predictor = -32768;
+  st.index += ADPCM_INDEX_ADJUST[code];
+  if (st.index < 0) st.index = 0;
+  if (st.index > 88) st.index = 88;
+  return (int16_t)st.predictor;
+}
+
+static inline uint8_t adpcm_encode_sample(AdpcmState &st, int16_t sample) {
+  int32_t step = ADPCM_STEPS[st.index];
+  int32_t diff = sample - st.predictor;
+  uint8_t code = 0;
+  if (diff < 0) {
+    code = 8;
+    diff = -diff;
+  }
+  if (diff >= step) { code |= 4; diff -= step; }
+  step >>= 1;
+  if (diff >= step) { code |= 2; diff -= step; }
+  step >>= 1;
+  if (diff >= step) code |= 1;
+  adpcm_decode_nibble(st, code);     // track exactly what the decoder will see
+  return code;
+}
+
+// Encode up to one block of pcm into out (block_bytes long); returns the
+// samples consumed. st carries the step index across blocks.
+static inline uint32_t adpcm_encode_block(AdpcmState &st, const int16_t *pcm, uint32_t count,
+                                          uint8_t *out, uint16_t block_bytes) {
+  uint32_t n = adpcm_samples_per_block(block_bytes);
+  if (n > count) n = count;
+  st.predictor = pcm[0];
+  out[0] = (uint8_t)pcm[0];
+  out[1] = (uint8_t)((uint16_t)pcm[0] >> 8);
+  out[2] = (uint8_t)st.index;
+  out[3] = 0;
+  for (uint16_t i = 4; i < block_bytes; i++) out[i] = 0;
+  for (uint32_t i = 1; i < n; i++) {
+    uint8_t code = adpcm_encode_sample(st, pcm[i]);
+    uint32_t nib = i - 1;
+    out[4 + nib / 2] |= (nib & 1) ? code << 4 : code;
+  }
+  return n;
+}
+
+// Bytes for a whole clip: the header plus every block
+static inline uint32_t adpcm_clip_bytes(uint32_t count, uint16_t block_bytes) {
+  uint32_t per = adpcm_samples_per_block(block_bytes);
+  return sizeof(AdpcmHeader) + (count + per - 1) / per * block_bytes;
+}
+
+// Encode a whole clip into out (adpcm_clip_bytes long); returns the bytes written
+static inline uint32_t adpcm_encode_clip(const int16_t *pcm, uint32_t count, uint8_t *out, uint16_t block_bytes) {
+  AdpcmHeader h = { count, block_bytes, 0 };
+  const uint8_t *hp = (const uint8_t *)&h;
+  for (uint32_t i = 0; i < sizeof(h); i++) out[i] = hp[i];
+  AdpcmState st = { 0, 0 };
+  uint32_t at = sizeof(h);
+  for (uint32_t done = 0; done < count; at += block_bytes) {
+    done += adpcm_encode_block(st, pcm + done, count - done, out + at, block_bytes);
+  }
+  return at;
+}
+
+#endif // ADPCM_H
@@ -0,0 +1,359 @@
+/*
+ * Alarms.cpp - Alarm clock and countdown timers implementation
+ */
+
+#include "Alarms.h"
+#include "RtcClock.h"
+#include "GameAudio.h"
+
+// Entries that come due longer ago than this (clock set forward, watch
+// was off) are rescheduled silently instead of ringing
+#define ALARM_STALE_S 600
+
+// Ring pattern, repeated until snoozed, dismissed or timed out
+struct RingStep { uint16_t freq_hz; uint16_t ms; };   // freq 0 = pause
+static const RingStep RING_PATTERN[] = {
+  {1200, 120}, {0, 80}, {1200, 120}, {0, 80}, {1200, 120}, {0, 480}
+};
+static const uint8_t RING_STEPS = sizeof(RING_PATTERN) / sizeof(RING_PATTERN[0]);
+
+static Alarm    table[ALARM_MAX];
+static bool     slot_used[ALARM_MAX];
+static uint8_t  next_id = 0;
+
+// Min-heap of table slots keyed by next_fire
+static uint8_t  heap[ALARM_MAX];
+static int8_t   heap_pos[ALARM_MAX];     // slot -> heap index, -1 if not armed
+static uint8_t  heap_count = 0;
+static uint32_t programmed = 0;          // epoch loaded into the RTC alarm, 0 = none
+
+static AlarmRingFn ring_fn = nullptr;
+static int8_t   ringing_slot = -1;
+static uint32_t ring_start_ms = 0;
+static uint32_t ring_step_ms = 0;
+static uint8_t  ring_step = 0;
+
+// ---------- Heap ----------
+
+static inline uint32_t key(uint8_t i) {
+  return table[heap[i]].next_fire;
+}
+
+static void heap_swap(uint8_t i, uint8_t j) {
+  uint8_t t = heap[i]; heap[i] = heap[j]; heap[j] = t;
+  heap_pos[heap[i]] = i;
+  heap_pos[heap[j]] = j;
+}
+
+static void sift_up(uint8_t i) {
+  while (i > 0) {
+    uint8_t parent = (i - 1) / 2;
+    if (key(parent) <= key(i)) break;
+    heap_swap(i, parent);
+    i = parent;
+  }
+}
+
+static void sift_down(uint8_t i) {
+  for (;;) {
+    uint8_t l = 2 * i + 1, r = l + 1, m = i;
+    if (l < heap_count && key(l) < key(m)) m = l;
+    if (r < heap_count && key(r) < key(m)) m = r;
+    if (m == i) break;
+    heap_swap(i, m);
+    i = m;
+  }
+}
+
+static void heap_insert(uint8_t slot) {
+  uint8_t i = heap_count++;
+  heap[i] = slot;
+  heap_pos[slot] = i;
+  sift_up(i);
+}
+
+static void heap_remove(uint8_t slot) {
+  int8_t i = heap_pos[slot];
+  if (i < 0) return;
+  heap_pos[slot] = -1;
+  if (--heap_count == i) return;
+  // Move the last leaf into the hole and restore order in either direction
+  heap[i] = heap[heap_count];
+  heap_pos[heap[i]] = i;
+  sift_down(i);
+  sift_up(i);
+}
+
+// ---------- Scheduling ----------
+
+// Next occurrence of hour:minute strictly after now on an allowed weekday
+static uint32_t next_fire_for(const Alarm &a, uint32_t now) {
+  uint32_t day0 = now - now % 86400UL;
+  uint32_t tod = a.hour * 3600UL + a.minute * 60UL;
+  for (uint8_t d = 0; d <= 7; d++) {
+    uint32_t t = day0 + d * 86400UL + tod;
+    if (t <= now) continue;
+    uint8_t wd = (6 + t / 86400UL) % 7;   // 2000-01-01 was a Saturday
+    if (a.days == ALARM_ONCE || (a.days & (1 << wd))) return t;
+  }
+  return day0 + 86400UL + tod;
+}
+
+// Only the earliest entry lives in the RTC
+static void program_rtc() {
+  uint32_t want = heap_count ? key(0) : 0;
+  if (want == programmed) return;
+  if (want) rtc_clock_set_alarm(want);
+  else rtc_clock_clear_alarm();
+  programmed = want;
+}
+
+static void arm(uint8_t slot, uint32_t now) {
+  Alarm &a = table[slot];
+  heap_remove(slot);
+  if (!a.enabled) return;
+  if (!a.snoozed && a.kind == ALARM_KIND_ALARM) a.next_fire = next_fire_for(a, now);
+  heap_insert(slot);
+}
+
+static void free_slot(uint8_t slot) {
+  heap_remove(slot);
+  slot_used[slot] = false;
+}
+
+static int8_t alloc_slot() {
+  for (uint8_t i = 0; i < ALARM_MAX; i++) {
+    if (slot_used[i]) continue;
+    slot_used[i] = true;
+    heap_pos[i] = -1;
+    // ids stay unique among live entries
+    for (;;) {
+      uint8_t id = next_id++;
+      bool taken = false;
+      for (uint8_t j = 0; j < ALARM_MAX; j++) {
+        if (j != i && slot_used[j] && table[j].id == id) { taken = true; break; }
+      }
+      if (!taken) { table[i].id = id; break; }
+    }
+    return i;
+  }
+  return -1;
+}
+
+static int8_t slot_of(uint8_t id) {
+  for (uint8_t i = 0; i < ALARM_MAX; i++) {
+    if (slot_used[i] && table[i].id == id) return i;
+  }
+  return -1;
+}
+
+// Ring finished (dismissed, timed out or stale): schedule what comes next
+static void complete(uint8_t slot, uint32_t now) {
+  Alarm &a = table[slot];
+  a.snoozed = false;
+  if (a.kind == ALARM_KIND_TIMER) {
+    free_slot(slot);
+    return;
+  }
+  if (a.days == ALARM_ONCE) a.enabled = false;
+  arm(slot, now);
+}
+
+// ---------- Public API ----------
+
+void alarms_init(AlarmRingFn on_ring) {
+  ring_fn = on_ring;
+  memset(slot_used, 0, sizeof(slot_used));
+  memset(heap_pos, -1, sizeof(heap_pos));
+  heap_count = 0;
+  ringing_slot = -1;
+  programmed = 1;                        // force the RTC alarm off
+  program_rtc();
+}
+
+int8_t alarm_add(uint8_t hour, uint8_t minute, uint8_t days, bool enabled) {
+  int8_t slot = alloc_slot();
+  if (slot < 0) return -1;
+  Alarm &a = table[slot];
+  a.kind = ALARM_KIND_ALARM;
+  a.hour = hour;
+  a.minute = minute;
+  a.days = days;
+  a.enabled = enabled;
+  a.snoozed = false;
+  a.next_fire = 0;
+  arm(slot, rtc_clock_epoch());
+  program_rtc();
+  return a.id;
+}
+
+bool alarm_update(uint8_t id, uint8_t hour, uint8_t minute, uint8_t days, bool enabled) {
+  int8_t slot = slot_of(id);
+  if (slot < 0 || table[slot].kind != ALARM_KIND_ALARM) return false;
+  if (slot == ringing_slot) alarm_dismiss();
+  Alarm &a = table[slot];
+  a.hour = hour;
+  a.minute = minute;
+  a.days = days;
+  a.enabled = enabled;
+  a.snoozed = false;
+  arm(slot, rtc_clock_epoch());
+  program_rtc();
+  return true;
+}
+
+bool alarm_remove(uint8_t id) {
+  int8_t slot = slot_of(id);
+  if (slot < 0) return false;
+  if (slot == ringing_slot) ringing_slot = -1;
+  free_slot(slot);
+  program_rtc();
+  return true;
+}
+
+int8_t timer_start(uint32_t seconds) {
+  int8_t slot = alloc_slot();
+  if (slot < 0) return -1;
+  Alarm &a = table[slot];
+  uint32_t when = rtc_clock_epoch() + seconds;
+  RtcTime fire = rtc_from_epoch(when);
+  a.kind = ALARM_KIND_TIMER;
+  a.hour = fire.hour;
+  a.minute = fire.minute;
+  a.days = ALARM_ONCE;
+  a.enabled = true;
+  a.snoozed = false;
+  a.next_fire = when;
+  arm(slot, 0);
+  program_rtc();
+  return a.id;
+}
+
+uint8_t alarm_count() {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < ALARM_MAX; i++) n += slot_used[i];
+  return n;
+}
+
+bool alarm_get(uint8_t idx, Alarm *out) {
+  for (uint8_t i = 0; i < ALARM_MAX; i++) {
+    if (!slot_used[i]) continue;
+    if (idx-- == 0) { *out = table[i]; return true; }
+  }
+  return false;
+}
+
+bool alarm_find(uint8_t id, Alarm *out) {
+  int8_t slot = slot_of(id);
+  if (slot < 0) return false;
+  *out = table[slot];
+  return true;
+}
+
+bool alarm_next(Alarm *out) {
+  if (!heap_count) return false;
+  *out = table[heap[0]];
+  return true;
+}
+
+void alarms_poll() {
+  // The RTC alarm only has to wake us; the heap decides what is due
+  rtc_clock_take_alarm_flag();
+  uint32_t now = rtc_clock_epoch();
+
+  if (ringing_slot < 0) {
+    while (heap_count && key(0) <= now) {
+      uint8_t slot = heap[0];
+      heap_remove(slot);
+      if (now - table[slot].next_fire > ALARM_STALE_S) {
+        complete(slot, now);
+        continue;
+      }
+      ringing_slot = slot;
+      ring_start_ms = millis();
+      ring_step_ms = ring_start_ms;
+      ring_step = 0;
+      if (ring_fn) ring_fn(table[slot]);
+      break;
+    }
+    program_rtc();
+  }
+
+  if (ringing_slot < 0) return;
+
+  uint32_t ms = millis();
+  if (ms - ring_start_ms >= ALARM_RING_TIMEOUT_MS) {
+    alarm_dismiss();
+    return;
+  }
+  if ((int32_t)(ms - ring_step_ms) < 0) return;
+
+  const RingStep &step = RING_PATTERN[ring_step];
+  ring_step_ms = ms + step.ms;
+  ring_step = (ring_step + 1) % RING_STEPS;
+  if (step.freq_hz) audio_play_tone(step.freq_hz, step.ms, AUDIO_CH_ALARM);
+}
+
+void alarms_reschedule(uint32_t before) {
+  uint32_t now = rtc_clock_epoch();
+  for (uint8_t i = 0; i < ALARM_MAX; i++) {
+    if (!slot_used[i] || (int8_t)i == ringing_slot) continue;
+    Alarm &a = table[i];
+    // Timers and snoozes keep the time they had left, alarms keep their
+    // wall-clock time
+    if (a.kind == ALARM_KIND_TIMER || a.snoozed) {
+      a.next_fire += now - before;
+      if (a.kind == ALARM_KIND_TIMER) {
+        RtcTime fire = rtc_from_epoch(a.next_fire);
+        a.hour = fire.hour;
+        a.minute = fire.minute;
+      }
+    }
+    arm(i, now);
+  }
+  program_rtc();
+}
+
+bool alarm_is_ringing() {
+  return ringing_slot >= 0;
+}
+
+bool alarm_ringing(Alarm *out) {
+  if (ringing_slot < 0) return false;
+  *out = table[ringing_slot];
+  return true;
+}
+
+void alarm_snooze() {
+  if (ringing_slot < 0) return;
+  Alarm &a = table[ringing_slot];
+  a.snoozed = true;
+  a.next_fire = rtc_clock_epoch() + ALARM_SNOOZE_S;
+  heap_insert(ringing_slot);
+  ringing_slot = -1;
+  audio_stop();
+  program_rtc();
+}
+
+void alarm_dismiss() {
+  if (ringing_slot < 0) return;
+  uint8_t slot = ringing_slot;
+  ringing_slot = -1;
+  audio_stop();
+  complete(slot, rtc_clock_epoch());
+  program_rtc();
+}
+
+const char *alarm_days_label(uint8_t days) {
+  static char buf[8];
+  switch (days) {
+    case ALARM_ONCE:     return "Once";
+    case ALARM_DAILY:    return "Daily";
+    case ALARM_WEEKDAYS: return "Weekdays";
+    case ALARM_WEEKENDS: return "Weekends";
+  }
+  const char *letters = "SMTWTFS";
+  for (uint8_t i = 0; i < 7; i++) buf[i] = (days & (1 << i)) ? letters[i] : '-';
+  buf[7] = 0;
+  return buf;
+}
@@ -0,0 +1,75 @@
+/*
+ * Alarms.h - Alarm clock and countdown timers
+ *
+ * Alarms (hour:minute with a weekday repeat mask) and timers (one-shot,
+ * seconds from now) share one table. Every armed entry sits in a binary
+ * min-heap keyed by its next fire time, so the next event is always the
+ * heap root; only that one is programmed into the PCF85063 alarm.
+ * Ringing is a state machine advanced from alarms_poll() and never waits.
+ */
+
+#ifndef ALARMS_H
+#define ALARMS_H
+
+#include <Arduino.h>
+
+#define ALARM_MAX            16
+#define ALARM_SNOOZE_S       (9 * 60)
+#define ALARM_RING_TIMEOUT_MS 60000     // give up (dismiss) after a minute
+
+// Repeat mask: bit n = weekday n (0 = Sunday); 0 = ring once
+#define ALARM_ONCE      0x00
+#define ALARM_DAILY     0x7F
+#define ALARM_WEEKDAYS  0x3E
+#define ALARM_WEEKENDS  0x41
+
+enum AlarmKind : uint8_t { ALARM_KIND_ALARM, ALARM_KIND_TIMER };
+
+struct Alarm {
+  uint8_t  id;
+  AlarmKind kind;
+  uint8_t  hour;
+  uint8_t  minute;
+  uint8_t  days;          // repeat mask
+  bool     enabled;
+  bool     snoozed;       // next_fire is a snooze, not the schedule
+  uint32_t next_fire;     // RTC epoch seconds, valid while enabled
+};
+
+// Called once when an alarm or timer starts ringing
+typedef void (*AlarmRingFn)(const Alarm &a);
+
+void alarms_init(AlarmRingFn on_ring);
+
+// Returns the new alarm's id, or -1 if the table is full
+int8_t alarm_add(uint8_t hour, uint8_t minute, uint8_t days, bool enabled = true);
+bool alarm_update(uint8_t id, uint8_t hour, uint8_t minute, uint8_t days, bool enabled);
+bool alarm_remove(uint8_t id);
+
+// Countdown timer; returns its id, or -1 if the table is full
+int8_t timer_start(uint32_t seconds);
+
+// Table access in creation order (alarms and timers)
+uint8_t alarm_count();
+bool alarm_get(uint8_t idx, Alarm *out);
+bool alarm_find(uint8_t id, Alarm *out);
+
+// Earliest armed entry, false if none
+bool alarm_next(Alarm *out);
+
+// Fire due entries and advance the ring pattern; call from loop()
+void alarms_poll();
+
+// Recompute fire times after the wall clock was changed; before is
+// rtc_clock_epoch() from just ahead of the change
+void alarms_reschedule(uint32_t before);
+
+bool alarm_is_ringing();
+bool alarm_ringing(Alarm *out);
+void alarm_snooze();
+void alarm_dismiss();
+
+// Weekday letters for a repeat mask, e.g. "Weekdays" or "MTW...S"
+const char *alarm_days_label(uint8_t days);
+
+#endif // ALARMS_H
@@ -0,0 +1,138 @@
+/*
+ * AssetPack.cpp - Read-only asset pack in the assets flash partition implementation
+ */
+
+#include "AssetPack.h"
+#include "FlashStore.h"
+
+struct PinnedAsset {
+  uint32_t hash;
+  uint32_t off;             // position in pin_arena
+};
+
+static const AssetPackHeader *pack = nullptr;
+static const AssetEntry *index_table = nullptr;
+
+static uint8_t pin_arena[ASSET_PIN_BYTES] __attribute__((aligned(ASSET_ALIGN)));
+static uint32_t pin_used = 0;
+static PinnedAsset pinned[ASSET_MAX_PINNED];
+static uint8_t pinned_count = 0;
+
+bool asset_pack_init() {
+  pack = nullptr;
+  index_table = nullptr;
+  asset_unpin_all();
+  if (!flash_store_ok()) return false;
+
+  const AssetPackHeader *h = (const AssetPackHeader *)flash_store_ptr(FLASH_ASSETS_OFFSET);
+  if (h->magic != ASSET_PACK_MAGIC || h->version != ASSET_PACK_VERSION) return false;
+  uint32_t index_bytes = (uint32_t)h->count * sizeof(AssetEntry);
+  if (h->size > FLASH_ASSETS_SIZE || sizeof(*h) + index_bytes > h->size) return false;
+
+  const AssetEntry *e = (const AssetEntry *)(h + 1);
+  if (asset_crc32(e, index_bytes) != h->crc) return false;
+  for (uint16_t i = 0; i < h->count; i++) {
+    if (e[i].offset > h->size || e[i].size > h->size - e[i].offset) return false;
+    if (i && e[i].hash <= e[i - 1].hash) return false;
+  }
+
+  pack = h;
+  index_table = e;
+  return true;
+}
+
+bool asset_pack_present() {
+  return pack != nullptr;
+}
+
+uint16_t asset_count() {
+  return pack ? pack->count : 0;
+}
+
+static const AssetEntry *lookup(uint32_t hash) {
+  if (!pack) return nullptr;
+  uint16_t lo = 0, hi = pack->count;
+  while (lo < hi) {
+    uint16_t mid = (lo + hi) / 2;
+    if (index_table[mid].hash < hash) lo = mid + 1;
+    else hi = mid;
+  }
+  return (lo < pack->count && index_table[lo].hash == hash) ? &index_table[lo] : nullptr;
+}
+
+bool asset_find(uint32_t hash, Asset *out) {
+  const AssetEntry *e = lookup(hash);
+  if (!e) return false;
+
+  out->data = (const uint8_t *)pack + e->offset;
+  for (uint8_t i = 0; i < pinned_count; i++) {
+    if (pinned[i].hash == hash) {
+      out->data = &pin_arena[pinned[i].off];
+      break;
+    }
+  }
+  out->size = e->size;
+  out->format = e->format;
+  out->param = e->param;
+  return true;
+}
+
+bool asset_font(uint32_t hash, sFONT *font) {
+  Asset a;
+  if (!asset_find(hash, &a) || a.format != ASSET_FONT) return false;
+
+  uint16_t w = a.param & 0xFFFF, h = a.param >> 16;
+  if (a.size < 95u * h * ((w + 7) / 8)) return false;   // printable ASCII ' '..'~'
+  font->table = a.data;
+  font->Width = w;
+  font->Height = h;
+  return true;
+}
+
+bool asset_pin(uint32_t hash) {
+  const AssetEntry *e = lookup(hash);
+  if (!e) return false;
+  for (uint8_t i = 0; i < pinned_count; i++) {
+    if (pinned[i].hash == hash) return true;
+  }
+  uint32_t n = (e->size + ASSET_ALIGN - 1) & ~(ASSET_ALIGN - 1);
+  if (pinned_count >= ASSET_MAX_PINNED || pin_used + n > ASSET_PIN_BYTES) return false;
+
+  memcpy(&pin_arena[pin_used], (const uint8_t *)pack + e->offset, e->size);
+  pinned[pinned_count].hash = hash;
+  pinned[pinned_count].off = pin_used;
+  pinned_count++;
+  pin_used += n;
+  return true;
+}
+
+// Pointers previously returned for pinned assets become invalid
+void asset_unpin_all() {
+  pinned_count = 0;
+  pin_used = 0;
+}
+
+uint32_t asset_pinned_bytes() {
+  return pin_used;
+}
+
+void asset_pack_print(Print &out) {
+  if (!pack) {
+    out.println("Assets: no pack");
+    return;
+  }
+  static const char *const FORMAT_NAMES[] = { "raw", "font", "rgb565", "pcm16", "adpcm", "song" };
+  char line[64];
+  snprintf(line, sizeof(line), "Assets: %u entries, %lu bytes, %lu pinned",
+           pack->count, (unsigned long)pack->size, (unsigned long)pin_used);
+  out.println(line);
+  for (uint16_t i = 0; i < pack->count; i++) {
+    const AssetEntry &e = index_table[i];
+    bool is_pinned = false;
+    for (uint8_t j = 0; j < pinned_count; j++) is_pinned |= pinned[j].hash == e.hash;
+    snprintf(line, sizeof(line), "  %08lx %-6s %6lu bytes%s", (unsigned long)e.hash,
+             e.format <= ASSET_SONG ? FORMAT_NAMES[e.format] : "?", (unsigned long)e.size,
+             is_pinned ? " pinned" : "");
+    out.println(line);
+  }
+}
@@ -0,0 +1,110 @@
+/*
+ * AssetPack.h - Read-only asset pack in the assets flash partition
+ *
+ * Fonts, images and sounds can be shipped as one binary built on the host
+ * by tools/asset_packer and flashed at FLASH_ASSETS_OFFSET, so adding or
+ * changing an asset does not need a sketch rebuild. Layout (little endian):
+ *
+ *   header: "APAK", uint16 version, uint16 count, uint32 size, uint32 crc
+ *   index:  count x AssetEntry, sorted by hash (crc is CRC-32 of the index)
+ *   data:   payloads, each 8-byte aligned, offsets from the pack start
+ *
+ * Names are looked up by 32-bit FNV-1a hash (ASSET_ID() folds at compile
+ * time) with a binary search over the index. Payloads are returned as XIP
+ * pointers and never copied. Assets touched per pixel while drawing can be
+ * pinned: they are copied once into an SRAM arena and later lookups return
+ * that copy, so rendering does not stall on XIP cache misses.
+ *
+ * The format definitions build on the host too (tools/asset_packer).
+ */
+
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <stdint.h>
+#include <type_traits>
+
+#define ASSET_PACK_MAGIC    0x4B415041u   // "APAK"
+#define ASSET_PACK_VERSION  1
+#define ASSET_ALIGN         8
+#define ASSET_PIN_BYTES     (16u * 1024u)
+#define ASSET_MAX_PINNED    8
+
+enum AssetFormat : uint16_t {
+  ASSET_RAW = 0,
+  ASSET_FONT,         // sFONT table, param = width | height << 16
+  ASSET_RGB565,       // UWORD pixels row-major, param = width | height << 16
+  ASSET_PCM16,        // mono int16 samples, param = sample rate
+  ASSET_ADPCM,        // IMA-ADPCM blocks, param = sample rate
+  ASSET_SONG,         // Tracker.h song, param = 0
+};
+
+struct AssetPackHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t count;
+  uint32_t size;      // whole pack, header included
+  uint32_t crc;       // CRC-32 of the index
+};
+
+struct AssetEntry {
+  uint32_t hash;
+  uint32_t offset;
+  uint32_t size;
+  uint16_t format;
+  uint16_t flags;
+  uint32_t param;
+};
+
+static_assert(sizeof(AssetPackHeader) == 16 && sizeof(AssetEntry) == 20, "pack layout");
+
+struct Asset {
+  const uint8_t *data;  // XIP or pinned SRAM copy
+  uint32_t size;
+  uint16_t format;
+  uint32_t param;
+};
+
+static constexpr uint32_t asset_hash(const char *s, uint32_t h = 0x811C9DC5u) {
+  return *s ? asset_hash(s + 1, (h ^ (uint8_t)*s) * 0x01000193u) : h;
+}
+
+#define ASSET_ID(name) (std::integral_constant<uint32_t, asset_hash(name)>::value)
+
+// CRC-32 (IEEE, reflected)
+static inline uint32_t asset_crc32(const void *data, uint32_t len) {
+  const uint8_t *p = (const uint8_t *)data;
+  uint32_t crc = 0xFFFFFFFFu;
+  while (len--) {
+    crc ^= *p++;
+    for (uint8_t i = 0; i < 8; i++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+  }
+  return ~crc;
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include "fonts.h"
+
+// Validate the pack in flash; false if none is loaded
+bool asset_pack_init();
+bool asset_pack_present();
+uint16_t asset_count();
+
+bool asset_find(uint32_t hash, Asset *out);
+static inline bool asset_find(const char *name, Asset *out) {
+  return asset_find(asset_hash(name), out);
+}
+
+// Fill *font from an ASSET_FONT entry; *font is left untouched if missing
+bool asset_font(uint32_t hash, sFONT *font);
+
+// Copy an asset into the SRAM arena; false if missing or the arena is full
+bool asset_pin(uint32_t hash);
+void asset_unpin_all();
+uint32_t asset_pinned_bytes();
+
+void asset_pack_print(Print &out);
+#endif
+
+#endif // ASSET_PACK_H
@@ -0,0 +1,200 @@
+/*
+ * AudioIn.cpp - DMA-driven microphone capture engine implementation
+ */
+
+#include "AudioIn.h"
+#include "audio_pio.h"
+#include "ClockGovernor.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+#define BLOCK_BYTES  (AUDIO_IN_BLOCK_FRAMES * sizeof(int16_t))
+#define RING_BYTES   (AUDIO_IN_BLOCKS * BLOCK_BYTES)
+#define RING_BITS    12                        // log2(RING_BYTES)
+
+static_assert(RING_BYTES == 1u << RING_BITS, "DMA write ring must cover exactly the block ring");
+
+// Aligned for the DMA write ring, so a late re-aim can never write past it
+static int16_t ring[AUDIO_IN_BLOCKS][AUDIO_IN_BLOCK_FRAMES] __attribute__((aligned(RING_BYTES)));
+static int     dma_ch[2] = { -1, -1 };
+static uint8_t next_block[2];                  // where each channel goes after its partner
+
+struct Subscriber {
+  AudioInFn fn;
+  void     *ctx;
+  uint32_t  cursor;                            // next block sequence number to deliver
+};
+
+static Subscriber subs[AUDIO_IN_SUBSCRIBERS];
+static uint32_t rate = 24000;
+static volatile uint32_t blocks_done = 0;      // sequence number of the block being written
+static volatile bool running = false;
+static bool     governor_held = false;
+static uint32_t overruns = 0;
+static uint32_t fifo_overflows = 0;
+
+static inline uint32_t rxstall_mask() {
+  return 1u << (PIO_FDEBUG_RXSTALL_LSB + pico_audio.sm_din);
+}
+
+static void __isr audio_in_dma_irq() {
+  for (uint8_t k = 0; k < 2; k++) {
+    uint32_t mask = 1u << dma_ch[k];
+    if (!running || !(dma_hw->ints1 & mask)) continue;
+    dma_hw->ints1 = mask;
+
+    // The partner is filling the next block already; queue this channel behind it
+    dma_channel_set_write_addr(dma_ch[k], ring[next_block[k]], false);
+    next_block[k] = (next_block[k] + 2) % AUDIO_IN_BLOCKS;
+    blocks_done = blocks_done + 1;
+  }
+}
+
+static void configure_channel(uint8_t k) {
+  dma_channel_config c = dma_channel_get_default_config(dma_ch[k]);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+  channel_config_set_read_increment(&c, false);
+  channel_config_set_write_increment(&c, true);
+  channel_config_set_ring(&c, true, RING_BITS);
+  channel_config_set_dreq(&c, pio_get_dreq(pico_audio.pio_1, pico_audio.sm_din, false));
+  channel_config_set_chain_to(&c, dma_ch[k ^ 1]);
+  // Upper halfword of the RX FIFO: the left slot. A narrow read still pops the entry.
+  const volatile void *left = (const volatile uint8_t *)&pico_audio.pio_1->rxf[pico_audio.sm_din] + 2;
+  dma_channel_configure(dma_ch[k], &c, ring[k], left, AUDIO_IN_BLOCK_FRAMES, false);
+  next_block[k] = k + 2;
+}
+
+static void set_chain(int ch, int to) {
+  dma_channel_hw_t *hw = dma_channel_hw_addr(ch);
+  hw->al1_ctrl = (hw->al1_ctrl & ~DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS) |
+                 ((uint32_t)to << DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB);
+}
+
+static void start_capture() {
+  if (running) return;
+  if (!governor_held) {
+    clock_governor_lock();
+    governor_held = true;
+  }
+
+  PIO pio = pico_audio.pio_1;
+  uint sm = pico_audio.sm_din;
+  uint offset = (pio->sm[sm].execctrl & PIO_SM0_EXECCTRL_WRAP_BOTTOM_BITS) >> PIO_SM0_EXECCTRL_WRAP_BOTTOM_LSB;
+  pio_sm_set_enabled(pio, sm, false);
+  pio_sm_clear_fifos(pio, sm);
+  pio_sm_restart(pio, sm);
+  pio_sm_exec(pio, sm, pio_encode_jmp(offset));   // resync on the next LRCLK frame
+  pio->fdebug = rxstall_mask();
+
+  configure_channel(0);
+  configure_channel(1);
+  blocks_done = 0;
+  for (uint8_t i = 0; i < AUDIO_IN_SUBSCRIBERS; i++) subs[i].cursor = 0;
+  running = true;
+  dma_channel_start(dma_ch[0]);
+  pio_sm_set_enabled(pio, sm, true);
+}
+
+static void stop_capture() {
+  if (!running) return;
+  pio_sm_set_enabled(pico_audio.pio_1, pico_audio.sm_din, false);
+  set_chain(dma_ch[0], dma_ch[0]);       // unchain first, or an abort can trigger the partner
+  set_chain(dma_ch[1], dma_ch[1]);
+  dma_channel_abort(dma_ch[0]);
+  dma_channel_abort(dma_ch[1]);
+  dma_hw->ints1 = (1u << dma_ch[0]) | (1u << dma_ch[1]);
+  running = false;
+}
+
+bool audio_in_init(uint32_t sample_rate) {
+  if (dma_ch[0] >= 0) return true;
+  dma_ch[0] = dma_claim_unused_channel(false);
+  dma_ch[1] = dma_claim_unused_channel(false);
+  if (dma_ch[0] < 0 || dma_ch[1] < 0) return false;
+  rate = sample_rate;
+
+  din_pio_init();
+  pio_sm_set_enabled(pico_audio.pio_1, pico_audio.sm_din, false);
+  dma_channel_set_irq1_enabled(dma_ch[0], true);
+  dma_channel_set_irq1_enabled(dma_ch[1], true);
+  irq_add_shared_handler(DMA_IRQ_1, audio_in_dma_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+  irq_set_enabled(DMA_IRQ_1, true);
+  return true;
+}
+
+int8_t audio_in_subscribe(AudioInFn fn, void *ctx) {
+  if (dma_ch[0] < 0 || !fn) return -1;
+  for (int8_t i = 0; i < AUDIO_IN_SUBSCRIBERS; i++) {
+    if (subs[i].fn) continue;
+    subs[i].ctx = ctx;
+    subs[i].cursor = blocks_done;
+    subs[i].fn = fn;
+    start_capture();
+    return i;
+  }
+  return -1;
+}
+
+void audio_in_unsubscribe(int8_t handle) {
+  if (handle < 0 || handle >= AUDIO_IN_SUBSCRIBERS) return;
+  subs[handle].fn = nullptr;
+  for (uint8_t i = 0; i < AUDIO_IN_SUBSCRIBERS; i++) {
+    if (subs[i].fn) return;
+  }
+  stop_capture();
+}
+
+bool audio_in_active() {
+  return running;
+}
+
+uint32_t audio_in_sample_rate() {
+  return rate;
+}
+
+void audio_in_set_sample_rate(uint32_t sample_rate) {
+  if (!running) rate = sample_rate;
+}
+
+void audio_in_poll() {
+  if (!running) {
+    if (governor_held) {
+      governor_held = false;
+      clock_governor_unlock();
+    }
+    return;
+  }
+
+  PIO pio = pico_audio.pio_1;
+  if (pio->fdebug & rxstall_mask()) {
+    pio->fdebug = rxstall_mask();
+    fifo_overflows++;
+  }
+
+  // Blocks head-1 back to head-(BLOCKS-2) are complete; the DMA owns the other two
+  for (uint8_t i = 0; i < AUDIO_IN_SUBSCRIBERS; i++) {
+    Subscriber &s = subs[i];
+    while (s.fn) {
+      uint32_t head = blocks_done;
+      if (s.cursor == head) break;
+      if (head - s.cursor > AUDIO_IN_BLOCKS - 2) {
+        overruns += head - s.cursor - (AUDIO_IN_BLOCKS - 2);
+        s.cursor = head - (AUDIO_IN_BLOCKS - 2);
+      }
+      s.fn(ring[s.cursor % AUDIO_IN_BLOCKS], AUDIO_IN_BLOCK_FRAMES, s.ctx);
+      s.cursor++;
+    }
+  }
+}
+
+uint32_t audio_in_blocks() {
+  return blocks_done;
+}
+
+uint32_t audio_in_overruns() {
+  return overruns;
+}
+
+uint32_t audio_in_fifo_overflows() {
+  return fifo_overflows;
+}
@@ -0,0 +1,53 @@
+/*
+ * AudioIn.h - DMA-driven microphone capture engine
+ *
+ * Two chained DMA channels drain the audio_pio din state machine into a
+ * ring of small blocks. They read only the left-slot half of each I2S
+ * word (the ES8311 ADC), so samples land already packed as mono int16.
+ * Each completion IRQ just re-aims its channel two blocks ahead, so the
+ * CPU never touches individual samples on the capture side.
+ *
+ * Consumers subscribe with a callback. audio_in_poll() (from loop())
+ * hands each subscriber every block it has not seen yet. A subscriber
+ * that falls more than the ring behind skips ahead, and the lost blocks
+ * are counted as overruns rather than stalling capture. Everything runs
+ * in fixed memory, so voice memos, level meters and visualisers cost only
+ * their own state. Capture runs while anyone is subscribed and holds the
+ * clock governor, because a clk_sys change retunes MCLK.
+ */
+
+#ifndef AUDIO_IN_H
+#define AUDIO_IN_H
+
+#include <Arduino.h>
+
+#define AUDIO_IN_BLOCK_FRAMES  128      // 5.3 ms at 24 kHz
+#define AUDIO_IN_BLOCKS        16       // ring: 85 ms at 24 kHz, power of two
+#define AUDIO_IN_SUBSCRIBERS   4
+
+// Called from audio_in_poll() with one block of mono samples
+typedef void (*AudioInFn)(const int16_t *samples, uint32_t frames, void *ctx);
+
+// Claim the din state machine and DMA channels; call after the codec and
+// MCLK are running (audio_init() does this)
+bool audio_in_init(uint32_t sample_rate);
+
+// Returns a handle, or -1 if every slot is taken. The first subscriber
+// starts capture and the last one to leave stops it.
+int8_t audio_in_subscribe(AudioInFn fn, void *ctx);
+void audio_in_unsubscribe(int8_t handle);
+
+bool audio_in_active();
+uint32_t audio_in_sample_rate();
+
+// Follow a codec rate change; ignored while capturing
+void audio_in_set_sample_rate(uint32_t sample_rate);
+
+// Deliver pending blocks; releases the clock governor once stopped
+void audio_in_poll();
+
+uint32_t audio_in_blocks();         // blocks captured since init
+uint32_t audio_in_overruns();       // blocks a subscriber missed by lagging
+uint32_t audio_in_fifo_overflows(); // RX FIFO stalls (DMA refill too late)
+
+#endif // AUDIO_IN_H
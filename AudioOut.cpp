@@ -0,0 +1,230 @@
+/*
+ * AudioOut.cpp - DMA-driven I2S output engine implementation
+ */
+
+#include "AudioOut.h"
+#include "audio_pio.h"
+#include "ClockGovernor.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+#define BLOCK_BYTES  (AUDIO_OUT_BLOCK_FRAMES * sizeof(uint32_t))
+#define RING_BITS    10                        // log2(BLOCK_BYTES)
+
+static_assert(BLOCK_BYTES == 1u << RING_BITS, "DMA ring must cover exactly one block");
+
+// I2S words (left slot in the high half), each block aligned for the DMA ring
+static uint32_t blocks[2][AUDIO_OUT_BLOCK_FRAMES] __attribute__((aligned(BLOCK_BYTES)));
+static int16_t  scratch[AUDIO_OUT_BLOCK_FRAMES];
+static int      dma_ch[2] = { -1, -1 };
+
+static AudioSourceFn source = nullptr;
+
+// audio_out_write() queue: loop() produces, the IRQ consumes
+static int16_t fifo[AUDIO_OUT_FIFO_FRAMES];
+static volatile uint32_t fifo_head = 0;
+static volatile uint32_t fifo_tail = 0;
+
+static volatile bool running = false;
+static uint8_t  silent_blocks = 0;
+static bool     governor_held = false;
+static volatile uint32_t blocks_filled = 0;
+static volatile uint32_t late_refills = 0;
+static uint32_t render_delay = 0;
+
+// Measurement window, reset by audio_out_stats()
+static AudioOutStats window;
+static uint64_t refill_cycles_sum = 0;
+
+static inline uint32_t txstall_mask() {
+  return 1u << (PIO_FDEBUG_TXSTALL_LSB + pico_audio.sm_dout);
+}
+
+// Frames the channel still has to send (RP2350: the top nibble is the trigger mode)
+static inline uint32_t frames_left(int ch) {
+  return dma_hw->ch[ch].transfer_count & DMA_CH0_TRANS_COUNT_COUNT_BITS;
+}
+
+static void reset_window() {
+  memset(&window, 0, sizeof(window));
+  window.headroom_min = AUDIO_OUT_BLOCK_FRAMES;
+  refill_cycles_sum = 0;
+}
+
+// Render one block; returns false if it came out silent
+static bool fill_block(uint8_t k) {
+  uint32_t t0 = rp2040.getCycleCount();
+  bool sound = source && source(scratch, AUDIO_OUT_BLOCK_FRAMES);
+  if (!sound) memset(scratch, 0, sizeof(scratch));
+
+  uint32_t head = fifo_head, tail = fifo_tail;
+  uint32_t n = head - tail;
+  if (n > AUDIO_OUT_BLOCK_FRAMES) n = AUDIO_OUT_BLOCK_FRAMES;
+  for (uint32_t i = 0; i < n; i++) {
+    int32_t s = scratch[i] + fifo[(tail + i) & (AUDIO_OUT_FIFO_FRAMES - 1)];
+    scratch[i] = s > 32767 ? 32767 : (s < -32768 ? -32768 : s);
+  }
+  __compiler_memory_barrier();
+  fifo_tail = tail + n;
+
+  uint32_t *out = blocks[k];
+  for (uint32_t i = 0; i < AUDIO_OUT_BLOCK_FRAMES; i++) {
+    uint16_t s = (uint16_t)scratch[i];
+    out[i] = (uint32_t)s << 16 | s;
+  }
+  blocks_filled++;
+  window.blocks++;
+  uint32_t cycles = rp2040.getCycleCount() - t0;
+  refill_cycles_sum += cycles;
+  if (cycles > window.refill_cycles_max) window.refill_cycles_max = cycles;
+  return sound || n > 0;
+}
+
+static void set_chain(int ch, int to) {
+  dma_channel_hw_t *hw = dma_channel_hw_addr(ch);
+  hw->al1_ctrl = (hw->al1_ctrl & ~DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS) |
+                 ((uint32_t)to << DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB);
+}
+
+// Both blocks hold silence by now, so cutting them short is inaudible
+static void stop_channels() {
+  set_chain(dma_ch[0], dma_ch[0]);       // unchain first, or an abort can trigger the partner
+  set_chain(dma_ch[1], dma_ch[1]);
+  dma_channel_abort(dma_ch[0]);
+  dma_channel_abort(dma_ch[1]);
+  dma_hw->ints1 = (1u << dma_ch[0]) | (1u << dma_ch[1]);
+  running = false;
+}
+
+static void __isr audio_dma_irq() {
+  for (uint8_t k = 0; k < 2; k++) {
+    uint32_t mask = 1u << dma_ch[k];
+    if (!running || !(dma_hw->ints1 & mask)) continue;
+    dma_hw->ints1 = mask;
+
+    // The partner should still be playing; if not, block k is already replaying
+    int partner = dma_ch[k ^ 1];
+    bool late = !dma_channel_is_busy(partner);
+    uint32_t left = late ? 0 : frames_left(partner);
+    if (late) {
+      late_refills++;
+      window.late_refills++;
+    }
+    if (AUDIO_OUT_BLOCK_FRAMES - left > window.irq_latency_max) window.irq_latency_max = AUDIO_OUT_BLOCK_FRAMES - left;
+    PIO pio = pico_audio.pio_2;
+    if (pio->fdebug & txstall_mask()) {
+      pio->fdebug = txstall_mask();
+      window.underruns++;
+    }
+
+    render_delay = left;
+    bool sound = fill_block(k);
+    left = dma_channel_is_busy(partner) ? frames_left(partner) : 0;
+    if (left < window.headroom_min) window.headroom_min = left;
+
+    if (sound) {
+      silent_blocks = 0;
+    } else if (++silent_blocks >= 2) {
+      stop_channels();
+    }
+  }
+}
+
+static void configure_channel(uint8_t k) {
+  dma_channel_config c = dma_channel_get_default_config(dma_ch[k]);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_ring(&c, false, RING_BITS);
+  channel_config_set_dreq(&c, pio_get_dreq(pico_audio.pio_2, pico_audio.sm_dout, true));
+  channel_config_set_chain_to(&c, dma_ch[k ^ 1]);
+  dma_channel_configure(dma_ch[k], &c, &pico_audio.pio_2->txf[pico_audio.sm_dout],
+                        blocks[k], AUDIO_OUT_BLOCK_FRAMES, false);
+}
+
+bool audio_out_init() {
+  if (dma_ch[0] >= 0) return true;
+  dma_ch[0] = dma_claim_unused_channel(false);
+  dma_ch[1] = dma_claim_unused_channel(false);
+  if (dma_ch[0] < 0 || dma_ch[1] < 0) return false;
+
+  configure_channel(0);
+  configure_channel(1);
+  reset_window();
+  dma_channel_set_irq1_enabled(dma_ch[0], true);
+  dma_channel_set_irq1_enabled(dma_ch[1], true);
+  irq_add_shared_handler(DMA_IRQ_1, audio_dma_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+  irq_set_enabled(DMA_IRQ_1, true);
+  return true;
+}
+
+void audio_out_set_source(AudioSourceFn fn) {
+  source = fn;
+}
+
+void audio_out_kick() {
+  if (dma_ch[0] < 0 || running) return;
+  if (!governor_held) {
+    clock_governor_lock();
+    governor_held = true;
+  }
+
+  // Stopped: no IRQ can fire, so both blocks are safe to fill here
+  render_delay = 0;
+  fill_block(0);
+  render_delay = AUDIO_OUT_BLOCK_FRAMES;
+  fill_block(1);
+  silent_blocks = 0;
+  configure_channel(0);
+  configure_channel(1);
+  pico_audio.pio_2->fdebug = txstall_mask();   // stalled while stopped; that was no underrun
+  running = true;
+  dma_channel_start(dma_ch[0]);
+}
+
+uint32_t audio_out_writable() {
+  return AUDIO_OUT_FIFO_FRAMES - (fifo_head - fifo_tail);
+}
+
+uint32_t audio_out_write(const int16_t *samples, uint32_t count) {
+  uint32_t n = audio_out_writable();
+  if (count < n) n = count;
+  uint32_t head = fifo_head;
+  for (uint32_t i = 0; i < n; i++) fifo[(head + i) & (AUDIO_OUT_FIFO_FRAMES - 1)] = samples[i];
+  __compiler_memory_barrier();
+  fifo_head = head + n;
+  if (n) audio_out_kick();
+  return n;
+}
+
+bool audio_out_active() {
+  return running;
+}
+
+void audio_out_poll() {
+  if (governor_held && !running) {
+    governor_held = false;
+    clock_governor_unlock();
+  }
+}
+
+uint32_t audio_out_blocks() {
+  return blocks_filled;
+}
+
+uint32_t audio_out_late_refills() {
+  return late_refills;
+}
+
+void audio_out_stats(AudioOutStats *out, bool reset) {
+  uint32_t irq = save_and_disable_interrupts();
+  *out = window;
+  out->refill_cycles_avg = window.blocks ? (uint32_t)(refill_cycles_sum / window.blocks) : 0;
+  if (reset) reset_window();
+  restore_interrupts(irq);
+}
+
+uint32_t audio_out_render_delay() {
+  return render_delay;
+}
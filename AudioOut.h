@@ -0,0 +1,75 @@
+/*
+ * AudioOut.h - DMA-driven I2S output engine
+ *
+ * Two DMA channels, chained to each other, feed the audio_pio dout state
+ * machine from a pair of ping-pong blocks. When a channel finishes, its
+ * completion IRQ refills that block while the other one plays, so
+ * nothing on the CPU waits for the codec. Each channel reads its block
+ * through a DMA address ring, so a refill that comes too late (e.g. IRQs
+ * held off by a flash erase) repeats the previous block instead of
+ * running off the end of the buffer.
+ *
+ * Audio is mono int16 (the ES8311 drives a single speaker) and is sent
+ * to both I2S slots. Blocks come from the source callback, mixed with
+ * whatever was queued with audio_out_write(). After two silent blocks the
+ * channels stop; the next write or audio_out_kick() restarts them. While
+ * running, the clock governor is held, because a clk_sys change retunes
+ * MCLK.
+ *
+ * Every refill is measured: its duration in cycles, how far the partner
+ * block had already played when the IRQ got to run (IRQ latency) and how
+ * much of it was left when the refill finished (headroom), both in frames
+ * and accurate to about the PIO FIFO depth. Underruns are counted from the
+ * dout state machine's TX stall flag, so they are the glitches actually
+ * heard, whatever caused them.
+ */
+
+#ifndef AUDIO_OUT_H
+#define AUDIO_OUT_H
+
+#include <Arduino.h>
+
+#define AUDIO_OUT_BLOCK_FRAMES  256     // 10.7 ms at 24 kHz
+#define AUDIO_OUT_FIFO_FRAMES   2048    // audio_out_write() queue, power of two
+
+// Fill out[0..frames) and return true, or return false for silence
+// (out may be left untouched). Runs in the DMA IRQ: no blocking, no I2C.
+typedef bool (*AudioSourceFn)(int16_t *out, uint32_t frames);
+
+// Claim the DMA channels; call after dout_pio_init()
+bool audio_out_init();
+
+void audio_out_set_source(AudioSourceFn fn);
+
+// Start the channels if stopped (call after giving the source new work)
+void audio_out_kick();
+
+// Queue samples behind the source; returns how many fit (never blocks)
+uint32_t audio_out_write(const int16_t *samples, uint32_t count);
+uint32_t audio_out_writable();
+
+bool audio_out_active();
+
+// Releases the clock governor once playback has stopped; call from loop()
+void audio_out_poll();
+
+uint32_t audio_out_blocks();        // blocks refilled since init
+uint32_t audio_out_late_refills();  // refills that missed their deadline
+
+struct AudioOutStats {
+  uint32_t blocks;                  // refilled in this window
+  uint32_t late_refills;            // missed their deadline; the previous block replayed
+  uint32_t underruns;               // the PIO TX FIFO ran dry while playing
+  uint32_t refill_cycles_avg;
+  uint32_t refill_cycles_max;
+  uint32_t irq_latency_max;         // frames of the partner block played before the IRQ ran
+  uint32_t headroom_min;            // frames of it left when the refill finished
+};
+
+// Counters since the last reset; reset starts a new window
+void audio_out_stats(AudioOutStats *out, bool reset);
+
+// In the source callback: frames until the block being rendered starts to play
+uint32_t audio_out_render_delay();
+
+#endif // AUDIO_OUT_H
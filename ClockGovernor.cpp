@@ -0,0 +1,139 @@
+/*
+ * ClockGovernor.cpp - Workload-driven system clock scaling implementation
+ */
+
+#include "ClockGovernor.h"
+#include "DEV_Config.h"
+#include "qspi_pio.h"
+#include "GameAudio.h"
+#include "hardware/clocks.h"
+
+static const uint32_t LEVEL_KHZ[CLOCK_LEVEL_COUNT] = {
+  CLOCK_IDLE_KHZ, CLOCK_NORMAL_KHZ, CLOCK_BOOST_KHZ
+};
+static const char *LEVEL_NAMES[CLOCK_LEVEL_COUNT] = { "idle", "normal", "boost" };
+
+static ClockLevel current_level = CLOCK_BOOST;
+static ClockLevel requested_level = CLOCK_BOOST;
+static uint32_t   boost_until_ms = 0;
+static uint8_t    lock_depth = 0;
+static uint32_t   min_khz = 0;
+static uint32_t   level_ms[CLOCK_LEVEL_COUNT];
+static uint32_t   level_since_ms = 0;
+static uint32_t   switches = 0;
+
+// Bring every clk_sys-derived divider back in line with the new clock
+static void apply_khz(uint32_t khz) {
+  if (!set_sys_clock_khz(khz, false)) return;
+
+  clock_configure(
+      clk_peri,
+      0,
+      CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS,
+      khz * 1000,
+      khz * 1000);
+
+  // I2C baud is derived from clk_peri
+  Wire1.setClock(400 * 1000);
+
+  // Display PIO: never clock the panel faster than it is at PLL_SYS_KHZ
+  float qspi_div = khz > (PLL_SYS_KHZ) ? (float)khz / (PLL_SYS_KHZ) : 1.0f;
+  QSPI_Set_Clkdiv(qspi, qspi_div);
+
+  // Audio MCLK divider
+  audio_refresh_clocks();
+}
+
+static void set_level(ClockLevel level) {
+  if (LEVEL_KHZ[level] < min_khz) {
+    // Pick the slowest level that still satisfies the floor
+    while (level < CLOCK_BOOST && LEVEL_KHZ[level] < min_khz) level = (ClockLevel)(level + 1);
+  }
+  if (level == current_level) return;
+
+  uint32_t now = millis();
+  level_ms[current_level] += now - level_since_ms;
+  level_since_ms = now;
+
+  apply_khz(LEVEL_KHZ[level]);
+  current_level = level;
+  switches++;
+}
+
+static ClockLevel effective_level() {
+  if ((int32_t)(boost_until_ms - millis()) > 0) return CLOCK_BOOST;
+  return requested_level;
+}
+
+void clock_governor_init() {
+  // DEV_Module_Init starts at PLL_SYS_KHZ
+  current_level = CLOCK_BOOST;
+  requested_level = CLOCK_BOOST;
+  memset(level_ms, 0, sizeof(level_ms));
+  level_since_ms = millis();
+  switches = 0;
+}
+
+void clock_governor_request(ClockLevel level) {
+  requested_level = level;
+  if (!lock_depth) set_level(effective_level());
+}
+
+void clock_governor_boost(uint32_t ms) {
+  uint32_t until = millis() + ms;
+  if ((int32_t)(until - boost_until_ms) > 0) boost_until_ms = until;
+  if (!lock_depth) set_level(CLOCK_BOOST);
+}
+
+void clock_governor_lock() {
+  lock_depth++;
+}
+
+void clock_governor_unlock() {
+  if (lock_depth) lock_depth--;
+}
+
+void clock_governor_set_min_khz(uint32_t khz) {
+  min_khz = khz;
+  if (!lock_depth) set_level(effective_level());
+}
+
+void clock_governor_poll() {
+  if (!lock_depth) set_level(effective_level());
+}
+
+ClockLevel clock_governor_level() {
+  return current_level;
+}
+
+uint32_t clock_governor_khz() {
+  return LEVEL_KHZ[current_level];
+}
+
+uint32_t clock_governor_time_ms(ClockLevel level) {
+  uint32_t t = level_ms[level];
+  if (level == current_level) t += millis() - level_since_ms;
+  return t;
+}
+
+uint32_t clock_governor_switches() {
+  return switches;
+}
+
+void clock_governor_print(Print &out) {
+  uint32_t total = 0;
+  for (int i = 0; i < CLOCK_LEVEL_COUNT; i++) total += clock_governor_time_ms((ClockLevel)i);
+  out.print("Clock governor: ");
+  out.print(clock_governor_khz() / 1000);
+  out.print(" MHz now, ");
+  out.print(switches);
+  out.println(" switches");
+  for (int i = 0; i < CLOCK_LEVEL_COUNT; i++) {
+    uint32_t t = clock_governor_time_ms((ClockLevel)i);
+    char line[48];
+    snprintf(line, sizeof(line), "  %-6s %3lu MHz %8lu s %5.1f%%",
+             LEVEL_NAMES[i], (unsigned long)(LEVEL_KHZ[i] / 1000), (unsigned long)(t / 1000),
+             total ? 100.0f * t / total : 0.0f);
+    out.println(line);
+  }
+}
@@ -0,0 +1,52 @@
+/*
+ * ClockGovernor.h - Workload-driven system clock scaling
+ *
+ * Runs clk_sys slowly while idling on the watchface and boosts it for
+ * games, rendering and audio. Every switch re-derives the clocks that
+ * hang off clk_sys: clk_peri, the I2C baud rate, the QSPI PIO dividers
+ * and the audio MCLK divider. Time spent at each level is accounted.
+ */
+
+#ifndef CLOCK_GOVERNOR_H
+#define CLOCK_GOVERNOR_H
+
+#include <Arduino.h>
+
+enum ClockLevel : uint8_t {
+  CLOCK_IDLE,       // watchface, nothing animating
+  CLOCK_NORMAL,     // menus and static screens
+  CLOCK_BOOST,      // games, bursts of redraws, audio
+  CLOCK_LEVEL_COUNT
+};
+
+// clk_sys per level, kHz (all reachable from the 12 MHz crystal PLL)
+#define CLOCK_IDLE_KHZ    48000
+#define CLOCK_NORMAL_KHZ  96000
+#define CLOCK_BOOST_KHZ   150000   // PLL_SYS_KHZ
+
+void clock_governor_init();
+
+// Select the level the current workload needs; applied immediately
+// unless a boost or lock is active
+void clock_governor_request(ClockLevel level);
+
+// Hold CLOCK_BOOST for at least ms (input bursts, redraw storms)
+void clock_governor_boost(uint32_t ms);
+
+// Prevent clock changes while timing-sensitive work runs (nestable)
+void clock_governor_lock();
+void clock_governor_unlock();
+
+// Never go below this clk_sys (e.g. audio MCLK generation needs 5x MCLK)
+void clock_governor_set_min_khz(uint32_t khz);
+
+// Re-evaluate boost expiry; call from loop()
+void clock_governor_poll();
+
+ClockLevel clock_governor_level();
+uint32_t clock_governor_khz();
+uint32_t clock_governor_time_ms(ClockLevel level);
+uint32_t clock_governor_switches();
+void clock_governor_print(Print &out);
+
+#endif // CLOCK_GOVERNOR_H
@@ -1,3 +1,330 @@
 #include "Config.h"
 
 // Config module implementation
+
+#include "FlashStore.h"
+#include "pico/mutex.h"
+
+#define CFG_SECTORS       (FLASH_CONFIG_SIZE / FLASH_SECTOR_SIZE)
+#define CFG_SECTOR_MAGIC  0x31474643u   // "CFG1"
+#define CFG_KEY_ERASED    0xFFFF
+
+struct CfgSectorHeader {
+  uint32_t magic;
+  uint32_t seq;
+};
+
+struct CfgRecordHeader {
+  uint16_t key;
+  uint16_t len;
+  uint16_t crc;
+};
+
+struct CfgEntry {
+  uint16_t key;
+  uint16_t len;
+  uint16_t off;             // value position in the arena
+  bool     dirty;           // not yet in flash
+  bool     deleted;         // tombstone waiting to be flushed
+};
+
+// RAM mirror, shared by both cores under cfg_mutex
+static CfgEntry entries[CONFIG_MAX_KEYS];
+static uint8_t  entry_count = 0;
+static uint8_t  arena[CONFIG_ARENA_BYTES];
+static uint16_t arena_used = 0;
+static volatile bool     dirty_any = false;
+static volatile uint32_t dirty_since_ms = 0;
+auto_init_mutex(cfg_mutex);
+
+// Flash log state, owned by the flush task after config_init()
+static volatile bool ready = false;
+static uint8_t  active_sector = 0;
+static uint32_t active_seq = 0;
+static uint32_t write_off = 0;          // sector relative
+static bool     need_compact = false;
+static uint32_t records_written = 0;
+static uint32_t compactions = 0;
+
+static inline uint32_t align4(uint32_t v) {
+  return (v + 3) & ~3u;
+}
+
+static inline uint32_t sector_offset(uint8_t s) {
+  return FLASH_CONFIG_OFFSET + s * FLASH_SECTOR_SIZE;
+}
+
+static inline const CfgSectorHeader *sector_at(uint8_t s) {
+  return (const CfgSectorHeader *)flash_store_ptr(sector_offset(s));
+}
+
+static uint16_t record_crc(uint16_t key, uint16_t len, const uint8_t *data) {
+  uint8_t kl[4] = { (uint8_t)key, (uint8_t)(key >> 8), (uint8_t)len, (uint8_t)(len >> 8) };
+  return flash_store_crc16(flash_store_crc16(0xFFFF, kl, 4), data, len);
+}
+
+// ---------- RAM mirror (caller holds cfg_mutex) ----------
+
+static int8_t find(uint16_t key) {
+  for (uint8_t i = 0; i < entry_count; i++) {
+    if (entries[i].key == key) return i;
+  }
+  return -1;
+}
+
+static void release_value(uint8_t i) {
+  CfgEntry &e = entries[i];
+  if (!e.len) return;
+  memmove(&arena[e.off], &arena[e.off + e.len], arena_used - e.off - e.len);
+  for (uint8_t j = 0; j < entry_count; j++) {
+    if (entries[j].off > e.off) entries[j].off -= e.len;
+  }
+  arena_used -= e.len;
+  e.len = 0;
+}
+
+static void drop_entry(uint8_t i) {
+  release_value(i);
+  entries[i] = entries[--entry_count];
+}
+
+static bool store(uint16_t key, const uint8_t *data, uint16_t len, bool dirty) {
+  int8_t i = find(key);
+  if (i >= 0 && !entries[i].deleted && entries[i].len == len) {
+    if (memcmp(&arena[entries[i].off], data, len) == 0) return true;
+    memcpy(&arena[entries[i].off], data, len);
+  } else {
+    if (i < 0) {
+      if (entry_count >= CONFIG_MAX_KEYS) return false;
+      i = entry_count++;
+      entries[i].key = key;
+      entries[i].len = 0;
+    }
+    release_value(i);
+    if (arena_used + len > CONFIG_ARENA_BYTES) {
+      if (!dirty) drop_entry(i);
+      return false;
+    }
+    memcpy(&arena[arena_used], data, len);
+    entries[i].off = arena_used;
+    entries[i].len = len;
+    arena_used += len;
+  }
+  entries[i].deleted = false;
+  entries[i].dirty = dirty;
+  return true;
+}
+
+static void mark_dirty() {
+  if (!dirty_any) dirty_since_ms = millis();
+  dirty_any = true;
+}
+
+// Serialize entry i into buf; returns the record length (unpadded)
+static uint16_t build_record(uint8_t i, uint8_t *buf) {
+  CfgEntry &e = entries[i];
+  const uint8_t *val = &arena[e.off];
+  CfgRecordHeader h = { e.key, e.len, record_crc(e.key, e.len, val) };
+  memcpy(buf, &h, sizeof(h));
+  memcpy(buf + sizeof(h), val, e.len);
+  return sizeof(h) + e.len;
+}
+
+// ---------- Flash log ----------
+
+static void format_sector(uint8_t s, uint32_t seq) {
+  flash_store_erase(sector_offset(s), FLASH_SECTOR_SIZE);
+  CfgSectorHeader h = { CFG_SECTOR_MAGIC, seq };
+  flash_store_program(sector_offset(s), &h, sizeof(h));
+  active_sector = s;
+  active_seq = seq;
+  write_off = sizeof(h);
+}
+
+// Rewrite the live set into the next sector; its header goes in last
+static void compact() {
+  uint8_t next = (active_sector + 1) % CFG_SECTORS;
+  flash_store_erase(sector_offset(next), FLASH_SECTOR_SIZE);
+
+  uint32_t off = sizeof(CfgSectorHeader);
+  uint8_t buf[sizeof(CfgRecordHeader) + CONFIG_MAX_VALUE];
+  for (uint8_t i = 0;;) {
+    mutex_enter_blocking(&cfg_mutex);
+    if (i >= entry_count) { mutex_exit(&cfg_mutex); break; }
+    if (entries[i].deleted) {              // tombstones vanish with compaction
+      drop_entry(i);
+      mutex_exit(&cfg_mutex);
+      continue;
+    }
+    uint16_t n = build_record(i, buf);
+    entries[i].dirty = false;
+    mutex_exit(&cfg_mutex);
+
+    flash_store_program(sector_offset(next) + off, buf, n);
+    off += align4(n);
+    records_written++;
+    i++;
+  }
+
+  CfgSectorHeader h = { CFG_SECTOR_MAGIC, active_seq + 1 };
+  flash_store_program(sector_offset(next), &h, sizeof(h));
+  active_sector = next;
+  active_seq++;
+  write_off = off;
+  need_compact = false;
+  compactions++;
+}
+
+bool config_init() {
+  ready = false;
+  if (!flash_store_ok()) return false;
+
+  int16_t newest = -1;
+  for (uint8_t s = 0; s < CFG_SECTORS; s++) {
+    if (sector_at(s)->magic != CFG_SECTOR_MAGIC) continue;
+    if (newest < 0 || sector_at(s)->seq > sector_at(newest)->seq) newest = s;
+  }
+  if (newest < 0) {
+    format_sector(0, 1);
+    ready = true;
+    return true;
+  }
+
+  active_sector = newest;
+  active_seq = sector_at(newest)->seq;
+  uint32_t off = sizeof(CfgSectorHeader);
+  const uint8_t *base = flash_store_ptr(sector_offset(newest));
+  mutex_enter_blocking(&cfg_mutex);
+  while (off + sizeof(CfgRecordHeader) <= FLASH_SECTOR_SIZE) {
+    const CfgRecordHeader *h = (const CfgRecordHeader *)(base + off);
+    if (h->key == CFG_KEY_ERASED) break;
+    const uint8_t *val = (const uint8_t *)(h + 1);
+    if (off + sizeof(*h) + h->len > FLASH_SECTOR_SIZE || h->crc != record_crc(h->key, h->len, val)) {
+      need_compact = true;                 // torn write: nothing after it can be appended to
+      break;
+    }
+    if (h->len == 0) {
+      int8_t i = find(h->key);
+      if (i >= 0) drop_entry(i);
+    } else {
+      store(h->key, val, h->len, false);
+    }
+    off += align4(sizeof(*h) + h->len);
+  }
+  mutex_exit(&cfg_mutex);
+  write_off = off;
+
+  if (need_compact) {
+    dirty_since_ms = millis() - CONFIG_FLUSH_DELAY_MS;
+    dirty_any = true;
+  }
+  ready = true;
+  return true;
+}
+
+bool config_set(uint16_t key, const void *data, uint16_t len) {
+  if (key == CFG_KEY_ERASED || len == 0 || len > CONFIG_MAX_VALUE) return false;
+  mutex_enter_blocking(&cfg_mutex);
+  int8_t i = find(key);
+  bool changed = i < 0 || entries[i].deleted || entries[i].len != len ||
+                 memcmp(&arena[entries[i].off], data, len) != 0;
+  bool ok = !changed || store(key, (const uint8_t *)data, len, true);
+  if (changed && ok) mark_dirty();
+  mutex_exit(&cfg_mutex);
+  return ok;
+}
+
+int16_t config_get(uint16_t key, void *out, uint16_t max) {
+  mutex_enter_blocking(&cfg_mutex);
+  int8_t i = find(key);
+  int16_t len = -1;
+  if (i >= 0 && !entries[i].deleted) {
+    len = entries[i].len;
+    memcpy(out, &arena[entries[i].off], len < max ? len : max);
+  }
+  mutex_exit(&cfg_mutex);
+  return len;
+}
+
+bool config_remove(uint16_t key) {
+  mutex_enter_blocking(&cfg_mutex);
+  int8_t i = find(key);
+  if (i >= 0 && !entries[i].deleted) {
+    release_value(i);
+    entries[i].deleted = true;
+    entries[i].dirty = true;
+    mark_dirty();
+  }
+  mutex_exit(&cfg_mutex);
+  return i >= 0;
+}
+
+void config_flush_task() {
+  if (!ready || !dirty_any) return;
+  if (millis() - dirty_since_ms < CONFIG_FLUSH_DELAY_MS) return;
+  dirty_any = false;
+
+  if (need_compact) {
+    compact();
+    return;
+  }
+
+  uint8_t buf[sizeof(CfgRecordHeader) + CONFIG_MAX_VALUE];
+  for (;;) {
+    mutex_enter_blocking(&cfg_mutex);
+    int8_t i = -1;
+    for (uint8_t j = 0; j < entry_count; j++) {
+      if (entries[j].dirty) { i = j; break; }
+    }
+    if (i < 0) { mutex_exit(&cfg_mutex); break; }
+    uint16_t n = build_record(i, buf);
+    entries[i].dirty = false;
+    if (entries[i].deleted) drop_entry(i);
+    mutex_exit(&cfg_mutex);
+
+    if (write_off + align4(n) > FLASH_SECTOR_SIZE) {
+      compact();                           // the snapshot includes this value
+      return;
+    }
+    flash_store_program(sector_offset(active_sector) + write_off, buf, n);
+    write_off += align4(n);
+    records_written++;
+  }
+}
+
+bool config_pending() {
+  return dirty_any;
+}
+
+uint32_t config_records_written() {
+  return records_written;
+}
+
+uint32_t config_compactions() {
+  return compactions;
+}
+
+void config_print(Print &out) {
+  out.print("Config: sector ");
+  out.print(active_sector);
+  out.print(" seq ");
+  out.print(active_seq);
+  out.print(", ");
+  out.print(write_off);
+  out.print("/");
+  out.print(FLASH_SECTOR_SIZE);
+  out.print(" bytes, ");
+  out.print(records_written);
+  out.print(" records, ");
+  out.print(compactions);
+  out.println(" compactions");
+
+  mutex_enter_blocking(&cfg_mutex);
+  for (uint8_t i = 0; i < entry_count; i++) {
+    char line[40];
+    snprintf(line, sizeof(line), "  key %u: %u bytes%s%s", entries[i].key, entries[i].len,
+             entries[i].dirty ? " dirty" : "", entries[i].deleted ? " deleted" : "");
+    out.println(line);
+  }
+  mutex_exit(&cfg_mutex);
+}
@@ -1,3 +1,61 @@
 #pragma once
 
 // Config module header
+//
+// Persistent key/value store for settings and game state, kept in the
+// config flash partition as a log:
+//
+//   sector: uint32 magic, uint32 seq, then records
+//   record: uint16 key, uint16 len, uint16 crc16, value, padded to 4 bytes
+//           (len 0 = key deleted)
+//
+// Updates are appended to the active sector. When it fills, the live set
+// is compacted into the next sector of the ring and that sector's header
+// (with seq + 1) is programmed last, so a torn compaction leaves the old
+// sector authoritative. Rotating through every sector of the partition
+// levels wear. At boot only the newest sector is scanned: its compacted
+// snapshot plus the updates since, i.e. bounded by the live keys.
+//
+// All reads and writes go to a RAM mirror; config_set() never touches
+// flash. Dirty keys are written by config_flush_task() running on core1
+// (loop1), so core0 never waits for a program or erase to be issued.
+// XIP limits what this buys: while flash is busy nothing can be fetched
+// from it, so core0 is still parked in RAM for each page program (~1 ms)
+// and each compaction erase (~50 ms). Writes are coalesced for
+// CONFIG_FLUSH_DELAY_MS to keep those pauses rare.
+
+#include <Arduino.h>
+
+enum ConfigKey : uint16_t {
+  CFG_KEY_THEME = 1,          // uint8_t theme index
+  CFG_KEY_HIGH_SCORES,        // int per arcade game (Game.cpp registry)
+  CFG_KEY_PET,                // PetSave
+  CFG_KEY_ALARMS,             // AlarmSave[]
+};
+
+#define CONFIG_MAX_KEYS        32
+#define CONFIG_ARENA_BYTES     2048      // RAM mirror for all values
+#define CONFIG_MAX_VALUE       512
+#define CONFIG_FLUSH_DELAY_MS  1000
+
+// Load the newest snapshot from flash (core0, before the flush task runs)
+bool config_init();
+
+// Copy a value into the mirror; flushed in the background. Setting the
+// same bytes again is free.
+bool config_set(uint16_t key, const void *data, uint16_t len);
+
+// Copy a value out; returns its length or -1 if unknown
+int16_t config_get(uint16_t key, void *out, uint16_t max);
+
+bool config_remove(uint16_t key);
+
+// Core1 worker: writes dirty keys (and compacts) when due
+void config_flush_task();
+
+// True while changes are waiting for the flush task
+bool config_pending();
+
+uint32_t config_records_written();
+uint32_t config_compactions();
+void config_print(Print &out);
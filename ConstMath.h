@@ -0,0 +1,44 @@
+/*
+ * ConstMath.h - constexpr maths for tables generated at compile time
+ *
+ * Lookup tables are built with these inside a constexpr function and
+ * checked with static_asserts, then copied into a plain (non-const)
+ * static. The copy is still constant-initialised, so nothing runs at
+ * boot, but it lands in .data in SRAM instead of .rodata in flash: code
+ * on the audio IRQ or the frame path reads its table without ever
+ * stalling on an XIP cache miss.
+ */
+
+#ifndef CONST_MATH_H
+#define CONST_MATH_H
+
+static constexpr double PI_D = 3.14159265358979323846;
+static constexpr double LN2 = 0.69314718055994530942;
+
+// Taylor series, accurate to well under 1 LSB of Q15 for |x| <= pi
+constexpr double cx_sin(double x) {
+  double term = x, sum = x;
+  for (int k = 1; k < 12; k++) {
+    term *= -x * x / ((2 * k) * (2 * k + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+// For 0 <= x <= 2 pi, folded into cx_sin's range
+constexpr double cx_cos(double x) {
+  double y = PI_D / 2 - x;
+  return cx_sin(y < -PI_D ? y + 2 * PI_D : y);
+}
+
+// Taylor series; used for |x| <= ln 2
+constexpr double cx_exp(double x) {
+  double term = 1, sum = 1;
+  for (int k = 1; k < 20; k++) {
+    term *= x / k;
+    sum += term;
+  }
+  return sum;
+}
+
+#endif // CONST_MATH_H
@@ -52,6 +52,8 @@
 #define Touch_RST_PIN 5
 #define Touch_INT_PIN 4
 
+#define RTC_INT_PIN   16    // PCF85063 INT, open drain, active low
+
 extern uint dma_tx;
 extern dma_channel_config c;
 
@@ -0,0 +1,89 @@
+/*
+ * DemoSong.h - "Pico Nights", a Tracker.h song
+ *
+ * Generated by tools/tracker_convert from demo_song.txt; edit that and convert again.
+ */
+
+#ifndef DEMO_SONG_H
+#define DEMO_SONG_H
+
+#include <stdint.h>
+
+static const uint8_t DEMO_SONG[1175] = {
+  0x54, 0x52, 0x4B, 0x31, 0x04, 0x06, 0x05, 0x06, 0x06, 0x7D, 0x02, 0x20, 0x50, 0x69, 0x63, 0x6F,
+  0x20, 0x4E, 0x69, 0x67, 0x68, 0x74, 0x73, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x01, 0x22, 0x96, 0x00, 0x04, 0x00, 0xA0, 0x00, 0x5A, 0x00, 0x02, 0x38, 0xBE, 0x00, 0x02, 0x00,
+  0x50, 0x00, 0x28, 0x00, 0x03, 0x14, 0x5A, 0x00, 0x02, 0x00, 0x2C, 0x01, 0x3C, 0x00, 0x00, 0x30,
+  0x00, 0x00, 0x01, 0x00, 0x8C, 0x00, 0x0A, 0x00, 0x04, 0x26, 0x00, 0x00, 0x01, 0x00, 0x6E, 0x00,
+  0x0A, 0x00, 0x04, 0x16, 0x00, 0x00, 0x01, 0x00, 0x23, 0x00, 0x05, 0x00, 0x00, 0x01, 0x02, 0x03,
+  0x02, 0x04, 0x6C, 0x00, 0x40, 0x01, 0x30, 0x02, 0xE0, 0x02, 0x8D, 0x03, 0x0E, 0x03, 0x22, 0x02,
+  0x0B, 0x3A, 0x03, 0x00, 0x37, 0x0B, 0x25, 0x04, 0x02, 0x30, 0x04, 0x08, 0x00, 0x37, 0x06, 0x03,
+  0x2E, 0x02, 0x08, 0x00, 0x37, 0x04, 0x08, 0x00, 0x37, 0x0E, 0x03, 0x22, 0x02, 0x08, 0x00, 0x37,
+  0x03, 0x49, 0x05, 0x04, 0x08, 0x00, 0x37, 0x06, 0x03, 0x2E, 0x02, 0x08, 0x00, 0x37, 0x04, 0x08,
+  0x00, 0x37, 0x0E, 0x03, 0x22, 0x02, 0x08, 0x00, 0x37, 0x0B, 0x25, 0x04, 0x02, 0x30, 0x04, 0x08,
+  0x00, 0x37, 0x06, 0x03, 0x2E, 0x02, 0x08, 0x00, 0x37, 0x04, 0x08, 0x00, 0x37, 0x0E, 0x03, 0x22,
+  0x02, 0x08, 0x00, 0x37, 0x03, 0x49, 0x05, 0x04, 0x08, 0x00, 0x37, 0x06, 0x03, 0x2E, 0x02, 0x08,
+  0x00, 0x37, 0x04, 0x08, 0x00, 0x37, 0x0E, 0x03, 0x1E, 0x02, 0x0B, 0x36, 0x03, 0x00, 0x47, 0x0B,
+  0x25, 0x04, 0x02, 0x30, 0x04, 0x08, 0x00, 0x47, 0x06, 0x03, 0x2A, 0x02, 0x08, 0x00, 0x47, 0x04,
+  0x08, 0x00, 0x47, 0x0E, 0x03, 0x1E, 0x02, 0x08, 0x00, 0x47, 0x03, 0x49, 0x05, 0x04, 0x08, 0x00,
+  0x47, 0x06, 0x03, 0x2A, 0x02, 0x08, 0x00, 0x47, 0x04, 0x08, 0x00, 0x47, 0x0E, 0x03, 0x1E, 0x02,
+  0x08, 0x00, 0x47, 0x0B, 0x25, 0x04, 0x02, 0x30, 0x04, 0x08, 0x00, 0x47, 0x06, 0x03, 0x2A, 0x02,
+  0x08, 0x00, 0x47, 0x04, 0x08, 0x00, 0x47, 0x0E, 0x03, 0x1E, 0x02, 0x08, 0x00, 0x47, 0x03, 0x49,
+  0x05, 0x04, 0x08, 0x00, 0x47, 0x06, 0x03, 0x2A, 0x02, 0x08, 0x00, 0x47, 0x04, 0x08, 0x00, 0x47,
+  0x0E, 0x03, 0x19, 0x02, 0x0B, 0x31, 0x03, 0x00, 0x47, 0x0B, 0x25, 0x04, 0x02, 0x30, 0x04, 0x08,
+  0x00, 0x47, 0x0E, 0x03, 0x25, 0x02, 0x08, 0x00, 0x47, 0x03, 0x55, 0x06, 0x04, 0x08, 0x00, 0x47,
+  0x0E, 0x03, 0x19, 0x02, 0x08, 0x00, 0x47, 0x03, 0x49, 0x05, 0x04, 0x08, 0x00, 0x47, 0x0E, 0x03,
+  0x25, 0x02, 0x08, 0x00, 0x47, 0x07, 0x55, 0x06, 0x28, 0x04, 0x08, 0x00, 0x47, 0x0E, 0x03, 0x19,
+  0x02, 0x08, 0x00, 0x47, 0x0B, 0x25, 0x04, 0x02, 0x30, 0x04, 0x08, 0x00, 0x47, 0x0E, 0x03, 0x25,
+  0x02, 0x08, 0x00, 0x47, 0x03, 0x55, 0x06, 0x04, 0x08, 0x00, 0x47, 0x0E, 0x03, 0x19, 0x02, 0x08,
+  0x00, 0x47, 0x03, 0x49, 0x05, 0x04, 0x08, 0x00, 0x47, 0x0E, 0x03, 0x25, 0x02, 0x08, 0x00, 0x47,
+  0x07, 0x55, 0x06, 0x28, 0x04, 0x08, 0x00, 0x47, 0x0E, 0x03, 0x20, 0x02, 0x0B, 0x38, 0x03, 0x00,
+  0x47, 0x0B, 0x25, 0x04, 0x02, 0x30, 0x04, 0x08, 0x00, 0x47, 0x0E, 0x03, 0x2C, 0x02, 0x08, 0x00,
+  0x47, 0x03, 0x55, 0x06, 0x04, 0x08, 0x00, 0x47, 0x0E, 0x03, 0x20, 0x02, 0x08, 0x00, 0x47, 0x03,
+  0x49, 0x05, 0x04, 0x08, 0x00, 0x47, 0x0E, 0x03, 0x2C, 0x02, 0x08, 0x00, 0x47, 0x07, 0x55, 0x06,
+  0x28, 0x04, 0x08, 0x00, 0x47, 0x0E, 0x03, 0x20, 0x02, 0x08, 0x00, 0x47, 0x0B, 0x25, 0x04, 0x02,
+  0x30, 0x04, 0x08, 0x00, 0x47, 0x0E, 0x03, 0x2C, 0x02, 0x08, 0x00, 0x47, 0x03, 0x55, 0x06, 0x04,
+  0x08, 0x00, 0x47, 0x0E, 0x03, 0x20, 0x02, 0x08, 0x00, 0x47, 0x03, 0x49, 0x05, 0x04, 0x08, 0x00,
+  0x47, 0x0E, 0x03, 0x2C, 0x02, 0x08, 0x00, 0x47, 0x07, 0x55, 0x06, 0x28, 0x04, 0x08, 0x00, 0x47,
+  0x0B, 0x03, 0x3A, 0x01, 0x03, 0x22, 0x02, 0x0B, 0x25, 0x04, 0x02, 0x30, 0x80, 0x0A, 0x03, 0x2E,
+  0x02, 0x03, 0x55, 0x06, 0x80, 0x0B, 0x03, 0x3D, 0x01, 0x03, 0x22, 0x02, 0x03, 0x49, 0x05, 0x80,
+  0x0B, 0x03, 0x41, 0x01, 0x03, 0x2E, 0x02, 0x07, 0x55, 0x06, 0x28, 0x80, 0x0B, 0x0B, 0x3F, 0x01,
+  0x04, 0x42, 0x03, 0x22, 0x02, 0x0B, 0x25, 0x04, 0x02, 0x30, 0x80, 0x0A, 0x03, 0x2E, 0x02, 0x03,
+  0x55, 0x06, 0x80, 0x0B, 0x03, 0x3D, 0x01, 0x03, 0x22, 0x02, 0x03, 0x49, 0x05, 0x80, 0x0B, 0x03,
+  0x3C, 0x01, 0x03, 0x2E, 0x02, 0x07, 0x55, 0x06, 0x28, 0x80, 0x0B, 0x03, 0x3D, 0x01, 0x03, 0x1E,
+  0x02, 0x0B, 0x25, 0x04, 0x02, 0x30, 0x80, 0x0A, 0x03, 0x2A, 0x02, 0x03, 0x55, 0x06, 0x80, 0x0B,
+  0x03, 0x3A, 0x01, 0x03, 0x1E, 0x02, 0x03, 0x49, 0x05, 0x80, 0x0B, 0x03, 0x3D, 0x01, 0x03, 0x2A,
+  0x02, 0x07, 0x55, 0x06, 0x28, 0x80, 0x0B, 0x0B, 0x42, 0x01, 0x04, 0x42, 0x03, 0x1E, 0x02, 0x0B,
+  0x25, 0x04, 0x02, 0x30, 0x80, 0x0A, 0x03, 0x2A, 0x02, 0x03, 0x55, 0x06, 0x80, 0x0A, 0x03, 0x1E,
+  0x02, 0x03, 0x49, 0x05, 0x80, 0x0B, 0x01, 0x61, 0x03, 0x2A, 0x02, 0x07, 0x55, 0x06, 0x28, 0x80,
+  0x0B, 0x03, 0x38, 0x01, 0x03, 0x19, 0x02, 0x0B, 0x25, 0x04, 0x02, 0x30, 0x80, 0x0A, 0x03, 0x25,
+  0x02, 0x03, 0x55, 0x06, 0x80, 0x0B, 0x03, 0x3D, 0x01, 0x03, 0x19, 0x02, 0x03, 0x49, 0x05, 0x80,
+  0x0B, 0x03, 0x41, 0x01, 0x03, 0x25, 0x02, 0x07, 0x55, 0x06, 0x28, 0x80, 0x0B, 0x0B, 0x44, 0x01,
+  0x04, 0x42, 0x03, 0x19, 0x02, 0x0B, 0x25, 0x04, 0x02, 0x30, 0x80, 0x0A, 0x03, 0x25, 0x02, 0x03,
+  0x55, 0x06, 0x80, 0x0A, 0x03, 0x19, 0x02, 0x03, 0x49, 0x05, 0x80, 0x0A, 0x03, 0x25, 0x02, 0x07,
+  0x55, 0x06, 0x28, 0x80, 0x0B, 0x03, 0x42, 0x01, 0x03, 0x20, 0x02, 0x0B, 0x25, 0x04, 0x02, 0x30,
+  0x80, 0x0A, 0x03, 0x2C, 0x02, 0x03, 0x55, 0x06, 0x80, 0x0B, 0x03, 0x3F, 0x01, 0x03, 0x20, 0x02,
+  0x03, 0x49, 0x05, 0x80, 0x0A, 0x03, 0x2C, 0x02, 0x07, 0x55, 0x06, 0x28, 0x80, 0x0B, 0x03, 0x3C,
+  0x01, 0x03, 0x20, 0x02, 0x0B, 0x25, 0x04, 0x02, 0x30, 0x80, 0x0B, 0x0B, 0x3F, 0x01, 0x03, 0x08,
+  0x03, 0x2C, 0x02, 0x03, 0x55, 0x06, 0x80, 0x0B, 0x0B, 0x44, 0x01, 0x0A, 0x01, 0x03, 0x20, 0x02,
+  0x03, 0x49, 0x05, 0x80, 0x0A, 0x03, 0x2C, 0x02, 0x07, 0x55, 0x06, 0x28, 0x80, 0x0F, 0x0B, 0x41,
+  0x01, 0x04, 0x42, 0x03, 0x19, 0x02, 0x0B, 0x31, 0x03, 0x00, 0x47, 0x0B, 0x25, 0x04, 0x02, 0x30,
+  0x04, 0x08, 0x00, 0x47, 0x0E, 0x03, 0x25, 0x02, 0x08, 0x00, 0x47, 0x03, 0x55, 0x06, 0x04, 0x08,
+  0x00, 0x47, 0x0E, 0x03, 0x19, 0x02, 0x08, 0x00, 0x47, 0x03, 0x49, 0x05, 0x04, 0x08, 0x00, 0x47,
+  0x0E, 0x03, 0x25, 0x02, 0x08, 0x00, 0x47, 0x07, 0x55, 0x06, 0x28, 0x04, 0x08, 0x00, 0x47, 0x0F,
+  0x03, 0x3F, 0x01, 0x03, 0x19, 0x02, 0x08, 0x00, 0x47, 0x0B, 0x25, 0x04, 0x02, 0x30, 0x04, 0x08,
+  0x00, 0x47, 0x0E, 0x03, 0x25, 0x02, 0x08, 0x00, 0x47, 0x03, 0x55, 0x06, 0x04, 0x08, 0x00, 0x47,
+  0x0F, 0x03, 0x3D, 0x01, 0x03, 0x19, 0x02, 0x08, 0x00, 0x47, 0x03, 0x49, 0x05, 0x04, 0x08, 0x00,
+  0x47, 0x0E, 0x03, 0x25, 0x02, 0x08, 0x00, 0x47, 0x07, 0x55, 0x06, 0x28, 0x04, 0x08, 0x00, 0x47,
+  0x0F, 0x0B, 0x3C, 0x01, 0x04, 0x42, 0x03, 0x20, 0x02, 0x0B, 0x38, 0x03, 0x00, 0x47, 0x0B, 0x25,
+  0x04, 0x02, 0x30, 0x04, 0x08, 0x00, 0x47, 0x0E, 0x03, 0x2C, 0x02, 0x08, 0x00, 0x47, 0x03, 0x55,
+  0x06, 0x04, 0x08, 0x00, 0x47, 0x0E, 0x03, 0x20, 0x02, 0x08, 0x00, 0x47, 0x03, 0x49, 0x05, 0x04,
+  0x08, 0x00, 0x47, 0x0E, 0x03, 0x2C, 0x02, 0x08, 0x00, 0x47, 0x07, 0x55, 0x06, 0x28, 0x04, 0x08,
+  0x00, 0x47, 0x0F, 0x03, 0x3F, 0x01, 0x03, 0x20, 0x02, 0x08, 0x00, 0x47, 0x0B, 0x25, 0x04, 0x02,
+  0x30, 0x04, 0x08, 0x00, 0x47, 0x0E, 0x03, 0x2C, 0x02, 0x08, 0x00, 0x47, 0x03, 0x55, 0x06, 0x04,
+  0x08, 0x00, 0x47, 0x0F, 0x0B, 0x41, 0x01, 0x03, 0x02, 0x03, 0x20, 0x02, 0x08, 0x00, 0x47, 0x03,
+  0x49, 0x05, 0x04, 0x08, 0x00, 0x47, 0x0E, 0x03, 0x2C, 0x02, 0x08, 0x00, 0x47, 0x07, 0x55, 0x06,
+  0x28, 0x05, 0x01, 0x61, 0x08, 0x00, 0x47,
+};
+
+#endif // DEMO_SONG_H
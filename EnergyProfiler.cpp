@@ -0,0 +1,202 @@
+/*
+ * EnergyProfiler.cpp - Battery drain per app state implementation
+ */
+
+#include "EnergyProfiler.h"
+#include "Sensors.h"
+
+static EnergyStateNameFn state_name = nullptr;
+
+static uint8_t  slot_state[ENERGY_MAX_STATES];
+static uint8_t  slot_count = 0;
+static uint32_t total_ms[ENERGY_MAX_STATES];
+static uint32_t seg_ms[ENERGY_MAX_STATES];       // time since the last gauge step
+static uint32_t mv_sum[ENERGY_MAX_STATES];
+static uint16_t mv_count[ENERGY_MAX_STATES];
+
+// Normal equations of the least-squares fit, hours and mAh
+static float    ata[ENERGY_MAX_STATES][ENERGY_MAX_STATES];
+static float    atb[ENERGY_MAX_STATES];
+static uint16_t steps = 0;
+
+static int8_t   cur_slot = -1;
+static uint32_t cur_since_ms = 0;
+static int16_t  last_percent = -1;
+
+static int8_t slot_for(uint8_t state) {
+  for (uint8_t i = 0; i < slot_count; i++) {
+    if (slot_state[i] == state) return i;
+  }
+  if (slot_count >= ENERGY_MAX_STATES) return -1;
+  slot_state[slot_count] = state;
+  return slot_count++;
+}
+
+// Charge time in the current state up to now
+static void flush_time() {
+  uint32_t now = millis();
+  if (cur_slot >= 0) {
+    uint32_t dt = now - cur_since_ms;
+    total_ms[cur_slot] += dt;
+    seg_ms[cur_slot] += dt;
+  }
+  cur_since_ms = now;
+}
+
+static void discard_segment() {
+  memset(seg_ms, 0, sizeof(seg_ms));
+}
+
+static void on_percent(SensorId id, const SensorReading &r, void *ctx) {
+  flush_time();
+  int16_t p = (int16_t)r.v[0];
+  bool charging = sensor_hub_get(SENSOR_CHARGING).v[0] > 0.5f;
+
+  if (last_percent < 0 || charging || p >= last_percent) {
+    discard_segment();
+    last_percent = p;
+    return;
+  }
+
+  // One equation: time per state (hours) times unknown mA = mAh drawn
+  float drop_mah = (last_percent - p) * (BATTERY_CAPACITY_MAH / 100.0f);
+  float row[ENERGY_MAX_STATES];
+  for (uint8_t i = 0; i < slot_count; i++) row[i] = seg_ms[i] / 3600000.0f;
+  for (uint8_t i = 0; i < slot_count; i++) {
+    if (row[i] == 0.0f) continue;
+    for (uint8_t j = 0; j < slot_count; j++) ata[i][j] += row[i] * row[j];
+    atb[i] += row[i] * drop_mah;
+  }
+  steps++;
+  discard_segment();
+  last_percent = p;
+}
+
+static void on_charging(SensorId id, const SensorReading &r, void *ctx) {
+  flush_time();
+  discard_segment();
+}
+
+static void on_voltage(SensorId id, const SensorReading &r, void *ctx) {
+  if (cur_slot < 0) return;
+  mv_sum[cur_slot] += (uint32_t)r.v[0];
+  mv_count[cur_slot]++;
+}
+
+void energy_profiler_init(EnergyStateNameFn name_fn) {
+  state_name = name_fn;
+  energy_profiler_reset();
+  sensor_hub_subscribe(SENSOR_BATTERY_PERCENT, 0, 0.0f, on_percent);
+  sensor_hub_subscribe(SENSOR_CHARGING, 0, 0.0f, on_charging);
+  sensor_hub_subscribe(SENSOR_BATTERY_VOLTAGE, 0, 0.0f, on_voltage);
+}
+
+void energy_profiler_reset() {
+  slot_count = 0;
+  memset(total_ms, 0, sizeof(total_ms));
+  memset(seg_ms, 0, sizeof(seg_ms));
+  memset(mv_sum, 0, sizeof(mv_sum));
+  memset(mv_count, 0, sizeof(mv_count));
+  memset(ata, 0, sizeof(ata));
+  memset(atb, 0, sizeof(atb));
+  steps = 0;
+  cur_slot = -1;
+  cur_since_ms = millis();
+  last_percent = -1;
+}
+
+void energy_profiler_set_state(uint8_t state) {
+  if (cur_slot >= 0 && slot_state[cur_slot] == state) return;
+  flush_time();
+  cur_slot = slot_for(state);
+}
+
+uint16_t energy_profiler_steps() {
+  return steps;
+}
+
+// Solve (AtA + lambda*I) x = Atb by Gaussian elimination with partial
+// pivoting. The small ridge term keeps states that never overlapped with
+// a gauge step from making the system singular.
+static void solve_currents(float *x) {
+  const uint8_t n = slot_count;
+  float m[ENERGY_MAX_STATES][ENERGY_MAX_STATES + 1];
+  for (uint8_t i = 0; i < n; i++) {
+    for (uint8_t j = 0; j < n; j++) m[i][j] = ata[i][j];
+    m[i][i] += 1e-6f;
+    m[i][n] = atb[i];
+  }
+
+  for (uint8_t col = 0; col < n; col++) {
+    uint8_t piv = col;
+    for (uint8_t r = col + 1; r < n; r++) {
+      if (fabsf(m[r][col]) > fabsf(m[piv][col])) piv = r;
+    }
+    if (piv != col) {
+      for (uint8_t j = col; j <= n; j++) {
+        float t = m[col][j]; m[col][j] = m[piv][j]; m[piv][j] = t;
+      }
+    }
+    float d = m[col][col];
+    if (fabsf(d) < 1e-12f) continue;
+    for (uint8_t r = 0; r < n; r++) {
+      if (r == col) continue;
+      float f = m[r][col] / d;
+      if (f == 0.0f) continue;
+      for (uint8_t j = col; j <= n; j++) m[r][j] -= f * m[col][j];
+    }
+  }
+
+  for (uint8_t i = 0; i < n; i++) {
+    float d = m[i][i];
+    x[i] = (fabsf(d) < 1e-12f) ? 0.0f : m[i][n] / d;
+    if (x[i] < 0.0f) x[i] = 0.0f;   // a state cannot charge the battery
+  }
+}
+
+uint8_t energy_profiler_report(EnergyReport *out, uint8_t max) {
+  flush_time();
+
+  float ma[ENERGY_MAX_STATES];
+  solve_currents(ma);
+
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < slot_count && n < max; i++) {
+    EnergyReport &e = out[n++];
+    e.state = slot_state[i];
+    e.seconds = total_ms[i] / 1000;
+    e.ma = ma[i];
+    e.avg_mv = mv_count[i] ? mv_sum[i] / mv_count[i] : 0;
+    float hours = total_ms[i] / 3600000.0f;
+    float volts = e.avg_mv ? e.avg_mv / 1000.0f : 3.7f;
+    e.mwh = e.ma * hours * volts;
+  }
+
+  // Most expensive first (insertion sort, n is tiny)
+  for (uint8_t i = 1; i < n; i++) {
+    EnergyReport t = out[i];
+    int8_t j = i - 1;
+    while (j >= 0 && out[j].ma < t.ma) { out[j + 1] = out[j]; j--; }
+    out[j + 1] = t;
+  }
+  return n;
+}
+
+void energy_profiler_print(Print &out) {
+  EnergyReport rep[ENERGY_MAX_STATES];
+  uint8_t n = energy_profiler_report(rep, ENERGY_MAX_STATES);
+
+  out.print("Energy profile: ");
+  out.print(steps);
+  out.print(" gauge steps, capacity ");
+  out.print(BATTERY_CAPACITY_MAH);
+  out.println(" mAh");
+  out.println("state            time_s      mA     mWh    mV");
+  for (uint8_t i = 0; i < n; i++) {
+    char line[64];
+    const char *name = state_name ? state_name(rep[i].state) : "?";
+    snprintf(line, sizeof(line), "%-14s %8lu %7.1f %7.2f %5u",
+             name, (unsigned long)rep[i].seconds, rep[i].ma, rep[i].mwh, rep[i].avg_mv);
+    out.println(line);
+  }
+}
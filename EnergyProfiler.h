@@ -0,0 +1,45 @@
+/*
+ * EnergyProfiler.h - Battery drain per app state
+ *
+ * The AXP2101 has no battery current ADC, so drain is derived from the
+ * fuel gauge: time spent in each state is accumulated between gauge
+ * steps, every step (percent drop on battery) gives one equation
+ *   sum_s(hours_s * mA_s) = drop_mAh
+ * and the per-state current is the least-squares solution over all steps
+ * seen so far. Battery voltage is averaged per state alongside, so energy
+ * (mWh) can be reported too. Accuracy improves the longer it runs.
+ */
+
+#ifndef ENERGY_PROFILER_H
+#define ENERGY_PROFILER_H
+
+#include <Arduino.h>
+
+#define ENERGY_MAX_STATES       16
+#define BATTERY_CAPACITY_MAH    300     // cell fitted to the watch
+
+typedef const char *(*EnergyStateNameFn)(uint8_t state);
+
+struct EnergyReport {
+  uint8_t  state;
+  uint32_t seconds;       // total time spent in the state
+  float    ma;            // estimated average draw (mAh per hour)
+  float    mwh;           // estimated energy used in the state
+  uint16_t avg_mv;        // mean battery voltage while in the state
+};
+
+void energy_profiler_init(EnergyStateNameFn name_fn);
+
+// Call whenever the app state may have changed (cheap when it has not)
+void energy_profiler_set_state(uint8_t state);
+
+// Fill up to max entries, most expensive first; returns count
+uint8_t energy_profiler_report(EnergyReport *out, uint8_t max);
+
+// Number of gauge steps used so far
+uint16_t energy_profiler_steps();
+
+void energy_profiler_print(Print &out);
+void energy_profiler_reset();
+
+#endif // ENERGY_PROFILER_H
@@ -0,0 +1,201 @@
+/*
+ * Fft.cpp - Q15 fixed-point real FFT implementation
+ */
+
+#include "Fft.h"
+#include "ConstMath.h"
+
+#if defined(__ARM_FEATURE_SIMD32)
+#include <arm_acle.h>
+#endif
+
+#define TWIDDLES  (FFT_MAX_POINTS / 2)
+
+// Packed complex Q15: re in the low half, im in the high half
+typedef uint32_t __attribute__((may_alias)) cq15;
+
+// ---------- SIMD primitives ----------
+
+#if defined(__ARM_FEATURE_SIMD32)
+
+static inline uint32_t hadd(uint32_t a, uint32_t b) { return __shadd16(a, b); }
+static inline uint32_t hsub(uint32_t a, uint32_t b) { return __shsub16(a, b); }
+static inline uint32_t hsax(uint32_t a, uint32_t b) { return __shsax(a, b); }
+static inline uint32_t hasx(uint32_t a, uint32_t b) { return __shasx(a, b); }
+static inline int32_t  mul_re(uint32_t x, uint32_t w) { return __smusd(x, w); }
+static inline int32_t  mul_im(uint32_t x, uint32_t w) { return __smuadx(x, w); }
+static inline int32_t  sat16(int32_t v) { return __ssat(v, 16); }
+static inline uint32_t power(uint32_t x) { return (uint32_t)__smuad(x, x); }
+
+#else
+
+static inline int32_t lo(uint32_t x) { return (int16_t)x; }
+static inline int32_t hi(uint32_t x) { return (int16_t)(x >> 16); }
+static inline uint32_t pack(int32_t re, int32_t im) { return (uint16_t)re | (uint32_t)(uint16_t)im << 16; }
+
+static inline uint32_t hadd(uint32_t a, uint32_t b) { return pack((lo(a) + lo(b)) >> 1, (hi(a) + hi(b)) >> 1); }
+static inline uint32_t hsub(uint32_t a, uint32_t b) { return pack((lo(a) - lo(b)) >> 1, (hi(a) - hi(b)) >> 1); }
+static inline uint32_t hsax(uint32_t a, uint32_t b) { return pack((lo(a) + hi(b)) >> 1, (hi(a) - lo(b)) >> 1); }
+static inline uint32_t hasx(uint32_t a, uint32_t b) { return pack((lo(a) - hi(b)) >> 1, (hi(a) + lo(b)) >> 1); }
+static inline int32_t  mul_re(uint32_t x, uint32_t w) { return lo(x) * lo(w) - hi(x) * hi(w); }
+static inline int32_t  mul_im(uint32_t x, uint32_t w) { return lo(x) * hi(w) + hi(x) * lo(w); }
+static inline int32_t  sat16(int32_t v) { return v > 32767 ? 32767 : (v < -32768 ? -32768 : v); }
+static inline uint32_t power(uint32_t x) { return (uint32_t)(lo(x) * lo(x) + hi(x) * hi(x)); }
+
+#endif
+
+static inline uint32_t cpack(int32_t re, int32_t im) {
+  return (uint16_t)sat16(re) | (uint32_t)(uint16_t)sat16(im) << 16;
+}
+
+static inline uint32_t cmul(uint32_t x, uint32_t w) {
+  return cpack(mul_re(x, w) >> 15, mul_im(x, w) >> 15);
+}
+
+// ---------- Tables (generated at compile time) ----------
+
+struct FftTables {
+  uint32_t twiddle[TWIDDLES];      // W_512^k = (cos, -sin) for k < 256
+  int16_t  hann[FFT_MAX_POINTS];
+  uint8_t  bitrev[256];
+};
+
+static constexpr int16_t q15(double v) {
+  double s = v * 32767;
+  return (int16_t)(s < 0 ? s - 0.5 : s + 0.5);
+}
+
+static constexpr FftTables make_tables() {
+  FftTables t{};
+  for (int k = 0; k < TWIDDLES; k++) {
+    double x = 2 * PI_D * k / FFT_MAX_POINTS;
+    t.twiddle[k] = (uint16_t)q15(cx_cos(x)) | (uint32_t)(uint16_t)q15(-cx_sin(x)) << 16;
+  }
+  for (int i = 0; i < FFT_MAX_POINTS; i++) {
+    t.hann[i] = q15(0.5 - 0.5 * cx_cos(2 * PI_D * i / FFT_MAX_POINTS));
+  }
+  for (int i = 0; i < 256; i++) {
+    int r = 0;
+    for (int b = 0; b < 8; b++) r |= ((i >> b) & 1) << (7 - b);
+    t.bitrev[i] = (uint8_t)r;
+  }
+  return t;
+}
+
+static constexpr FftTables TABLES = make_tables();
+static_assert((int16_t)TABLES.twiddle[0] == 32767 && TABLES.twiddle[128] >> 16 == 0x8001, "twiddle quadrants");
+static_assert(TABLES.hann[FFT_MAX_POINTS / 2] == 32767, "window peak");
+
+// SRAM copy for the butterflies (see ConstMath.h)
+static FftTables tables = TABLES;
+
+static uint16_t n_points = 512;
+static uint8_t  stride = 1;        // table step for this length
+
+bool fft_init(uint16_t points) {
+  if (points != 256 && points != 512) return false;
+  n_points = points;
+  stride = FFT_MAX_POINTS / points;
+  return true;
+}
+
+uint16_t fft_points() {
+  return n_points;
+}
+
+void fft_window(int16_t *buf) {
+  const int16_t *w = tables.hann;
+  for (uint16_t i = 0; i < n_points; i++) {
+    buf[i] = (int16_t)((buf[i] * w[i * stride]) >> 15);
+  }
+}
+
+// Radix-4 DIT over m bit-reversed complex points, halving at each level
+static void complex_fft(cq15 *z, uint16_t m) {
+  uint8_t shift = m == 256 ? 0 : 1;
+  for (uint16_t i = 0; i < m; i++) {
+    uint16_t r = tables.bitrev[i] >> shift;
+    if (r > i) {
+      uint32_t t = z[i];
+      z[i] = z[r];
+      z[r] = t;
+    }
+  }
+
+  uint16_t h = 1;
+  if (shift) {
+    // Odd number of levels: one radix-2 pass with unit twiddles first
+    for (uint16_t i = 0; i < m; i += 2) {
+      uint32_t a = z[i], b = z[i + 1];
+      z[i] = hadd(a, b);
+      z[i + 1] = hsub(a, b);
+    }
+    h = 2;
+  }
+
+  // Each pass fuses the radix-2 levels of size 2h and 4h
+  for (; h < m; h *= 4) {
+    uint16_t step = TWIDDLES / 2 / h;  // W_4h^j = W_512^(j * 128 / h)
+    uint16_t span = 4 * h;
+    for (uint16_t j = 0; j < h; j++) {
+      uint32_t w2 = tables.twiddle[j * step];
+      uint32_t w1 = tables.twiddle[2 * j * step];
+      for (uint16_t g = j; g < m; g += span) {
+        uint32_t a = z[g], b = z[g + h], c = z[g + 2 * h], d = z[g + 3 * h];
+        uint32_t t = cmul(b, w1);
+        uint32_t a1 = hadd(a, t), b1 = hsub(a, t);
+        t = cmul(d, w1);
+        uint32_t c1 = hadd(c, t), d1 = hsub(c, t);
+        t = cmul(c1, w2);
+        z[g]         = hadd(a1, t);
+        z[g + 2 * h] = hsub(a1, t);
+        t = cmul(d1, w2);                // times -i folded into the exchange
+        z[g + h]     = hsax(b1, t);
+        z[g + 3 * h] = hasx(b1, t);
+      }
+    }
+  }
+}
+
+void fft_real(int16_t *buf) {
+  cq15 *z = (cq15 *)buf;
+  uint16_t m = n_points / 2;
+  complex_fft(z, m);
+
+  // Split: X[k] = Fe[k] + W^k Fo[k], and X[m-k] = conj(Fe[k] - W^k Fo[k])
+  int32_t zr = (int16_t)z[0], zi = (int16_t)(z[0] >> 16);
+  z[0] = cpack(zr + zi, zr - zi);
+  for (uint16_t k = 1; k <= m / 2; k++) {
+    uint32_t a = z[k], b = z[m - k];
+    int32_t ar = (int16_t)a, ai = (int16_t)(a >> 16);
+    int32_t br = (int16_t)b, bi = (int16_t)(b >> 16);
+    int32_t er = (ar + br) >> 1, ei = (ai - bi) >> 1;          // Fe = (Z[k] + conj Z[m-k]) / 2
+    uint32_t fo = cpack((ai + bi) >> 1, (br - ar) >> 1);       // Fo = -i (Z[k] - conj Z[m-k]) / 2
+    uint32_t t = cmul(fo, tables.twiddle[k * stride]);
+    int32_t tr = (int16_t)t, ti = (int16_t)(t >> 16);
+    z[k] = cpack(er + tr, ei + ti);
+    if (k != m - k) z[m - k] = cpack(er - tr, ti - ei);
+  }
+}
+
+void fft_magnitude_db(const int16_t *bins, uint8_t *db) {
+  const cq15 *z = (const cq15 *)bins;
+  uint16_t m = n_points / 2;
+  for (uint16_t k = 0; k < m; k++) {
+    uint32_t p;
+    if (k == 0) {
+      int32_t dc = (int16_t)z[0];
+      p = (uint32_t)(dc * dc);               // the im half is the Nyquist bin
+    } else {
+      p = power(z[k]);
+    }
+    if (!p) {
+      db[k] = 0;
+      continue;
+    }
+    // log2 from the leading bit plus a linear mantissa, then 10 log10(2) = 3.0103
+    uint32_t e = 31 - __builtin_clz(p);
+    uint32_t frac = e >= 8 ? (p >> (e - 8)) & 0xFF : (p << (8 - e)) & 0xFF;
+    db[k] = (uint8_t)(((e << 8 | frac) * 771) >> 16);
+  }
+}
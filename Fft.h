@@ -0,0 +1,41 @@
+/*
+ * Fft.h - Q15 fixed-point real FFT
+ *
+ * A 256- or 512-point real transform, done as a half-length complex FFT
+ * followed by the usual split step. The complex FFT is radix-4
+ * decimation-in-time (plus one radix-2 pass when the length needs it)
+ * over packed (re, im) int16 pairs. On the M33 each butterfly maps onto
+ * the DSP SIMD instructions: SMUSD/SMUADX for the twiddle multiply,
+ * SHADD16/SHSUB16/SHASX/SHSAX for the halving adds. Every radix-2 level
+ * halves, so nothing overflows and the output is scaled so that a
+ * full-scale sine reads as full scale in its bin. Other targets (the
+ * host benchmark) get plain C versions of the same operations, with
+ * identical results.
+ *
+ * Twiddles and the Hann window are built at compile time. No Arduino
+ * dependencies. Not reentrant.
+ */
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <stdint.h>
+
+#define FFT_MAX_POINTS  512
+
+// Select the transform length (256 or 512); false for anything else
+bool fft_init(uint16_t points);
+uint16_t fft_points();
+
+// Apply a Hann window to points samples in place
+void fft_window(int16_t *buf);
+
+// Transform points real samples in place (buf 4-byte aligned). Afterwards
+// buf holds points/2 complex bins as (re, im) pairs; bin 0 carries DC in
+// re and the Nyquist bin in im.
+void fft_real(int16_t *buf);
+
+// Power of each of the points/2 bins in dB above one LSB (0-93)
+void fft_magnitude_db(const int16_t *bins, uint8_t *db);
+
+#endif // FFT_H
@@ -0,0 +1,39 @@
+/*
+ * FlashLayout.h - Data partitions at the top of the QSPI flash
+ *
+ * The sketch image grows up from the start of flash; data partitions are
+ * carved down from the end. The last sector stays reserved for the core's
+ * EEPROM emulation. Offsets are from the start of flash (not XIP_BASE)
+ * and sector aligned. Build with "Flash Size: no FS" so the core does not
+ * place a filesystem on top of these. Host tools include this file with
+ * their own FLASH_SECTOR_SIZE and PICO_FLASH_SIZE_BYTES.
+ *
+ *   end - 4 KB     EEPROM emulation (core)
+ *   below          timeline event log
+ *   below          settings / state key-value log
+ *   below          asset pack (written by picotool, read-only here)
+ */
+
+#ifndef FLASH_LAYOUT_H
+#define FLASH_LAYOUT_H
+
+#ifdef ARDUINO
+#include "hardware/flash.h"
+#endif
+
+#define FLASH_TOTAL_BYTES       PICO_FLASH_SIZE_BYTES
+#define FLASH_RESERVED_TOP      FLASH_SECTOR_SIZE
+
+#define FLASH_TIMELINE_SIZE     (256u * 1024u)
+#define FLASH_TIMELINE_OFFSET   (FLASH_TOTAL_BYTES - FLASH_RESERVED_TOP - FLASH_TIMELINE_SIZE)
+
+#define FLASH_CONFIG_SIZE       (32u * 1024u)
+#define FLASH_CONFIG_OFFSET     (FLASH_TIMELINE_OFFSET - FLASH_CONFIG_SIZE)
+
+#define FLASH_ASSETS_SIZE       (512u * 1024u)
+#define FLASH_ASSETS_OFFSET     (FLASH_CONFIG_OFFSET - FLASH_ASSETS_SIZE)
+
+// Lowest partition; the sketch image must end below this
+#define FLASH_DATA_START        FLASH_ASSETS_OFFSET
+
+#endif // FLASH_LAYOUT_H
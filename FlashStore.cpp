@@ -0,0 +1,80 @@
+/*
+ * FlashStore.cpp - Raw access to the flash data partitions implementation
+ */
+
+#include "FlashStore.h"
+#include "pico/mutex.h"
+
+// End of the sketch image, from the linker script
+extern "C" uint8_t __flash_binary_end;
+
+auto_init_mutex(flash_mutex);
+
+bool flash_store_ok() {
+  return (uint32_t)&__flash_binary_end - XIP_BASE <= FLASH_DATA_START;
+}
+
+static bool in_partitions(uint32_t offset, uint32_t len) {
+  return offset >= FLASH_DATA_START && offset + len <= FLASH_TOTAL_BYTES - FLASH_RESERVED_TOP;
+}
+
+bool flash_store_erase(uint32_t offset, uint32_t len) {
+  if (!in_partitions(offset, len)) return false;
+  if ((offset | len) & (FLASH_SECTOR_SIZE - 1)) return false;
+
+  mutex_enter_blocking(&flash_mutex);
+  noInterrupts();
+  rp2040.idleOtherCore();
+  flash_range_erase(offset, len);
+  rp2040.resumeOtherCore();
+  interrupts();
+  mutex_exit(&flash_mutex);
+  return true;
+}
+
+bool flash_store_program(uint32_t offset, const void *data, uint32_t len) {
+  if (!in_partitions(offset, len)) return false;
+
+  uint8_t page[FLASH_PAGE_SIZE];
+  const uint8_t *src = (const uint8_t *)data;
+
+  while (len) {
+    uint32_t page_off = offset & ~(FLASH_PAGE_SIZE - 1);
+    uint32_t in_page = offset - page_off;
+    uint32_t n = FLASH_PAGE_SIZE - in_page;
+    if (n > len) n = len;
+
+    memset(page, 0xFF, sizeof(page));
+    memcpy(page + in_page, src, n);
+
+    mutex_enter_blocking(&flash_mutex);
+    noInterrupts();
+    rp2040.idleOtherCore();
+    flash_range_program(page_off, page, FLASH_PAGE_SIZE);
+    rp2040.resumeOtherCore();
+    interrupts();
+    mutex_exit(&flash_mutex);
+
+    offset += n;
+    src += n;
+    len -= n;
+  }
+  return true;
+}
+
+bool flash_store_erased(uint32_t offset, uint32_t len) {
+  const uint8_t *p = flash_store_ptr(offset);
+  while (len--) {
+    if (*p++ != 0xFF) return false;
+  }
+  return true;
+}
+
+uint16_t flash_store_crc16(uint16_t crc, const void *data, uint32_t len) {
+  const uint8_t *p = (const uint8_t *)data;
+  while (len--) {
+    crc ^= (uint16_t)*p++ << 8;
+    for (uint8_t i = 0; i < 8; i++) crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
@@ -0,0 +1,40 @@
+/*
+ * FlashStore.h - Raw access to the flash data partitions
+ *
+ * Reads are zero-copy through the XIP window. Erase and program run with
+ * interrupts off and the other core parked, because nothing may execute
+ * from flash while it is busy. Programming takes any length at any
+ * offset: bytes outside the range are sent as 0xFF, which leaves flash
+ * untouched (NOR programming can only clear bits), so small records and
+ * in-place flag clears need no read-modify-write. Either core may call
+ * erase/program; a mutex keeps the two from parking each other at once.
+ */
+
+#ifndef FLASH_STORE_H
+#define FLASH_STORE_H
+
+#include <Arduino.h>
+#include "FlashLayout.h"
+
+// True if the data partitions do not overlap the sketch image
+bool flash_store_ok();
+
+// XIP pointer to a flash offset
+static inline const uint8_t *flash_store_ptr(uint32_t offset) {
+  return (const uint8_t *)(XIP_BASE + offset);
+}
+
+// offset and len must be FLASH_SECTOR_SIZE aligned
+bool flash_store_erase(uint32_t offset, uint32_t len);
+
+// Program len bytes; the target bytes should be erased (or only clear bits)
+bool flash_store_program(uint32_t offset, const void *data, uint32_t len);
+
+// True if every byte of the range reads 0xFF, i.e. can be programmed as is
+bool flash_store_erased(uint32_t offset, uint32_t len);
+
+// CRC-16/CCITT-FALSE, start with crc = 0xFFFF; chain calls to cover
+// several pieces
+uint16_t flash_store_crc16(uint16_t crc, const void *data, uint32_t len);
+
+#endif // FLASH_STORE_H
@@ -0,0 +1,183 @@
+/*
+ * Game.cpp - Arcade game interface, registry and state arena implementation
+ */
+
+#include "Game.h"
+#include "AMOLED_1in8.h"
+#include "GUI_Paint.h"
+#include "fonts.h"
+#include "Config.h"
+#include <string.h>
+
+extern const Game GAME_ASTEROIDS;
+extern const Game GAME_TETRIS;
+extern const Game GAME_SNAKE;
+extern const Game GAME_BREAKOUT;
+
+// Menu order; the index is also the high score slot, so append only
+static const Game *const GAMES[] = {
+  &GAME_ASTEROIDS,
+  &GAME_TETRIS,
+  &GAME_SNAKE,
+  &GAME_BREAKOUT,
+};
+#define GAME_COUNT (sizeof(GAMES) / sizeof(GAMES[0]))
+static_assert(GAME_COUNT <= GAME_MAX, "raise GAME_MAX");
+
+// Every game's state, one at a time
+alignas(8) static uint8_t arena[GAME_ARENA_BYTES];
+
+static UWORD *frame = nullptr;
+static int8_t current = -1;
+static int score = 0;
+static bool over = false;
+static bool over_drawn = false;          // the game-over screen is static
+static int high_scores[GAME_MAX];
+static unsigned long rng_state = 1;
+static bool clock_pending = false;      // re-anchor on the first game_run()
+
+uint8_t game_count() {
+  return GAME_COUNT;
+}
+
+const Game *game_get(uint8_t index) {
+  return index < GAME_COUNT ? GAMES[index] : nullptr;
+}
+
+void game_framework_init(UWORD *framebuffer) {
+  frame = framebuffer;
+}
+
+static void new_game() {
+  memset(arena, 0, sizeof(arena));
+  score = 0;
+  over = over_drawn = false;
+  GAMES[current]->init(arena);
+  game_loop_redraw();
+}
+
+bool game_start(uint8_t index, uint32_t seed) {
+  if (index >= GAME_COUNT || GAMES[index]->state_size > sizeof(arena)) return false;
+  game_stop();
+  current = index;
+  rng_state = seed ? seed : 1;
+  game_loop_begin(GAMES[index]->timing, time_us_32());
+  clock_pending = true;
+  new_game();
+  return true;
+}
+
+void game_stop() {
+  if (current < 0) return;
+  if (!over) {
+    if (GAMES[current]->save) GAMES[current]->save(arena);
+    game_over();
+  }
+  current = -1;
+}
+
+int8_t game_current() {
+  return current;
+}
+
+static void step_current() {
+  if (!over) GAMES[current]->update(arena);
+}
+
+static void draw_game_over() {
+  char line[32];
+  Paint_Clear(BLACK);
+  Paint_DrawString_EN(60, 180, "GAME OVER", &Font24, 0xF800, BLACK);
+  snprintf(line, sizeof(line), "Score: %d", score);
+  Paint_DrawString_EN(80, 210, line, &Font24, WHITE, BLACK);
+  snprintf(line, sizeof(line), "High: %d", high_scores[current]);
+  Paint_DrawString_EN(80, 230, line, &Font24, WHITE, BLACK);
+  Paint_DrawString_EN(60, 260, "Touch to play again", &Font24, 0x7FFF, BLACK);
+  AMOLED_1IN8_Display(frame);
+}
+
+static void render_current(uint8_t alpha) {
+  if (!over) {
+    GAMES[current]->render(arena, alpha);
+  } else if (!over_drawn) {
+    draw_game_over();
+    over_drawn = true;
+  }
+}
+
+void game_run(uint32_t now_us) {
+  if (current < 0) return;
+  // Whatever the caller did after game_start() is not game time: no
+  // step has run yet, so restart the clock here rather than catch up
+  if (clock_pending) {
+    game_loop_begin(GAMES[current]->timing, now_us);
+    clock_pending = false;
+  }
+  bool was_over = over;
+  game_loop_run(now_us, step_current, render_current);
+  if (over && !was_over) game_loop_redraw();
+}
+
+void game_touch(uint16_t x, uint16_t y) {
+  if (current < 0) return;
+  if (over) new_game();
+  else GAMES[current]->input(arena, x, y);
+}
+
+uint32_t game_arena_peak() {
+  uint32_t peak = 0;
+  for (uint8_t i = 0; i < GAME_COUNT; i++) {
+    if (GAMES[i]->state_size > peak) peak = GAMES[i]->state_size;
+  }
+  return peak;
+}
+
+UWORD *game_framebuffer() {
+  return frame;
+}
+
+void game_add_score(int points) {
+  score += points;
+}
+
+int game_score() {
+  return score;
+}
+
+void game_over() {
+  if (current < 0 || over) return;
+  over = true;
+  if (score <= high_scores[current]) return;
+  high_scores[current] = score;
+  config_set(CFG_KEY_HIGH_SCORES, high_scores, GAME_COUNT * sizeof(int));
+}
+
+bool game_is_over() {
+  return over;
+}
+
+int game_high_score(uint8_t index) {
+  return index < GAME_COUNT ? high_scores[index] : 0;
+}
+
+int game_high_score() {
+  return current >= 0 ? high_scores[current] : 0;
+}
+
+// Records from builds with fewer games load into the leading slots
+void game_load_high_scores() {
+  int scores[GAME_MAX] = {};
+  int16_t len = config_get(CFG_KEY_HIGH_SCORES, scores, sizeof(scores));
+  if (len <= 0) return;
+  uint8_t n = len / sizeof(int);
+  for (uint8_t i = 0; i < n && i < GAME_COUNT; i++) high_scores[i] = scores[i];
+}
+
+long game_random(long max_val) {
+  rng_state = (rng_state * 1103515245 + 12345) & 0x7fffffff;
+  return rng_state % max_val;
+}
+
+long game_random(long min_val, long max_val) {
+  return min_val + game_random(max_val - min_val);
+}
@@ -0,0 +1,91 @@
+/*
+ * Game.h - Arcade game interface, registry and state arena
+ *
+ * A game is a Game table of callbacks plus one state struct. Only one
+ * game runs at a time, so every game's state lives in the same arena,
+ * zeroed and handed to init() when the game starts: games cost
+ * max(state) of RAM, not the sum. Each game file static_asserts that its
+ * state fits GAME_ARENA_BYTES.
+ *
+ * The framework owns what every game shares: the fixed-timestep runner
+ * (GameLoop.h) with each game's timing, the score, the game-over screen
+ * ("touch to play again" restarts through init()), high scores persisted
+ * in Config, and a random generator reseeded per game so a game replays
+ * the same from the same seed and inputs.
+ *
+ * Adding a game: a GameX.cpp defining a Game, and one line in the
+ * registry in Game.cpp. The sketch's menu, loop() and touch handling
+ * only go through the registry.
+ */
+
+#ifndef GAME_H
+#define GAME_H
+
+#include <stdint.h>
+#include "GameLoop.h"
+#include "DEV_Config.h"
+
+#define GAME_ARENA_BYTES  1024
+#define GAME_MAX          8          // high score slots
+#define GAME_TUNED_HZ     20         // older games' speeds are per 50 ms step
+
+struct Game {
+  const char *name;                                      // menu and energy profile
+  GameTiming timing;
+  uint16_t state_size;
+  void (*init)(void *state);                             // new game, arena zeroed
+  void (*update)(void *state);                           // one fixed step
+  void (*render)(void *state, uint8_t alpha);            // draw and present
+  void (*input)(void *state, uint16_t x, uint16_t y);    // touch while playing
+  void (*save)(void *state);                             // leaving mid-game; may be null
+};
+
+// ---------- Registry ----------
+uint8_t game_count();
+const Game *game_get(uint8_t index);
+
+// ---------- Running game ----------
+void game_framework_init(UWORD *framebuffer);
+
+// Start game index from scratch (leaves the current one first). The game
+// clock starts on the next game_run(), so the caller never owes it steps
+bool game_start(uint8_t index, uint32_t seed);
+// Leave the current game: save() runs and a score so far still counts
+void game_stop();
+int8_t game_current();                                   // -1 when none
+
+// From loop() and the touch handler
+void game_run(uint32_t now_us);
+void game_touch(uint16_t x, uint16_t y);
+
+uint32_t game_arena_peak();                              // largest state_size registered
+
+// ---------- Services for games ----------
+UWORD *game_framebuffer();
+
+void game_add_score(int points);
+int  game_score();
+void game_over();                                        // records the high score
+bool game_is_over();
+int  game_high_score(uint8_t index);
+int  game_high_score();                                  // of the current game
+
+// High scores from/to Config (CFG_KEY_HIGH_SCORES, one int per registry slot)
+void game_load_high_scores();
+
+// Per-game LCG, reseeded by game_start()
+long game_random(long max_val);
+long game_random(long min_val, long max_val);
+
+// Position between the previous step and this one for a render alpha
+static inline float game_lerp(float prev, float cur, uint8_t alpha) {
+  return prev + (cur - prev) * alpha / 256.0f;
+}
+
+// As game_lerp(), but a jump (screen wrap) is drawn where it landed
+static inline float game_lerp_wrap(float prev, float cur, uint8_t alpha) {
+  float d = cur - prev;
+  return (d > 40.0f || d < -40.0f) ? cur : game_lerp(prev, cur, alpha);
+}
+
+#endif // GAME_H
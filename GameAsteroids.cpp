@@ -0,0 +1,288 @@
+/*
+ * GameAsteroids.cpp - Asteroids: rotate, fire, split the rocks
+ */
+
+#include "Game.h"
+#include "AMOLED_1in8.h"
+#include "GUI_Paint.h"
+#include "fonts.h"
+#include <math.h>
+
+#define ASTEROIDS_HZ   30
+#define MAX_BULLETS    5
+#define MAX_ASTEROIDS  15
+
+// Speeds are per 50 ms; each step moves by that scaled to its length
+static const float STEP_K = (float)GAME_TUNED_HZ / ASTEROIDS_HZ;
+static const float DRAG = powf(0.98f, STEP_K);     // ship drag per step
+
+struct Ship {
+  float x, y, angle, dx, dy;
+  float px, py;              // position at the previous step, for interpolation
+  bool alive;
+};
+
+struct Bullet {
+  float x, y, dx, dy;
+  float px, py;
+  bool active;
+  uint32_t fired_time;       // game_loop_time_ms()
+};
+
+struct Asteroid {
+  float x, y, dx, dy, angle, spin;
+  float px, py, pangle;
+  int size;
+  bool active;
+};
+
+struct AsteroidsState {
+  Ship ship;
+  Bullet bullets[MAX_BULLETS];
+  Asteroid asteroids[MAX_ASTEROIDS];
+  int level;
+};
+static_assert(sizeof(AsteroidsState) <= GAME_ARENA_BYTES, "Asteroids state does not fit the game arena");
+
+static int rock_radius(const Asteroid &a) {
+  return (a.size == 2) ? 20 : (a.size == 1) ? 12 : 6;
+}
+
+// Ship in the middle, 3 + level rocks (at most 10)
+static void start_level(AsteroidsState &g) {
+  Ship &ship = g.ship;
+  ship.x = ship.px = 184.0f;
+  ship.y = ship.py = 260.0f;
+  ship.angle = -90.0f;
+  ship.dx = 0.0f;
+  ship.dy = 0.0f;
+  ship.alive = true;
+
+  for (int i = 0; i < MAX_BULLETS; i++) g.bullets[i].active = false;
+  for (int i = 0; i < MAX_ASTEROIDS; i++) g.asteroids[i].active = false;
+
+  int num_asteroids = min(3 + g.level, 10);
+  for (int i = 0; i < num_asteroids; i++) {
+    Asteroid &a = g.asteroids[i];
+    a.active = true;
+    a.size = 2;
+    a.x = a.px = game_random(50, 318);
+    a.y = a.py = game_random(50, 430);
+    a.dx = (game_random(0, 100) / 50.0f) - 1.0f;
+    a.dy = (game_random(0, 100) / 50.0f) - 1.0f;
+    a.angle = a.pangle = game_random(0, 360);
+    a.spin = (game_random(0, 100) / 100.0f) - 0.5f;
+  }
+}
+
+static void asteroids_init(void *state) {
+  AsteroidsState &g = *(AsteroidsState *)state;
+  g.level = 1;
+  start_level(g);
+}
+
+static void wrap(float &x, float &y) {
+  if (x < 0) x = AMOLED_1IN8_WIDTH;
+  if (x > AMOLED_1IN8_WIDTH) x = 0;
+  if (y < 0) y = AMOLED_1IN8_HEIGHT;
+  if (y > AMOLED_1IN8_HEIGHT) y = 0;
+}
+
+static void asteroids_update(void *state) {
+  AsteroidsState &g = *(AsteroidsState *)state;
+  Ship &ship = g.ship;
+  if (!ship.alive) return;
+
+  // All rocks destroyed: next level
+  bool any_active = false;
+  for (int i = 0; i < MAX_ASTEROIDS; i++) {
+    if (g.asteroids[i].active) {
+      any_active = true;
+      break;
+    }
+  }
+  if (!any_active) {
+    g.level++;
+    start_level(g);
+    return;
+  }
+
+  // Ship physics with simple drag
+  ship.px = ship.x;
+  ship.py = ship.y;
+  ship.dx *= DRAG;
+  ship.dy *= DRAG;
+  ship.x += ship.dx * STEP_K;
+  ship.y += ship.dy * STEP_K;
+  wrap(ship.x, ship.y);
+
+  for (int i = 0; i < MAX_BULLETS; i++) {
+    Bullet &b = g.bullets[i];
+    if (!b.active) continue;
+    b.px = b.x;
+    b.py = b.y;
+    b.x += b.dx * STEP_K;
+    b.y += b.dy * STEP_K;
+
+    // Off screen or too old
+    if (b.x < 0 || b.x > AMOLED_1IN8_WIDTH || b.y < 0 || b.y > AMOLED_1IN8_HEIGHT ||
+        game_loop_time_ms() - b.fired_time > 2000) {
+      b.active = false;
+    }
+  }
+
+  for (int i = 0; i < MAX_ASTEROIDS; i++) {
+    Asteroid &a = g.asteroids[i];
+    if (!a.active) continue;
+    a.px = a.x;
+    a.py = a.y;
+    a.pangle = a.angle;
+    a.x += a.dx * STEP_K;
+    a.y += a.dy * STEP_K;
+    a.angle += a.spin * STEP_K;
+    wrap(a.x, a.y);
+  }
+
+  // Bullet hits: small rocks vanish, others split in two
+  for (int b = 0; b < MAX_BULLETS; b++) {
+    if (!g.bullets[b].active) continue;
+    for (int a = 0; a < MAX_ASTEROIDS; a++) {
+      Asteroid &rock = g.asteroids[a];
+      if (!rock.active) continue;
+      float dx = g.bullets[b].x - rock.x;
+      float dy = g.bullets[b].y - rock.y;
+      if (sqrtf(dx * dx + dy * dy) >= rock_radius(rock)) continue;
+
+      g.bullets[b].active = false;
+      int old_size = rock.size;
+      float old_x = rock.x;
+      float old_y = rock.y;
+      rock.active = false;
+      game_add_score((old_size + 1) * 10);
+
+      if (old_size > 0) {
+        int split_count = 0;
+        for (int i = 0; i < MAX_ASTEROIDS && split_count < 2; i++) {
+          Asteroid &piece = g.asteroids[i];
+          if (piece.active) continue;
+          piece = rock;
+          piece.size = old_size - 1;
+          piece.x = piece.px = old_x + game_random(-10, 10);
+          piece.y = piece.py = old_y + game_random(-10, 10);
+          piece.dx = -rock.dx + (game_random(100) / 100.0f);
+          piece.dy = -rock.dy + (game_random(100) / 100.0f);
+          piece.active = true;
+          split_count++;
+        }
+      }
+      break;
+    }
+  }
+
+  // Ship hits
+  for (int a = 0; a < MAX_ASTEROIDS; a++) {
+    const Asteroid &rock = g.asteroids[a];
+    if (!rock.active) continue;
+    float dx = ship.x - rock.x;
+    float dy = ship.y - rock.y;
+    if (sqrtf(dx * dx + dy * dy) < rock_radius(rock) + 10) {
+      ship.alive = false;
+      game_over();
+      break;
+    }
+  }
+}
+
+static void asteroids_render(void *state, uint8_t alpha) {
+  const AsteroidsState &g = *(const AsteroidsState *)state;
+  const Ship &ship = g.ship;
+  Paint_Clear(BLACK);
+
+  if (ship.alive) {
+    float rad = ship.angle * 3.14159f / 180.0f;
+    float sx = game_lerp_wrap(ship.px, ship.x, alpha);
+    float sy = game_lerp_wrap(ship.py, ship.y, alpha);
+    int x1 = sx + 10 * cos(rad);
+    int y1 = sy + 10 * sin(rad);
+    int x2 = sx + 6 * cos(rad + 2.5f);
+    int y2 = sy + 6 * sin(rad + 2.5f);
+    int x3 = sx + 6 * cos(rad - 2.5f);
+    int y3 = sy + 6 * sin(rad - 2.5f);
+
+    Paint_DrawLine(x1, y1, x2, y2, WHITE, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+    Paint_DrawLine(x2, y2, x3, y3, WHITE, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+    Paint_DrawLine(x3, y3, x1, y1, WHITE, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+  }
+
+  for (int i = 0; i < MAX_BULLETS; i++) {
+    const Bullet &b = g.bullets[i];
+    if (!b.active) continue;
+    Paint_DrawCircle(game_lerp_wrap(b.px, b.x, alpha), game_lerp_wrap(b.py, b.y, alpha),
+                     2, 0xFFE0, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+  }
+
+  // Rocks as jagged 8-gons, the same shape every frame
+  for (int i = 0; i < MAX_ASTEROIDS; i++) {
+    const Asteroid &a = g.asteroids[i];
+    if (!a.active) continue;
+    int base_r = rock_radius(a);
+    int vertices_x[8], vertices_y[8];
+    float ax = game_lerp_wrap(a.px, a.x, alpha);
+    float ay = game_lerp_wrap(a.py, a.y, alpha);
+    float aangle = game_lerp(a.pangle, a.angle, alpha);
+
+    for (int j = 0; j < 8; j++) {
+      float angle = (aangle + j * 45) * 3.14159f / 180.0f;
+      int variation = (i * 7 + j * 3) % 30;          // 70-100% of the radius
+      float r = base_r * (0.7f + variation / 100.0f);
+      vertices_x[j] = ax + r * cos(angle);
+      vertices_y[j] = ay + r * sin(angle);
+    }
+    for (int j = 0; j < 8; j++) {
+      int next = (j + 1) % 8;
+      Paint_DrawLine(vertices_x[j], vertices_y[j], vertices_x[next], vertices_y[next],
+                     WHITE, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+    }
+  }
+
+  char score_str[32];
+  snprintf(score_str, sizeof(score_str), "Score:%d Lvl:%d", game_score(), g.level);
+  Paint_DrawString_EN(5, 5, score_str, &Font12, WHITE, BLACK);
+
+  AMOLED_1IN8_Display(game_framebuffer());
+}
+
+// Left third rotates left, right third rotates right, the middle fires
+static void asteroids_input(void *state, uint16_t x, uint16_t y) {
+  AsteroidsState &g = *(AsteroidsState *)state;
+  Ship &ship = g.ship;
+  if (x < AMOLED_1IN8_WIDTH / 3) {
+    ship.angle -= 15;
+  } else if (x > (AMOLED_1IN8_WIDTH * 2) / 3) {
+    ship.angle += 15;
+  } else {
+    for (int i = 0; i < MAX_BULLETS; i++) {
+      Bullet &b = g.bullets[i];
+      if (b.active) continue;
+      float rad = ship.angle * 3.14159f / 180.0f;
+      b.active = true;
+      b.x = b.px = ship.x;
+      b.y = b.py = ship.y;
+      b.dx = 5.0f * cos(rad);
+      b.dy = 5.0f * sin(rad);
+      b.fired_time = game_loop_time_ms();
+      break;
+    }
+  }
+}
+
+extern const Game GAME_ASTEROIDS = {
+  "Asteroids",
+  { ASTEROIDS_HZ, 30, 4, 2 },
+  sizeof(AsteroidsState),
+  asteroids_init,
+  asteroids_update,
+  asteroids_render,
+  asteroids_input,
+  nullptr,
+};
@@ -3,24 +3,189 @@
  */
 
 #include "GameAudio.h"
+#include "GameAudioScripts.h"
 #include "DEV_Config.h"
 #include "audio_pio.h"
+#include "AudioOut.h"
+#include "AudioIn.h"
+#include "Synth.h"
+#include "Sfx.h"
+#include "Tracker.h"
+#include "Mixer.h"
+#include "SamplePlayer.h"
+#include "AssetPack.h"
 #include "es8311.h"
+#include "ClockGovernor.h"
 #include "hardware/pio.h"
+#include "hardware/sync.h"
+#include <math.h>
 
 // Audio state
 static bool audio_initialized = false;
 static bool audio_muted = false;
 static int current_volume = 70;
+static int codec_volume = -1;                 // level last written to the ES8311
+static uint8_t channel_volume[AUDIO_CHANNELS] = { 100, 100, 100, 100 };
 
-// Alarm state
-struct AlarmState {
-  uint8_t hour;
-  uint8_t minute;
-  bool enabled;
-  bool ringing;
-  uint32_t ring_start_time;
-} alarm_state = {7, 0, false, false, 0};
+// The codec holds a coarse range, one step per CODEC_STEP of the 0-100
+// scale; the mixer master covers the rest. ES8311 units are 1.28 dB.
+#define CODEC_STEP       20
+#define CODEC_DB_PER_UNIT 1.28f
+
+static_assert(AUDIO_CHANNELS == MIXER_CHANNELS, "one mixer channel per AudioChannel");
+
+// Rate switches: MCLK is always 256 fs, which es8311.cpp has a row for at each of these
+static const uint32_t SAMPLE_RATES[] = { 8000, 16000, 24000, 32000, 48000 };
+#define RATE_FADE_MS     15            // master fade before the clocks move
+#define RATE_DRAIN_MS    100           // give up if the output has not stopped by then
+static uint32_t rate_switches = 0;
+
+// ---------- Note queue (rendered by the AudioOut source callback) ----------
+
+#define NOTE_QUEUE_LEN   32            // power of two
+#define TONE_VOLUME      16000         // Q15, the level the old blocking tones played at
+
+struct QueuedNote {
+  uint32_t at;                         // sample clock at which to start
+  SynthNote note;
+};
+
+static QueuedNote note_queue[NOTE_QUEUE_LEN];
+static volatile uint8_t note_head = 0;      // written by loop()
+static volatile uint8_t note_tail = 0;      // written by the DMA IRQ
+static volatile uint32_t sample_clock = 0;  // samples rendered, advanced by the IRQ
+static uint32_t queue_end = 0;              // where the next sequential note starts
+
+// Synth cost, measured around every render
+static volatile uint32_t synth_cycles = 0;
+static volatile uint32_t synth_samples = 0;
+static volatile uint32_t synth_peak = 0;    // cycles per sample, worst block
+
+// Trigger-to-first-sample latency of sound effects
+static volatile uint32_t sfx_trigger_us = 0;  // when the pending trigger was made, 0 = none
+static uint32_t sfx_latency_max_us = 0;
+static uint64_t sfx_latency_sum_us = 0;
+static uint32_t sfx_latency_count = 0;
+
+static_assert(sizeof(SFX_SCRIPTS) / sizeof(SFX_SCRIPTS[0]) == SFX_NOTIFICATION + 1, "one script per SoundEffect");
+
+// Append a note after everything already queued
+static void note_push(SynthWave wave, int frequency_hz, int end_hz, int duration_ms, const SynthEnvelope &env,
+                      uint8_t bus) {
+  if (duration_ms <= 0) return;
+  uint32_t now = sample_clock;
+  if ((int32_t)(queue_end - now) < 0) queue_end = now;
+  uint32_t start = queue_end;
+  queue_end += pico_audio.sample_freq * (uint32_t)duration_ms / 1000;
+  if (frequency_hz <= 0) return;                               // rest
+
+  uint8_t head = note_head;
+  if ((uint8_t)(head - note_tail) >= NOTE_QUEUE_LEN) return;   // full: drop
+  QueuedNote &q = note_queue[head % NOTE_QUEUE_LEN];
+  q.at = start;
+  q.note.wave = wave;
+  q.note.freq_hz = frequency_hz;
+  q.note.end_freq_hz = end_hz;
+  q.note.gate_ms = duration_ms;
+  q.note.volume = TONE_VOLUME;
+  q.note.env = env;
+  q.note.bus = bus;
+  __compiler_memory_barrier();
+  note_head = head + 1;
+}
+
+static void tone_push(int frequency_hz, int duration_ms, uint8_t bus) {
+  note_push(WAVE_SINE, frequency_hz, 0, duration_ms, SYNTH_ENV_ORGAN, bus);
+}
+
+// Mixer render callback: the synth voices and clips of one channel
+static bool render_channel(uint8_t channel, int16_t *buf, uint32_t frames) {
+  bool sound = synth_render_bus(buf, frames, channel);
+  if (!sound) memset(buf, 0, frames * sizeof(int16_t));
+  if (sample_player_mix(buf, frames, channel)) sound = true;
+  return sound;
+}
+
+// AudioOut source: starts queued notes on time, runs the sequencers and renders the synth
+static bool synth_source(int16_t *out, uint32_t frames) {
+  uint32_t t0 = rp2040.getCycleCount();
+  uint32_t clock = sample_clock;
+  bool sound = false;
+
+  for (uint32_t done = 0; done < frames;) {
+    uint32_t now = clock + done;
+    while (note_tail != note_head && (int32_t)(note_queue[note_tail % NOTE_QUEUE_LEN].at - now) <= 0) {
+      synth_note_on(note_queue[note_tail % NOTE_QUEUE_LEN].note);
+      note_tail = note_tail + 1;
+    }
+    // Render up to the next note, script step or music tick so it lands on its sample
+    uint32_t n = frames - done;
+    uint32_t step = sfx_service(now);
+    if (step < n) n = step;
+    if (sfx_trigger_us) {
+      // Started at this sample, heard once the blocks ahead of this one have played
+      uint32_t ahead = audio_out_render_delay() + done;
+      uint32_t us = time_us_32() - sfx_trigger_us + (uint32_t)((uint64_t)ahead * 1000000 / pico_audio.sample_freq);
+      if (us > sfx_latency_max_us) sfx_latency_max_us = us;
+      sfx_latency_sum_us += us;
+      sfx_latency_count++;
+      sfx_trigger_us = 0;
+    }
+    step = tracker_service(now);
+    if (step < n) n = step;
+    if (note_tail != note_head) {
+      uint32_t until = note_queue[note_tail % NOTE_QUEUE_LEN].at - now;
+      if (until < n) n = until;
+    }
+    if (mixer_mix(out + done, n, render_channel)) sound = true;
+    done += n;
+  }
+  sample_clock = clock + frames;
+
+  uint32_t cycles = rp2040.getCycleCount() - t0;
+  synth_cycles += cycles;
+  synth_samples += frames;
+  if (cycles / frames > synth_peak) synth_peak = cycles / frames;
+
+  // Pending notes and scripts keep the engine running through rests
+  return sound || note_tail != note_head || sfx_busy() || sample_player_active() || tracker_playing();
+}
+
+// Master volume: software gain within the codec's current range. The range
+// is moved (one I2C write) only when idle, so a step can never be heard;
+// until then the software gain stays capped at unity.
+static int codec_level(int volume) {
+  return volume == 0 ? CODEC_STEP : (volume + CODEC_STEP - 1) / CODEC_STEP * CODEC_STEP;
+}
+
+static void apply_volume(bool idle) {
+  int level = codec_level(current_volume);
+  if (level != codec_volume && idle) {
+    es8311_voice_volume_set(level);
+    codec_volume = level;
+  }
+  int below = codec_volume - current_volume;
+  uint16_t gain = 0;
+  if (current_volume > 0) {
+    gain = below <= 0 ? MIXER_UNITY : (uint16_t)(MIXER_UNITY * powf(10.0f, -below * CODEC_DB_PER_UNIT / 20));
+  }
+  mixer_set_master(audio_muted ? 0 : gain, idle ? 0 : MIXER_RAMP_MS);
+}
+
+// Move the codec to the level current_volume wants, only while the output
+// is silent (so free of fades)
+static void sync_codec_level() {
+  if (audio_out_active()) return;
+  if (codec_volume != codec_level(current_volume)) apply_volume(true);
+}
+
+// Before starting a sound: move to the workload's rate and catch the codec
+// range up, both only while the output is silent
+static void sync_output(uint32_t rate) {
+  if (audio_out_active()) return;
+  audio_set_sample_rate(rate);
+  sync_codec_level();
+}
 
 // Initialize the ES8311 audio codec
 bool audio_init() {
@@ -29,9 +194,9 @@ bool audio_init() {
   // Initialize hardware
   DEV_Module_Init();
   
-  // Set audio parameters (6.144 MHz MCLK, 24kHz sample rate - the working config!)
-  pico_audio.mclk_freq = 24000 * 256;  // 6.144 MHz
-  pico_audio.sample_freq = 24000;
+  // Start at the UI rate; MCLK = 256 fs (4.096 MHz at 16 kHz)
+  pico_audio.mclk_freq = AUDIO_RATE_UI * 256;
+  pico_audio.sample_freq = AUDIO_RATE_UI;
   
   // Initialize clocks
   mclk_pio_init();
@@ -51,8 +216,10 @@ bool audio_init() {
   es8311_microphone_config();
   delay(50);
   
-  // Set volume
-  es8311_voice_volume_set(current_volume);
+  // Set volume: codec range now, the rest in the mixer
+  mixer_init(pico_audio.sample_freq);
+  mixer_set_duck(AUDIO_CH_MUSIC, DUCK_SOURCES, DUCK_DEPTH, DUCK_ATTACK_MS, DUCK_HOLD_MS, DUCK_RELEASE_MS);
+  apply_volume(true);
   delay(50);
   
   // Unmute
@@ -63,116 +230,153 @@ bool audio_init() {
   es8311_microphone_gain_set(ES8311_MIC_GAIN_18DB);
   delay(50);
   
-  // Initialize I2S output
+  // Initialize I2S output, fed by DMA from the synth
   dout_pio_init();
+  synth_init(pico_audio.sample_freq);
+  sfx_init(SFX_SCRIPTS, sizeof(SFX_SCRIPTS) / sizeof(SFX_SCRIPTS[0]), pico_audio.sample_freq);
+  tracker_init(pico_audio.sample_freq, AUDIO_CH_MUSIC);
+  sample_player_init(pico_audio.sample_freq);
+  audio_out_init();
+  audio_out_set_source(synth_source);
+  audio_in_init(pico_audio.sample_freq);
   delay(100);
   
   audio_initialized = true;
   return true;
 }
 
-// Play a single tone
-void audio_play_tone(int frequency_hz, int duration_ms) {
+// Queue a single tone; returns immediately
+void audio_play_tone(int frequency_hz, int duration_ms, AudioChannel channel) {
   if (!audio_initialized || audio_muted) return;
-  
-  const int sample_rate = 24000;
-  int total_samples = (sample_rate * duration_ms) / 1000;
-  
-  for (int i = 0; i < total_samples; i++) {
-    float t = (float)i / sample_rate;
-    int16_t sample = (int16_t)(sin(2.0f * PI * frequency_hz * t) * 16000.0f);
-    
-    // Stereo: left and right channels
-    int32_t stereo_sample = (int32_t)sample * 65536 + sample;
-    
-    pio_sm_put_blocking(pico_audio.pio_2, pico_audio.sm_dout, stereo_sample);
-  }
+  sync_output(AUDIO_RATE_UI);
+  tone_push(frequency_hz, duration_ms, channel);
+  audio_out_kick();
 }
 
-// Play a sound effect
+// Hand the effect to the sequencer; returns immediately
 void audio_play_sfx(SoundEffect sfx) {
   if (!audio_initialized || audio_muted) return;
-  
-  switch (sfx) {
-    case SFX_BEEP:
-      audio_play_tone(800, 50);
-      break;
-      
-    case SFX_SELECT:
-      audio_play_tone(1200, 50);
-      delay(20);
-      audio_play_tone(1500, 50);
-      break;
-      
-    case SFX_BACK:
-      audio_play_tone(1000, 50);
-      delay(20);
-      audio_play_tone(600, 50);
-      break;
-      
-    case SFX_ERROR:
-      audio_play_tone(200, 150);
-      break;
-      
-    case SFX_COIN:
-      audio_play_tone(1000, 50);
-      delay(20);
-      audio_play_tone(1500, 50);
-      delay(20);
-      audio_play_tone(2000, 100);
-      break;
-      
-    case SFX_JUMP:
-      for (int f = 400; f < 800; f += 50) {
-        audio_play_tone(f, 10);
-      }
-      break;
-      
-    case SFX_SHOOT:
-      for (int f = 1500; f > 500; f -= 100) {
-        audio_play_tone(f, 15);
-      }
-      break;
-      
-    case SFX_EXPLODE:
-      for (int i = 0; i < 3; i++) {
-        audio_play_tone(100 + (i * 50), 50);
-        delay(20);
-      }
-      break;
-      
-    case SFX_GAME_OVER:
-      audio_play_tone(800, 150);
-      delay(50);
-      audio_play_tone(600, 150);
-      delay(50);
-      audio_play_tone(400, 300);
-      break;
-      
-    case SFX_LEVEL_UP: {
-      int notes[] = {523, 659, 784, 1047};  // C5, E5, G5, C6
-      for (int i = 0; i < 4; i++) {
-        audio_play_tone(notes[i], 100);
-        delay(50);
-      }
-      break;
-    }
-      
-    case SFX_ALARM:
-      // Alternating high-low beeps
-      for (int i = 0; i < 3; i++) {
-        audio_play_tone(1200, 200);
-        delay(100);
-        audio_play_tone(800, 200);
-        delay(100);
-      }
-      break;
-      
-    case SFX_NOTIFICATION:
-      audio_play_tone(1000, 100);
-      delay(50);
-      audio_play_tone(1200, 100);
-      break;
+  sync_output(AUDIO_RATE_UI);
+  uint32_t irq = save_and_disable_interrupts();
+  if (sfx_trigger(sfx) && !sfx_trigger_us) sfx_trigger_us = time_us_32() | 1;
+  restore_interrupts(irq);
+  audio_out_kick();
+}
+
+// Stream a PCM16 or ADPCM clip from the asset pack; returns immediately
+bool audio_play_clip(uint32_t asset_hash, uint16_t volume, AudioChannel channel) {
+  if (!audio_initialized || audio_muted) return false;
+  Asset a;
+  if (!asset_find(asset_hash, &a)) return false;
+  sync_output(AUDIO_RATE_UI);
+  uint32_t irq = save_and_disable_interrupts();
+  int8_t voice = sample_player_start(a.data, a.size, a.format, a.param, volume, channel);
+  restore_interrupts(irq);
+  if (voice < 0) return false;
+  audio_out_kick();
+  return true;
+}
+
+// Songs are validated here, in loop(); the player then runs from the refill IRQ
+bool audio_play_music(const uint8_t *song, uint32_t size, bool loop) {
+  if (!audio_initialized || audio_muted) return false;
+  if (!tracker_validate(song, size, nullptr)) return false;
+  audio_set_sample_rate(AUDIO_RATE_MUSIC);     // fades out whatever was playing if it must switch
+  sync_codec_level();
+  if (!tracker_play(song, size, loop)) return false;
+  audio_out_kick();
+  return true;
+}
+
+bool audio_play_music(uint32_t asset_hash, bool loop) {
+  Asset a;
+  if (!asset_find(asset_hash, &a) || a.format != ASSET_SONG) return false;
+  return audio_play_music(a.data, a.size, loop);
+}
+
+// Voices are released, so the last notes fade out
+void audio_stop_music() {
+  tracker_stop();
+}
+
+bool audio_music_playing() {
+  return tracker_playing();
+}
+
+// Drop queued tones; the current DMA block still plays out
+void audio_stop() {
+  uint32_t irq = save_and_disable_interrupts();
+  note_tail = note_head;
+  queue_end = sample_clock;
+  tracker_stop();
+  sfx_cancel_all();
+  synth_release_all();
+  sample_player_stop_all();
+  restore_interrupts(irq);
+}
+
+bool audio_is_playing() {
+  return note_tail != note_head || sfx_busy() || synth_active_voices() > 0 || sample_player_active() > 0 ||
+         tracker_playing();
+}
+
+void audio_get_stats(AudioStats *out, bool reset) {
+  AudioOutStats o;
+  audio_out_stats(&o, reset);
+  uint32_t block_cycles = (uint32_t)((uint64_t)clock_get_hz(clk_sys) * AUDIO_OUT_BLOCK_FRAMES / pico_audio.sample_freq);
+  uint32_t us_per_block = AUDIO_OUT_BLOCK_FRAMES * 1000000 / pico_audio.sample_freq;
+  out->blocks = o.blocks;
+  out->underruns = o.underruns;
+  out->late_refills = o.late_refills;
+  out->refill_avg_pm = (uint16_t)((uint64_t)o.refill_cycles_avg * 1000 / block_cycles);
+  out->refill_peak_pm = (uint16_t)((uint64_t)o.refill_cycles_max * 1000 / block_cycles);
+  out->irq_latency_us = o.irq_latency_max * us_per_block / AUDIO_OUT_BLOCK_FRAMES;
+  out->headroom_us = o.headroom_min * us_per_block / AUDIO_OUT_BLOCK_FRAMES;
+
+  uint32_t irq = save_and_disable_interrupts();
+  out->sfx_triggers = sfx_latency_count;
+  out->sfx_latency_avg_us = sfx_latency_count ? (uint32_t)(sfx_latency_sum_us / sfx_latency_count) : 0;
+  out->sfx_latency_max_us = sfx_latency_max_us;
+  if (reset) {
+    sfx_latency_count = 0;
+    sfx_latency_sum_us = 0;
+    sfx_latency_max_us = 0;
+  }
+  restore_interrupts(irq);
+}
+
+void audio_print_stats(Print &out) {
+  uint32_t irq = save_and_disable_interrupts();
+  uint32_t cycles = synth_cycles, samples = synth_samples, peak = synth_peak;
+  synth_cycles = synth_samples = synth_peak = 0;
+  restore_interrupts(irq);
+
+  uint32_t avg = samples ? cycles / samples : 0;
+  char line[112];
+  snprintf(line, sizeof(line), "Synth: %u voices, %lu cycles/sample avg, %lu peak (%lu.%lu%% of a core at %lu Hz)",
+           synth_active_voices(), (unsigned long)avg, (unsigned long)peak,
+           (unsigned long)(peak * pico_audio.sample_freq / (clock_get_hz(clk_sys) / 1000)) / 10,
+           (unsigned long)(peak * pico_audio.sample_freq / (clock_get_hz(clk_sys) / 1000)) % 10,
+           (unsigned long)pico_audio.sample_freq);
+  out.println(line);
+
+  AudioStats st;
+  audio_get_stats(&st);
+  snprintf(line, sizeof(line), "Output: %lu blocks, %lu underruns, %lu late refills, %lu rate switches",
+           (unsigned long)st.blocks, (unsigned long)st.underruns, (unsigned long)st.late_refills,
+           (unsigned long)rate_switches);
+  out.println(line);
+  if (st.blocks) {
+    snprintf(line, sizeof(line), "Refill: %u.%u%% of a block avg, %u.%u%% peak; IRQ latency %lu us, headroom %lu us",
+             st.refill_avg_pm / 10, st.refill_avg_pm % 10, st.refill_peak_pm / 10, st.refill_peak_pm % 10,
+             (unsigned long)st.irq_latency_us, (unsigned long)st.headroom_us);
+    out.println(line);
+  }
+  if (st.sfx_triggers) {
+    snprintf(line, sizeof(line), "SFX latency: %lu us avg, %lu us max over %lu triggers",
+             (unsigned long)st.sfx_latency_avg_us, (unsigned long)st.sfx_latency_max_us,
+             (unsigned long)st.sfx_triggers);
+    out.println(line);
   }
 }
 
@@ -183,68 +387,116 @@ void audio_set_volume(int volume) {
   current_volume = volume;
   
   if (audio_initialized) {
-    es8311_voice_volume_set(volume);
+    apply_volume(!audio_out_active());
   }
 }
 
-// Mute/unmute
+// Mute/unmute: a fade on the mixer master, the codec is left alone
 void audio_mute(bool mute) {
   audio_muted = mute;
   if (audio_initialized) {
-    es8311_voice_mute(mute);
+    apply_volume(false);
   }
 }
 
+// Per-channel volume, squared for a roughly even loudness scale
+void audio_set_channel_volume(AudioChannel channel, int volume) {
+  if (channel >= AUDIO_CHANNELS) return;
+  if (volume < 0) volume = 0;
+  if (volume > 100) volume = 100;
+  channel_volume[channel] = volume;
+  mixer_set_gain(channel, (uint16_t)(MIXER_UNITY * volume * volume / 10000));
+}
+
+int audio_channel_volume(AudioChannel channel) {
+  return channel < AUDIO_CHANNELS ? channel_volume[channel] : 0;
+}
+
 // Check if audio is ready
 bool audio_is_ready() {
   return audio_initialized;
 }
 
-// ========== ALARM FUNCTIONS ==========
+// ---------- Sample rate ----------
 
-void alarm_set(uint8_t hour, uint8_t minute, bool enabled) {
-  alarm_state.hour = hour;
-  alarm_state.minute = minute;
-  alarm_state.enabled = enabled;
-  alarm_state.ringing = false;
+// Fade the master out, drop everything and wait for the DMA engine to stop
+static bool fade_and_drain() {
+  if (!audio_out_active()) return true;
+  mixer_set_master(0, RATE_FADE_MS);
+  delay(RATE_FADE_MS + 1);
+  audio_stop();
+  uint32_t irq = save_and_disable_interrupts();
+  synth_stop_all();                            // no release tails: the master is already down
+  restore_interrupts(irq);
+  uint32_t t0 = millis();
+  while (audio_out_active() && millis() - t0 < RATE_DRAIN_MS) delay(1);
+  return !audio_out_active();
 }
 
-void alarm_check_and_play() {
-  if (!alarm_state.enabled || !audio_initialized) return;
-  
-  // Get current time from your RTC (you'll need to implement this based on your RTC)
-  // For now, this is a placeholder - you need to add your actual time reading code
-  // Example: uint8_t current_hour = rtc.getHour();
-  //          uint8_t current_minute = rtc.getMinute();
-  
-  // Placeholder - replace with actual time from your RTC
-  static uint8_t current_hour = 0;
-  static uint8_t current_minute = 0;
-  
-  // Check if it's alarm time
-  if (current_hour == alarm_state.hour && current_minute == alarm_state.minute) {
-    if (!alarm_state.ringing) {
-      alarm_state.ringing = true;
-      alarm_state.ring_start_time = millis();
-    }
+bool audio_set_sample_rate(uint32_t hz) {
+  if (!audio_initialized) return false;
+  if (hz == pico_audio.sample_freq) return true;
+  bool supported = false;
+  for (uint32_t r : SAMPLE_RATES) supported |= r == hz;
+  if (!supported || audio_in_active()) return false;   // capture shares the codec clocks
+
+  if (!fade_and_drain()) {
+    apply_volume(false);
+    return false;
   }
-  
-  // Play alarm sound if ringing
-  if (alarm_state.ringing) {
-    // Ring for up to 1 minute or until stopped
-    if (millis() - alarm_state.ring_start_time < 60000) {
-      audio_play_sfx(SFX_ALARM);
-      delay(1000);  // Wait 1 second between alarm cycles
-    } else {
-      alarm_state.ringing = false;  // Auto-stop after 1 minute
-    }
+  audio_out_poll();                            // drop the engine's governor lock
+
+  // Muted from here until the codec is reprogrammed: moving the governor
+  // floor can retune MCLK (audio_refresh_clocks) while the ES8311 is still
+  // set up for the old ratio, and it must not play through that
+  es8311_voice_mute(true);
+
+  // Floor first, so clk_sys can always divide down to the new MCLK
+  uint32_t old_rate = pico_audio.sample_freq;
+  pico_audio.sample_freq = hz;
+  pico_audio.mclk_freq = hz * 256;
+  clock_governor_set_min_khz(audio_min_sys_khz());
+  if (clock_get_hz(clk_sys) / 1000 < audio_min_sys_khz()) {
+    pico_audio.sample_freq = old_rate;
+    pico_audio.mclk_freq = old_rate * 256;
+    clock_governor_set_min_khz(audio_min_sys_khz());
+    set_mclk_frequency(pico_audio.mclk_freq);
+    es8311_voice_mute(false);
+    apply_volume(true);
+    return false;
   }
+
+  set_mclk_frequency(pico_audio.mclk_freq);
+  es8311_sample_frequency_config(pico_audio.mclk_freq, hz);
+  es8311_voice_mute(false);
+
+  // Everything is idle after the drain, so re-initialising only changes the rate
+  synth_init(hz);
+  sfx_init(SFX_SCRIPTS, sizeof(SFX_SCRIPTS) / sizeof(SFX_SCRIPTS[0]), hz);
+  tracker_init(hz, AUDIO_CH_MUSIC);
+  sample_player_init(hz);
+  mixer_init(hz);
+  for (uint8_t c = 0; c < AUDIO_CHANNELS; c++) {
+    mixer_set_gain(c, (uint16_t)(MIXER_UNITY * channel_volume[c] * channel_volume[c] / 10000), 0);
+  }
+  audio_in_set_sample_rate(hz);
+  queue_end = sample_clock;
+  apply_volume(true);
+  rate_switches++;
+  return true;
 }
 
-bool alarm_is_ringing() {
-  return alarm_state.ringing;
+uint32_t audio_sample_rate() {
+  return pico_audio.sample_freq;
+}
+
+// Recompute the MCLK divider against the current clk_sys
+void audio_refresh_clocks() {
+  if (!audio_initialized) return;
+  set_mclk_frequency(pico_audio.mclk_freq);
 }
 
-void alarm_stop() {
-  alarm_state.ringing = false;
+// The MCLK PIO program takes 5 cycles per period and cannot divide below 1
+uint32_t audio_min_sys_khz() {
+  return (pico_audio.mclk_freq * 5 + 999) / 1000;
 }
@@ -2,13 +2,16 @@
  * GameAudio.h - Modular Sound System for Pico Watch Games
  * 
  * This provides simple sound effects using the ES8311 audio codec.
- * Sounds are generated procedurally to save memory.
+ * Sounds are generated procedurally to save memory. Tones and effects
+ * are queued as timed notes for the Synth voices, rendered by the AudioOut
+ * DMA engine, so playing one never blocks the caller.
  */
 
 #ifndef GAME_AUDIO_H
 #define GAME_AUDIO_H
 
 #include <Arduino.h>
+#include "GameAudioScripts.h"
 
 // Sound types
 enum SoundEffect {
@@ -29,25 +32,84 @@ enum SoundEffect {
 // Initialize audio system
 bool audio_init();
 
-// Play a sound effect
+// Mixer channels (AudioChannel, in GameAudioScripts.h): music is ducked
+// while any of the others is sounding
+
+// Queue a sound effect (each effect has a fixed channel)
 void audio_play_sfx(SoundEffect sfx);
 
-// Play a tone (for custom sounds)
-void audio_play_tone(int frequency_hz, int duration_ms);
+// Queue a tone (for custom sounds); frequency 0 queues a rest
+void audio_play_tone(int frequency_hz, int duration_ms, AudioChannel channel = AUDIO_CH_SFX);
+
+// Stream a PCM16/ADPCM clip from the asset pack (ASSET_ID("name")); volume
+// is Q15. False if the clip is missing or not audio.
+bool audio_play_clip(uint32_t asset_hash, uint16_t volume = 32767, AudioChannel channel = AUDIO_CH_SFX);
+
+// Play a Tracker.h song on the music channel, from memory or from the
+// asset pack (ASSET_SONG); replaces the current song. False if invalid.
+bool audio_play_music(const uint8_t *song, uint32_t size, bool loop = true);
+bool audio_play_music(uint32_t asset_hash, bool loop = true);
+void audio_stop_music();
+bool audio_music_playing();
+
+// Per-channel volume (0-100), ramped in software; no codec traffic
+void audio_set_channel_volume(AudioChannel channel, int volume);
+int audio_channel_volume(AudioChannel channel);
 
-// Set volume (0-100)
+// Drop everything queued, music included
+void audio_stop();
+
+// True while notes or music are queued or voices are still sounding
+bool audio_is_playing();
+
+// Glitch and latency counters over a window (since the last reset)
+struct AudioStats {
+  uint32_t blocks;              // output blocks rendered
+  uint32_t underruns;           // the I2S FIFO ran dry while playing
+  uint32_t late_refills;        // a refill missed its block, which replayed
+  uint16_t refill_avg_pm;       // refill time, permille of a block period
+  uint16_t refill_peak_pm;
+  uint32_t irq_latency_us;      // worst DMA completion to refill start
+  uint32_t headroom_us;         // least time to spare when a refill finished
+  uint32_t sfx_triggers;
+  uint32_t sfx_latency_avg_us;  // audio_play_sfx() to its first sample leaving the codec
+  uint32_t sfx_latency_max_us;
+};
+
+void audio_get_stats(AudioStats *out, bool reset = true);
+
+// Synth cost plus the AudioStats window, then reset both (serial 'y')
+void audio_print_stats(Print &out);
+
+// Set master volume (0-100), on the ES8311 scale. Ramped in software; the
+// codec's coarse range is only rewritten while nothing is playing.
 void audio_set_volume(int volume);
 
-// Mute/unmute
+// Mute/unmute (a short fade; new sounds are dropped while muted)
 void audio_mute(bool mute);
 
 // Check if audio is initialized
 bool audio_is_ready();
 
-// Alarm functions
-void alarm_set(uint8_t hour, uint8_t minute, bool enabled);
-void alarm_check_and_play();  // Call this in your main loop
-bool alarm_is_ringing();
-void alarm_stop();
+// Output rate per workload: UI sounds at the lower rate (less refill work,
+// a lower MCLK and clock floor), music at the higher. A sound started while
+// the output is silent switches without a fade; music fades out whatever is
+// playing first. The mic records at the rate in force when it starts, and
+// the rate is held while it captures.
+#define AUDIO_RATE_UI     16000
+#define AUDIO_RATE_MUSIC  24000
+
+// Switch to 8000, 16000, 24000, 32000 or 48000 Hz: fade, drain, retune MCLK
+// and the codec dividers, move the clock floor. Stops anything playing
+// and blocks for up to ~0.1 s if it does. False if the rate is
+// unsupported, the mic is capturing or clk_sys cannot reach the new MCLK.
+bool audio_set_sample_rate(uint32_t hz);
+uint32_t audio_sample_rate();
+
+// Recompute clk_sys-derived audio dividers (MCLK) after a system clock change
+void audio_refresh_clocks();
+
+// Lowest clk_sys (kHz) that can still generate the configured MCLK
+uint32_t audio_min_sys_khz();
 
 #endif // GAME_AUDIO_H
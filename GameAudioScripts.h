@@ -0,0 +1,107 @@
+/*
+ * GameAudioScripts.h - Sound effect scripts, mixer channels and ducking
+ *
+ * The data GameAudio.cpp drives the Sfx sequencer and Mixer with, kept
+ * free of Arduino headers so tools/audio_budget measures exactly the same
+ * workload. The tables are inline constexpr, so there is one copy in
+ * flash however many files include this.
+ */
+
+#ifndef GAME_AUDIO_SCRIPTS_H
+#define GAME_AUDIO_SCRIPTS_H
+
+#include "Sfx.h"
+#include "Synth.h"
+
+// Mixer channels; music is ducked while any of the others is sounding
+enum AudioChannel : uint8_t {
+  AUDIO_CH_MUSIC,
+  AUDIO_CH_SFX,
+  AUDIO_CH_UI,
+  AUDIO_CH_ALARM,
+  AUDIO_CHANNELS
+};
+
+// Music ducking under everything else
+#define DUCK_SOURCES     ((1 << AUDIO_CH_SFX) | (1 << AUDIO_CH_UI) | (1 << AUDIO_CH_ALARM))
+#define DUCK_DEPTH       8231          // -12 dB
+#define DUCK_ATTACK_MS   10
+#define DUCK_HOLD_MS     150
+#define DUCK_RELEASE_MS  300
+
+// ---------- Sound effect scripts ----------
+//   { freq, slide to, gate ms, next ms, wave, envelope, volume }
+
+enum SfxGroup : uint8_t { GROUP_UI = 1, GROUP_WEAPON, GROUP_MOVE, GROUP_JINGLE, GROUP_ALERT };
+
+inline constexpr SfxStep STEPS_BEEP[] = {
+  {  800,    0,  50,  50, WAVE_SINE,     SFX_ENV_ORGAN, 128 },
+};
+inline constexpr SfxStep STEPS_SELECT[] = {
+  { 1200,    0,  50,  70, WAVE_SINE,     SFX_ENV_ORGAN, 128 },
+  { 1500,    0,  50,  50, WAVE_SINE,     SFX_ENV_ORGAN, 128 },
+};
+inline constexpr SfxStep STEPS_BACK[] = {
+  { 1000,    0,  50,  70, WAVE_SINE,     SFX_ENV_ORGAN, 128 },
+  {  600,    0,  50,  50, WAVE_SINE,     SFX_ENV_ORGAN, 128 },
+};
+inline constexpr SfxStep STEPS_ERROR[] = {
+  {  200,  160, 150, 150, WAVE_SQUARE,   SFX_ENV_ORGAN, 110 },
+};
+inline constexpr SfxStep STEPS_COIN[] = {
+  { 1000,    0,  50,  70, WAVE_SQUARE,   SFX_ENV_BLIP,  100 },
+  { 1500,    0,  50,  70, WAVE_SQUARE,   SFX_ENV_BLIP,  100 },
+  { 2000,    0, 100, 100, WAVE_SQUARE,   SFX_ENV_PLUCK, 100 },
+};
+inline constexpr SfxStep STEPS_JUMP[] = {
+  {  400,  800,  80,  80, WAVE_SQUARE,   SFX_ENV_ORGAN, 100 },
+};
+inline constexpr SfxStep STEPS_SHOOT[] = {
+  { 1500,  500, 150, 150, WAVE_SAW,      SFX_ENV_PLUCK, 110 },
+};
+inline constexpr SfxStep STEPS_EXPLODE[] = {
+  {  400,   60, 450, 450, WAVE_NOISE,    SFX_ENV_BOOM,  160 },
+};
+inline constexpr SfxStep STEPS_GAME_OVER[] = {
+  {  800,    0, 150, 200, WAVE_TRIANGLE, SFX_ENV_ORGAN, 140 },
+  {  600,    0, 150, 200, WAVE_TRIANGLE, SFX_ENV_ORGAN, 140 },
+  {  400,  380, 300, 300, WAVE_TRIANGLE, SFX_ENV_SOFT,  140 },
+};
+inline constexpr SfxStep STEPS_LEVEL_UP[] = {            // C5 E5 G5 C6, then the chord rings
+  {  523,    0, 100, 150, WAVE_TRIANGLE, SFX_ENV_ORGAN, 110 },
+  {  659,    0, 100, 150, WAVE_TRIANGLE, SFX_ENV_ORGAN, 110 },
+  {  784,    0, 100, 150, WAVE_TRIANGLE, SFX_ENV_ORGAN, 110 },
+  { 1047,    0, 250,   0, WAVE_TRIANGLE, SFX_ENV_SOFT,   90 },
+  {  784,    0, 250,   0, WAVE_TRIANGLE, SFX_ENV_SOFT,   70 },
+  {  523,    0, 250, 250, WAVE_TRIANGLE, SFX_ENV_SOFT,   70 },
+};
+inline constexpr SfxStep STEPS_ALARM[] = {
+  { 1200,    0, 200, 300, WAVE_SQUARE,   SFX_ENV_ORGAN, 128 },
+  {  800,    0, 200, 300, WAVE_SQUARE,   SFX_ENV_ORGAN, 128 },
+  { 1200,    0, 200, 300, WAVE_SQUARE,   SFX_ENV_ORGAN, 128 },
+  {  800,    0, 200, 300, WAVE_SQUARE,   SFX_ENV_ORGAN, 128 },
+  { 1200,    0, 200, 300, WAVE_SQUARE,   SFX_ENV_ORGAN, 128 },
+  {  800,    0, 200, 300, WAVE_SQUARE,   SFX_ENV_ORGAN, 128 },
+};
+inline constexpr SfxStep STEPS_NOTIFICATION[] = {
+  { 1000,    0, 100, 150, WAVE_SINE,     SFX_ENV_SOFT,  128 },
+  { 1200,    0, 100, 100, WAVE_SINE,     SFX_ENV_SOFT,  128 },
+};
+
+// Indexed by SoundEffect (GameAudio.h)
+inline constexpr SfxScript SFX_SCRIPTS[] = {
+  SFX_SCRIPT(STEPS_BEEP,         1, GROUP_UI,       AUDIO_CH_UI),
+  SFX_SCRIPT(STEPS_SELECT,       1, GROUP_UI,       AUDIO_CH_UI),
+  SFX_SCRIPT(STEPS_BACK,         1, GROUP_UI,       AUDIO_CH_UI),
+  SFX_SCRIPT(STEPS_ERROR,        2, GROUP_UI,       AUDIO_CH_UI),
+  SFX_SCRIPT(STEPS_COIN,         3, SFX_GROUP_NONE, AUDIO_CH_SFX),
+  SFX_SCRIPT(STEPS_JUMP,         2, GROUP_MOVE,     AUDIO_CH_SFX),
+  SFX_SCRIPT(STEPS_SHOOT,        1, GROUP_WEAPON,   AUDIO_CH_SFX),
+  SFX_SCRIPT(STEPS_EXPLODE,      3, GROUP_WEAPON,   AUDIO_CH_SFX),
+  SFX_SCRIPT(STEPS_GAME_OVER,    5, GROUP_JINGLE,   AUDIO_CH_SFX),
+  SFX_SCRIPT(STEPS_LEVEL_UP,     4, GROUP_JINGLE,   AUDIO_CH_SFX),
+  SFX_SCRIPT(STEPS_ALARM,        7, GROUP_ALERT,    AUDIO_CH_ALARM),
+  SFX_SCRIPT(STEPS_NOTIFICATION, 6, GROUP_ALERT,    AUDIO_CH_ALARM),
+};
+
+#endif // GAME_AUDIO_SCRIPTS_H
@@ -0,0 +1,142 @@
+/*
+ * GameBreakout.cpp - Breakout: keep the ball up with the paddle, clear the bricks
+ */
+
+#include "Game.h"
+#include "AMOLED_1in8.h"
+#include "GUI_Paint.h"
+#include "fonts.h"
+#include <math.h>
+
+#define BREAKOUT_HZ    60
+#define BRICK_ROWS     6
+#define BRICK_COLS     8
+#define BRICK_W        25
+#define BRICK_H        12
+#define BRICK_TOP      50
+#define PADDLE_Y       400
+#define PADDLE_W       60
+#define PADDLE_H       8
+#define BALL_RADIUS    4
+
+// Speeds are per 50 ms; each step moves by that scaled to its length
+static const float STEP_K = (float)GAME_TUNED_HZ / BREAKOUT_HZ;
+
+static const uint16_t BRICK_COLORS[BRICK_ROWS] = {0xF800, 0xFCA0, 0xFFE0, 0x07E0, 0x001F, 0xF81F};
+
+struct BreakoutState {
+  bool bricks[BRICK_ROWS][BRICK_COLS];
+  uint8_t bricks_remaining;
+  float ball_x, ball_y, ball_dx, ball_dy;
+  float ball_px, ball_py;            // previous step
+  float paddle_x;
+};
+static_assert(sizeof(BreakoutState) <= GAME_ARENA_BYTES, "Breakout state does not fit the game arena");
+
+// Full wall, ball above the paddle at the given speed
+static void start_level(BreakoutState &g, float dx, float dy) {
+  for (int row = 0; row < BRICK_ROWS; row++) {
+    for (int col = 0; col < BRICK_COLS; col++) g.bricks[row][col] = true;
+  }
+  g.bricks_remaining = BRICK_ROWS * BRICK_COLS;
+
+  g.ball_x = g.ball_px = AMOLED_1IN8_WIDTH / 2;
+  g.ball_y = g.ball_py = 300;
+  g.ball_dx = dx;
+  g.ball_dy = dy;
+  g.paddle_x = (AMOLED_1IN8_WIDTH - PADDLE_W) / 2;
+}
+
+static void breakout_init(void *state) {
+  start_level(*(BreakoutState *)state, 2, -3);
+}
+
+static void breakout_update(void *state) {
+  BreakoutState &g = *(BreakoutState *)state;
+
+  g.ball_px = g.ball_x;
+  g.ball_py = g.ball_y;
+  g.ball_x += g.ball_dx * STEP_K;
+  g.ball_y += g.ball_dy * STEP_K;
+
+  if (g.ball_x <= BALL_RADIUS || g.ball_x >= AMOLED_1IN8_WIDTH - BALL_RADIUS) g.ball_dx = -g.ball_dx;
+  if (g.ball_y <= BALL_RADIUS) g.ball_dy = -g.ball_dy;
+
+  if (g.ball_y >= AMOLED_1IN8_HEIGHT - BALL_RADIUS) {
+    game_over();
+    return;
+  }
+
+  // Paddle: always bounce up, angled by where it hit
+  if (g.ball_y + BALL_RADIUS >= PADDLE_Y && g.ball_y - BALL_RADIUS <= PADDLE_Y + PADDLE_H &&
+      g.ball_x >= g.paddle_x && g.ball_x <= g.paddle_x + PADDLE_W) {
+    g.ball_dy = -fabsf(g.ball_dy);
+    float hit_pos = (g.ball_x - g.paddle_x) / PADDLE_W;     // 0 to 1
+    g.ball_dx = (hit_pos - 0.5f) * 4;                       // -2 to +2
+  }
+
+  for (int row = 0; row < BRICK_ROWS; row++) {
+    for (int col = 0; col < BRICK_COLS; col++) {
+      if (!g.bricks[row][col]) continue;
+      int brick_x = col * (AMOLED_1IN8_WIDTH / BRICK_COLS);
+      int brick_y = BRICK_TOP + row * BRICK_H;
+      if (g.ball_x + BALL_RADIUS >= brick_x && g.ball_x - BALL_RADIUS <= brick_x + BRICK_W &&
+          g.ball_y + BALL_RADIUS >= brick_y && g.ball_y - BALL_RADIUS <= brick_y + BRICK_H) {
+        g.bricks[row][col] = false;
+        g.bricks_remaining--;
+        game_add_score(10);
+        g.ball_dy = -g.ball_dy;
+
+        // Level complete: a new wall and a faster ball
+        if (g.bricks_remaining == 0) start_level(g, 2 * 1.2f, -3 * 1.2f);
+        return;
+      }
+    }
+  }
+}
+
+static void breakout_render(void *state, uint8_t alpha) {
+  const BreakoutState &g = *(const BreakoutState *)state;
+  Paint_Clear(BLACK);
+
+  for (int row = 0; row < BRICK_ROWS; row++) {
+    for (int col = 0; col < BRICK_COLS; col++) {
+      if (!g.bricks[row][col]) continue;
+      int brick_x = col * (AMOLED_1IN8_WIDTH / BRICK_COLS);
+      int brick_y = BRICK_TOP + row * BRICK_H;
+      Paint_DrawRectangle(brick_x, brick_y, brick_x + BRICK_W - 2, brick_y + BRICK_H - 1,
+                          BRICK_COLORS[row], DOT_PIXEL_1X1, DRAW_FILL_FULL);
+    }
+  }
+
+  Paint_DrawRectangle(g.paddle_x, PADDLE_Y, g.paddle_x + PADDLE_W, PADDLE_Y + PADDLE_H, WHITE, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+  Paint_DrawCircle(game_lerp(g.ball_px, g.ball_x, alpha), game_lerp(g.ball_py, g.ball_y, alpha),
+                   BALL_RADIUS, WHITE, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+
+  char score_str[32];
+  snprintf(score_str, sizeof(score_str), "Score: %d", game_score());
+  Paint_DrawString_EN(5, 5, score_str, &Font12, WHITE, BLACK);
+  snprintf(score_str, sizeof(score_str), "Bricks: %d", g.bricks_remaining);
+  Paint_DrawString_EN(5, 20, score_str, &Font12, WHITE, BLACK);
+
+  AMOLED_1IN8_Display(game_framebuffer());
+}
+
+// The paddle follows the touch
+static void breakout_input(void *state, uint16_t x, uint16_t y) {
+  BreakoutState &g = *(BreakoutState *)state;
+  g.paddle_x = (int)x - PADDLE_W / 2;
+  if (g.paddle_x < 0) g.paddle_x = 0;
+  if (g.paddle_x > AMOLED_1IN8_WIDTH - PADDLE_W) g.paddle_x = AMOLED_1IN8_WIDTH - PADDLE_W;
+}
+
+extern const Game GAME_BREAKOUT = {
+  "Breakout",
+  { BREAKOUT_HZ, 30, 6, 2 },       // small steps, so the ball cannot skip a brick
+  sizeof(BreakoutState),
+  breakout_init,
+  breakout_update,
+  breakout_render,
+  breakout_input,
+  nullptr,
+};
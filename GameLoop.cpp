@@ -0,0 +1,95 @@
+/*
+ * GameLoop.cpp - Fixed-timestep game runner implementation
+ */
+
+#include "GameLoop.h"
+#include <string.h>
+
+#define US_PER_S  1000000u
+
+static GameTiming timing = { 20, 20, 4, 2 };
+static uint32_t last_us = 0;
+static uint64_t acc = 0;                 // banked time, us * step_hz (US_PER_S = one step)
+static uint32_t ticks = 0;
+static uint32_t next_frame_us = 0;
+static uint8_t  skipped_in_row = 0;
+static bool     redraw = true;
+static GameLoopStats stats;
+
+void game_loop_begin(const GameTiming &t, uint32_t now_us) {
+  timing = t;
+  if (!timing.step_hz) timing.step_hz = 1;
+  if (!timing.render_hz) timing.render_hz = 1;
+  if (!timing.max_steps) timing.max_steps = 1;
+  last_us = now_us;
+  next_frame_us = now_us;
+  acc = 0;
+  ticks = 0;
+  skipped_in_row = 0;
+  redraw = true;
+}
+
+bool game_loop_run(uint32_t now_us, GameStepFn step, GameRenderFn render) {
+  uint32_t elapsed = now_us - last_us;
+  last_us = now_us;
+  if (elapsed > GAME_LOOP_MAX_GAP_US) {
+    // Resume from where the game was, backlog and all dropped
+    stats.dropped_ms += elapsed / 1000 + (uint32_t)(acc / US_PER_S * 1000 / timing.step_hz);
+    acc = 0;
+    elapsed = 0;
+    next_frame_us = now_us;
+  }
+  acc += (uint64_t)elapsed * timing.step_hz;
+
+  uint8_t n = 0;
+  while (acc >= US_PER_S && n < timing.max_steps) {
+    step();
+    acc -= US_PER_S;
+    ticks++;
+    n++;
+  }
+  stats.steps += n;
+
+  bool behind = acc >= US_PER_S;
+  if (behind) {
+    if (skipped_in_row < timing.max_frame_skip) {
+      skipped_in_row++;
+      stats.skipped_frames++;
+      return false;
+    }
+    // Still behind with the frame budget spent: give up the backlog
+    stats.dropped_ms += (uint32_t)(acc / US_PER_S * 1000 / timing.step_hz);
+    acc %= US_PER_S;
+  }
+
+  uint32_t period = US_PER_S / timing.render_hz;
+  if (!redraw && !behind && (int32_t)(now_us - next_frame_us) < 0) return false;
+  next_frame_us += period;
+  if ((int32_t)(now_us - next_frame_us) >= 0) next_frame_us = now_us + period;   // fell behind: resync
+  redraw = false;
+  skipped_in_row = 0;
+  render((uint8_t)(acc * 256 / US_PER_S));
+  stats.frames++;
+  return true;
+}
+
+void game_loop_redraw() {
+  redraw = true;
+}
+
+uint32_t game_loop_ticks() {
+  return ticks;
+}
+
+uint32_t game_loop_time_ms() {
+  return (uint32_t)((uint64_t)ticks * 1000 / timing.step_hz);
+}
+
+const GameTiming &game_loop_timing() {
+  return timing;
+}
+
+void game_loop_stats(GameLoopStats *out, bool reset) {
+  *out = stats;
+  if (reset) memset(&stats, 0, sizeof(stats));
+}
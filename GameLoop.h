@@ -0,0 +1,66 @@
+/*
+ * GameLoop.h - Fixed-timestep game runner
+ *
+ * Games advance in fixed simulation steps, so gameplay is a function of
+ * the step count and the inputs between steps, never of how long a frame
+ * took to draw. Elapsed time is banked in an accumulator (exactly, in
+ * units of 1/step_hz us, so no rounding drift) and paid out as whole
+ * steps. Rendering runs at its own, lower target rate and is handed the
+ * fraction of a step banked since the last one, for interpolation.
+ *
+ * Under load the runner first catches up (up to max_steps per call) and
+ * skips frames to do so (up to max_frame_skip in a row); time it still
+ * cannot pay for is dropped, so the game slows down instead of spiralling.
+ * Gaps longer than GAME_LOOP_MAX_GAP_US (the screen was left, a flash
+ * erase) are dropped outright.
+ *
+ * No Arduino dependencies: the caller passes the time, so a host tool can
+ * replay a game step for step.
+ */
+
+#ifndef GAME_LOOP_H
+#define GAME_LOOP_H
+
+#include <stdint.h>
+
+#define GAME_LOOP_MAX_GAP_US  250000
+
+struct GameTiming {
+  uint16_t step_hz;          // simulation steps per second
+  uint8_t  render_hz;        // target frames per second
+  uint8_t  max_steps;        // catch-up steps per call
+  uint8_t  max_frame_skip;   // frames skipped in a row while behind
+};
+
+// Advance the simulation by one step
+typedef void (*GameStepFn)();
+
+// Draw the current state; alpha (0-255) is how far time has moved on
+// towards the next step, for interpolating from the previous one
+typedef void (*GameRenderFn)(uint8_t alpha);
+
+struct GameLoopStats {
+  uint32_t steps;
+  uint32_t frames;
+  uint32_t skipped_frames;   // not drawn, to catch up
+  uint32_t dropped_ms;       // simulation time given up
+};
+
+// Start a game's clock at step 0
+void game_loop_begin(const GameTiming &timing, uint32_t now_us);
+
+// Run the steps that are due and render if a frame is due; call every
+// loop(). Returns true if it rendered.
+bool game_loop_run(uint32_t now_us, GameStepFn step, GameRenderFn render);
+
+// Render on the next run whatever the frame rate (after input, say)
+void game_loop_redraw();
+
+// The game clock: steps since game_loop_begin(), and the same in ms
+uint32_t game_loop_ticks();
+uint32_t game_loop_time_ms();
+const GameTiming &game_loop_timing();
+
+void game_loop_stats(GameLoopStats *out, bool reset);
+
+#endif // GAME_LOOP_H
@@ -0,0 +1,102 @@
+/*
+ * GameSnake.cpp - Snake: steer to the food, grow, avoid walls and yourself
+ */
+
+#include "Game.h"
+#include "SnakeEngine.h"
+#include "AMOLED_1in8.h"
+#include "GUI_Paint.h"
+#include "fonts.h"
+
+#define SNAKE_HZ          60
+#define SNAKE_GRID_SIZE   12
+
+struct SnakeState {
+  SnakeBoard board;
+  uint32_t last_move;                // game_loop_time_ms()
+  uint16_t move_ms;
+};
+static_assert(sizeof(SnakeState) <= GAME_ARENA_BYTES, "Snake state does not fit the game arena");
+
+static void place_food(SnakeBoard &b) {
+  uint16_t free_cells = snake_free_cells(&b);
+  if (free_cells) snake_place_food(&b, game_random(free_cells));
+}
+
+static void snake_init(void *state) {
+  SnakeState &g = *(SnakeState *)state;
+  snake_reset(&g.board, SNAKE_W / 2, SNAKE_H / 2, 4, SNAKE_RIGHT);
+  g.move_ms = 300;
+  g.last_move = game_loop_time_ms();
+  place_food(g.board);
+}
+
+static void snake_update(void *state) {
+  SnakeState &g = *(SnakeState *)state;
+  uint32_t now = game_loop_time_ms();
+  if (now - g.last_move < g.move_ms) return;
+  g.last_move = now;
+
+  SnakeResult r = snake_step(&g.board);
+  if (r == SNAKE_DIED) {
+    game_over();
+    return;
+  }
+  if (r == SNAKE_ATE) {
+    game_add_score(10);
+    g.move_ms = g.move_ms > 105 ? g.move_ms - 5 : 100;
+    place_food(g.board);
+    if (g.board.food == SNAKE_NO_FOOD) game_over();    // the board is full
+  }
+}
+
+static void snake_render(void *state, uint8_t alpha) {
+  const SnakeState &g = *(const SnakeState *)state;
+  Paint_Clear(BLACK);
+  Paint_DrawRectangle(0, 0, AMOLED_1IN8_WIDTH - 1, AMOLED_1IN8_HEIGHT - 1, WHITE, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
+
+  // Walk the bitmap rather than the body: the same 19 words at any length
+  for (uint16_t w = 0; w < SNAKE_WORDS; w++) {
+    uint32_t bits = g.board.occupied[w];
+    while (bits) {
+      uint16_t cell = w * 32 + __builtin_ctz(bits);
+      bits &= bits - 1;
+      int x = cell % SNAKE_W * SNAKE_GRID_SIZE;
+      int y = cell / SNAKE_W * SNAKE_GRID_SIZE;
+      uint16_t color = (cell == g.board.head) ? 0x07E0 : 0x07C0;   // head brighter
+      Paint_DrawRectangle(x, y, x + SNAKE_GRID_SIZE - 1, y + SNAKE_GRID_SIZE - 1, color, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+    }
+  }
+
+  if (g.board.food != SNAKE_NO_FOOD) {
+    int fx = g.board.food % SNAKE_W * SNAKE_GRID_SIZE;
+    int fy = g.board.food / SNAKE_W * SNAKE_GRID_SIZE;
+    Paint_DrawRectangle(fx, fy, fx + SNAKE_GRID_SIZE - 1, fy + SNAKE_GRID_SIZE - 1, 0xF800, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+  }
+
+  char score_str[32];
+  snprintf(score_str, sizeof(score_str), "Score: %d", game_score());
+  Paint_DrawString_EN(5, 5, score_str, &Font12, WHITE, BLACK);
+
+  AMOLED_1IN8_Display(game_framebuffer());
+}
+
+// Left and right thirds turn that way, the middle turns up or down
+static void snake_input(void *state, uint16_t x, uint16_t y) {
+  SnakeState &g = *(SnakeState *)state;
+  if (x < AMOLED_1IN8_WIDTH / 3) g.board.dir = SNAKE_LEFT;
+  else if (x > (AMOLED_1IN8_WIDTH * 2) / 3) g.board.dir = SNAKE_RIGHT;
+  else if (y < AMOLED_1IN8_HEIGHT / 2) g.board.dir = SNAKE_UP;
+  else g.board.dir = SNAKE_DOWN;
+}
+
+extern const Game GAME_SNAKE = {
+  "Snake",
+  { SNAKE_HZ, 20, 6, 2 },          // moves keep their ms, input lands within a step
+  sizeof(SnakeState),
+  snake_init,
+  snake_update,
+  snake_render,
+  snake_input,
+  nullptr,
+};
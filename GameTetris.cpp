@@ -0,0 +1,217 @@
+/*
+ * GameTetris.cpp - Tetris: steer and rotate the falling piece, clear lines
+ */
+
+#include "Game.h"
+#include "AMOLED_1in8.h"
+#include "GUI_Paint.h"
+#include "fonts.h"
+#include "TetrisEngine.h"
+#include <string.h>
+
+#define TETRIS_HZ      60
+#define BLOCK_SIZE     18
+#define GRID_LEFT      64
+#define GRID_TOP       40
+#define SCORE_Y        10
+#define NEXT_X         260               // preview box
+#define NEXT_Y         100
+#define NEXT_SIZE      80
+#define PREVIEW_BLOCK  16
+
+// Indexed by TetrisPiece: I, O, S, Z, T, L, J
+static const uint16_t PIECE_COLORS[TETRIS_PIECES] = {0x7FFF, 0xFFE0, 0x07E0, 0xF800, 0xF81F, 0xFD20, 0x001F};
+
+// What the panel shows, so a frame only sends what changed
+struct TetrisScreen {
+  uint8_t cells[TETRIS_H][TETRIS_W];   // as tetris_cell(), falling piece included
+  int score;
+  uint8_t next_piece;
+  bool valid;                          // false: the next frame redraws everything
+};
+
+struct TetrisState {
+  TetrisBoard board;
+  TetrisScreen shown;
+  uint8_t next_piece;
+  uint32_t last_drop;                // game_loop_time_ms()
+  uint16_t drop_ms;
+  uint8_t lines;                     // towards the next speed-up
+};
+static_assert(sizeof(TetrisState) <= GAME_ARENA_BYTES, "Tetris state does not fit the game arena");
+
+static void spawn_piece(TetrisState &g) {
+  if (!tetris_spawn(&g.board, g.next_piece)) game_over();
+  g.next_piece = game_random(TETRIS_PIECES);
+}
+
+static void tetris_init(void *state) {
+  TetrisState &g = *(TetrisState *)state;
+  tetris_reset(&g.board);
+  g.drop_ms = 500;
+  g.last_drop = game_loop_time_ms();
+  g.next_piece = game_random(TETRIS_PIECES);
+  spawn_piece(g);
+}
+
+static void tetris_update(void *state) {
+  TetrisState &g = *(TetrisState *)state;
+  uint32_t now = game_loop_time_ms();
+  if (now - g.last_drop <= g.drop_ms) return;
+  g.last_drop = now;
+
+  if (tetris_move(&g.board, 0, 1)) return;
+
+  uint8_t lines = tetris_lock(&g.board);
+  if (lines > 0) {
+    g.lines += lines;
+    game_add_score(lines * 100);
+    if (g.lines >= 10) {
+      g.drop_ms = g.drop_ms > 150 ? g.drop_ms - 50 : 100;
+      g.lines = 0;
+    }
+  }
+  spawn_piece(g);
+}
+
+// One block per set bit of a piece's 4x4 box
+static void draw_piece(uint8_t piece, uint8_t rot, int left, int top, int size) {
+  for (int r = 0; r < 4; r++) {
+    uint8_t bits = tetris_piece_row(piece, rot, r);
+    for (int c = 0; c < 4; c++) {
+      if (!((bits >> c) & 1)) continue;
+      int px = left + c * size;
+      int py = top + r * size;
+      Paint_DrawRectangle(px, py, px + size - 1, py + size - 1,
+                          PIECE_COLORS[piece], DOT_PIXEL_1X1, DRAW_FILL_FULL);
+    }
+  }
+}
+
+// The well as it should look: settled cells plus the falling piece
+static void visible_cells(const TetrisBoard &b, uint8_t cells[TETRIS_H][TETRIS_W]) {
+  for (int y = 0; y < TETRIS_H; y++) {
+    for (int x = 0; x < TETRIS_W; x++) cells[y][x] = b.rows[y] ? tetris_cell(&b, x, y) : 0;
+  }
+  for (int r = 0; r < 4; r++) {
+    uint8_t bits = tetris_piece_row(b.piece, b.rot, r);
+    int y = b.y + r;
+    if (!bits || y < 0 || y >= TETRIS_H) continue;
+    for (int c = 0; c < 4; c++) {
+      int x = b.x + c;
+      if ((bits >> c) & 1 && x >= 0 && x < TETRIS_W) cells[y][x] = b.piece + 1;
+    }
+  }
+}
+
+static void draw_cell(int x, int y, uint8_t cell) {
+  int px = GRID_LEFT + x * BLOCK_SIZE;
+  int py = GRID_TOP + y * BLOCK_SIZE;
+  Paint_ClearWindows(px, py, px + BLOCK_SIZE, py + BLOCK_SIZE, BLACK);
+  if (cell) {
+    Paint_DrawRectangle(px, py, px + BLOCK_SIZE - 1, py + BLOCK_SIZE - 1,
+                        PIECE_COLORS[cell - 1], DOT_PIXEL_1X1, DRAW_FILL_FULL);
+  }
+}
+
+static void draw_score() {
+  char score_str[32];
+  snprintf(score_str, sizeof(score_str), "Score:%d Hi:%d", game_score(), game_high_score());
+  Paint_ClearWindows(0, SCORE_Y, AMOLED_1IN8_WIDTH, SCORE_Y + Font24.Height, BLACK);
+  Paint_DrawString_EN(10, SCORE_Y, score_str, &Font24, WHITE, BLACK);
+}
+
+static void draw_next(uint8_t piece) {
+  Paint_ClearWindows(NEXT_X + 1, NEXT_Y + 1, NEXT_X + NEXT_SIZE, NEXT_Y + NEXT_SIZE, BLACK);
+  draw_piece(piece, 0, NEXT_X + 10, NEXT_Y + 10, PREVIEW_BLOCK);
+}
+
+static void draw_all(const uint8_t cells[TETRIS_H][TETRIS_W], uint8_t next_piece) {
+  Paint_Clear(BLACK);
+  Paint_DrawRectangle(GRID_LEFT - 2, GRID_TOP - 2,
+                      GRID_LEFT + TETRIS_W * BLOCK_SIZE + 2, GRID_TOP + TETRIS_H * BLOCK_SIZE + 2,
+                      WHITE, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
+  for (int y = 0; y < TETRIS_H; y++) {
+    for (int x = 0; x < TETRIS_W; x++) {
+      if (cells[y][x]) draw_cell(x, y, cells[y][x]);
+    }
+  }
+  draw_score();
+  Paint_DrawString_EN(NEXT_X + 10, NEXT_Y - 30, "NEXT", &Font24, CYAN, BLACK);
+  Paint_DrawRectangle(NEXT_X, NEXT_Y, NEXT_X + NEXT_SIZE, NEXT_Y + NEXT_SIZE,
+                      WHITE, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
+  draw_next(next_piece);
+  Paint_DrawString_EN(10, 460, "L:Left M:Rotate R:Right", &Font24, GRAY, BLACK);
+  AMOLED_1IN8_Display(game_framebuffer());
+}
+
+// The whole screen once per game; after that only the cells that changed
+// (one window per run of changed cells in a row), the score line and the
+// preview box go to the panel. A frame where nothing moved sends nothing.
+static void tetris_render(void *state, uint8_t alpha) {
+  TetrisState &g = *(TetrisState *)state;
+  TetrisScreen &shown = g.shown;
+  UWORD *frame = game_framebuffer();
+  uint8_t cells[TETRIS_H][TETRIS_W];
+  visible_cells(g.board, cells);
+
+  if (!shown.valid) {
+    draw_all(cells, g.next_piece);
+    memcpy(shown.cells, cells, sizeof(cells));
+    shown.score = game_score();
+    shown.next_piece = g.next_piece;
+    shown.valid = true;
+    return;
+  }
+
+  for (int y = 0; y < TETRIS_H; y++) {
+    int x = 0;
+    while (x < TETRIS_W) {
+      if (cells[y][x] == shown.cells[y][x]) {
+        x++;
+        continue;
+      }
+      int first = x;
+      for (; x < TETRIS_W && cells[y][x] != shown.cells[y][x]; x++) {
+        draw_cell(x, y, cells[y][x]);
+        shown.cells[y][x] = cells[y][x];
+      }
+      AMOLED_1IN8_DisplayWindows(GRID_LEFT + first * BLOCK_SIZE, GRID_TOP + y * BLOCK_SIZE,
+                                 GRID_LEFT + x * BLOCK_SIZE, GRID_TOP + (y + 1) * BLOCK_SIZE, frame);
+    }
+  }
+
+  if (shown.score != game_score()) {
+    shown.score = game_score();
+    draw_score();
+    AMOLED_1IN8_DisplayWindows(0, SCORE_Y, AMOLED_1IN8_WIDTH, SCORE_Y + Font24.Height, frame);
+  }
+
+  if (shown.next_piece != g.next_piece) {
+    shown.next_piece = g.next_piece;
+    draw_next(g.next_piece);
+    // The whole box, border included: the interior alone starts on odd
+    // coordinates, which the panel does not accept
+    AMOLED_1IN8_DisplayWindows(NEXT_X, NEXT_Y, NEXT_X + NEXT_SIZE, NEXT_Y + NEXT_SIZE, frame);
+  }
+}
+
+// Left third moves left, the middle rotates clockwise, right third moves right
+static void tetris_input(void *state, uint16_t x, uint16_t y) {
+  TetrisState &g = *(TetrisState *)state;
+  if (x < 123) tetris_move(&g.board, -1, 0);
+  else if (x <= 245) tetris_rotate(&g.board, 1);
+  else tetris_move(&g.board, 1, 0);
+  game_loop_redraw();
+}
+
+extern const Game GAME_TETRIS = {
+  "Tetris",
+  { TETRIS_HZ, 20, 6, 2 },         // input lands within a step, drops keep their ms
+  sizeof(TetrisState),
+  tetris_init,
+  tetris_update,
+  tetris_render,
+  tetris_input,
+  nullptr,
+};
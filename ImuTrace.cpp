@@ -0,0 +1,104 @@
+/*
+ * ImuTrace.cpp - On-device IMU trace recorder implementation
+ */
+
+#include "ImuTrace.h"
+
+struct TraceBlock {
+  uint8_t  data[IMU_TRACE_BLOCK_BYTES];
+  uint16_t len;
+  uint16_t count;
+};
+
+static TraceBlock trace_blocks[IMU_TRACE_BLOCKS];
+static uint8_t  trace_first = 0;      // oldest valid block
+static uint8_t  trace_used = 0;       // number of valid blocks
+static bool     trace_recording = false;
+static uint16_t trace_lsb_div = 0;
+static uint32_t trace_total = 0;
+static uint32_t trace_prev_t = 0;
+static int16_t  trace_prev[3];
+
+void imu_trace_clear() {
+  trace_first = 0;
+  trace_used = 0;
+  trace_total = 0;
+}
+
+void imu_trace_start(uint16_t acc_lsb_div) {
+  imu_trace_clear();
+  trace_lsb_div = acc_lsb_div;
+  trace_recording = true;
+}
+
+void imu_trace_stop() {
+  trace_recording = false;
+}
+
+bool imu_trace_is_recording() {
+  return trace_recording;
+}
+
+uint32_t imu_trace_sample_count() {
+  return trace_total;
+}
+
+// Open a fresh block at the head, dropping the oldest one when full
+static TraceBlock *trace_new_block() {
+  uint8_t idx;
+  if (trace_used < IMU_TRACE_BLOCKS) {
+    idx = (trace_first + trace_used) % IMU_TRACE_BLOCKS;
+    trace_used++;
+  } else {
+    idx = trace_first;
+    trace_total -= trace_blocks[idx].count;
+    trace_first = (trace_first + 1) % IMU_TRACE_BLOCKS;
+  }
+  trace_blocks[idx].len = 0;
+  trace_blocks[idx].count = 0;
+  return &trace_blocks[idx];
+}
+
+void imu_trace_push(uint32_t t_ms, const int16_t raw[3]) {
+  if (!trace_recording) return;
+
+  TraceBlock *blk = trace_used ? &trace_blocks[(trace_first + trace_used - 1) % IMU_TRACE_BLOCKS] : nullptr;
+  if (!blk || blk->len + IMU_TRACE_MAX_RECORD > IMU_TRACE_BLOCK_BYTES) {
+    blk = trace_new_block();
+    imu_trace_put_key(blk->data, t_ms, raw);
+    blk->len = IMU_TRACE_KEY_BYTES;
+  } else {
+    blk->len += imu_trace_put_delta(blk->data + blk->len, trace_prev_t, trace_prev, t_ms, raw);
+  }
+  blk->count++;
+  trace_total++;
+
+  trace_prev_t = t_ms;
+  trace_prev[0] = raw[0];
+  trace_prev[1] = raw[1];
+  trace_prev[2] = raw[2];
+}
+
+void imu_trace_dump(Print &out) {
+  static const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+  out.print("#IMUTRACE v1 lsb=");
+  out.print(trace_lsb_div);
+  out.print(" blocks=");
+  out.print(trace_used);
+  out.print(" samples=");
+  out.println(trace_total);
+
+  for (uint8_t i = 0; i < trace_used; i++) {
+    const TraceBlock &blk = trace_blocks[(trace_first + i) % IMU_TRACE_BLOCKS];
+    out.print("B ");
+    out.print(blk.count);
+    out.print(' ');
+    for (uint16_t j = 0; j < blk.len; j++) {
+      out.write(HEX_DIGITS[blk.data[j] >> 4]);
+      out.write(HEX_DIGITS[blk.data[j] & 0x0F]);
+    }
+    out.println();
+  }
+  out.println("#END");
+}
@@ -0,0 +1,127 @@
+/*
+ * ImuTrace.h - On-device IMU trace recorder
+ *
+ * Captures raw QMI8658 accelerometer samples with timestamps into a RAM
+ * ring of fixed-size blocks and dumps them over serial so tap detector
+ * parameters can be tuned offline with tools/imu_replay.
+ *
+ * Block format (IMU_TRACE_BLOCK_BYTES each, little-endian):
+ *   uint32 t0_ms, int16 ax, ay, az      - first sample, absolute
+ *   then per sample: varint dt_ms, zigzag varint dax, day, daz
+ * Every block starts with an absolute keyframe, so the ring can drop its
+ * oldest block without breaking decoding of the rest.
+ *
+ * The codec below is header-only and Arduino-free so the host tool decodes
+ * with exactly the same code the recorder encodes with.
+ */
+
+#ifndef IMU_TRACE_H
+#define IMU_TRACE_H
+
+#include <stdint.h>
+
+#define IMU_TRACE_BLOCK_BYTES  256
+#define IMU_TRACE_BLOCKS       32     // 8 KB of RAM, ~80 s at 40 Hz
+#define IMU_TRACE_KEY_BYTES    10
+#define IMU_TRACE_MAX_RECORD   16     // worst-case encoded sample size
+
+// ---------- Codec ----------
+static inline uint32_t imu_trace_zigzag(int32_t v) {
+  return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static inline int32_t imu_trace_unzigzag(uint32_t v) {
+  return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+static inline uint8_t imu_trace_put_varint(uint8_t *p, uint32_t v) {
+  uint8_t n = 0;
+  while (v >= 0x80) {
+    p[n++] = (uint8_t)(v | 0x80);
+    v >>= 7;
+  }
+  p[n++] = (uint8_t)v;
+  return n;
+}
+
+static inline uint8_t imu_trace_get_varint(const uint8_t *p, const uint8_t *end, uint32_t *v) {
+  uint32_t r = 0;
+  uint8_t n = 0, shift = 0;
+  while (p + n < end && shift < 35) {
+    uint8_t b = p[n++];
+    r |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) { *v = r; return n; }
+    shift += 7;
+  }
+  return 0; // truncated
+}
+
+static inline void imu_trace_put_key(uint8_t *p, uint32_t t_ms, const int16_t a[3]) {
+  for (int i = 0; i < 4; i++) p[i] = (uint8_t)(t_ms >> (8 * i));
+  for (int i = 0; i < 3; i++) {
+    p[4 + 2*i] = (uint8_t)a[i];
+    p[5 + 2*i] = (uint8_t)((uint16_t)a[i] >> 8);
+  }
+}
+
+// Encode the delta from (prev_t, prev) to (t, a); returns bytes written
+static inline uint8_t imu_trace_put_delta(uint8_t *p, uint32_t prev_t, const int16_t prev[3],
+                                          uint32_t t, const int16_t a[3]) {
+  uint8_t n = imu_trace_put_varint(p, t - prev_t);
+  for (int i = 0; i < 3; i++) {
+    n += imu_trace_put_varint(p + n, imu_trace_zigzag((int32_t)a[i] - prev[i]));
+  }
+  return n;
+}
+
+// Decode one block of 'len' bytes holding 'count' samples. The callback
+// receives each sample in order. Returns the number of samples decoded.
+template <typename Fn>
+static inline uint16_t imu_trace_decode_block(const uint8_t *blk, uint16_t len, uint16_t count, Fn fn) {
+  if (count == 0 || len < IMU_TRACE_KEY_BYTES) return 0;
+  uint32_t t = 0;
+  int16_t a[3];
+  for (int i = 0; i < 4; i++) t |= (uint32_t)blk[i] << (8 * i);
+  for (int i = 0; i < 3; i++) a[i] = (int16_t)(blk[4 + 2*i] | (blk[5 + 2*i] << 8));
+  fn(t, a);
+
+  const uint8_t *p = blk + IMU_TRACE_KEY_BYTES;
+  const uint8_t *end = blk + len;
+  uint16_t decoded = 1;
+  while (decoded < count) {
+    uint32_t v;
+    uint8_t n = imu_trace_get_varint(p, end, &v);
+    if (!n) break;
+    p += n;
+    t += v;
+    bool ok = true;
+    for (int i = 0; i < 3 && ok; i++) {
+      n = imu_trace_get_varint(p, end, &v);
+      if (!n) { ok = false; break; }
+      p += n;
+      a[i] = (int16_t)(a[i] + imu_trace_unzigzag(v));
+    }
+    if (!ok) break;
+    fn(t, a);
+    decoded++;
+  }
+  return decoded;
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+// ---------- Recorder ----------
+void imu_trace_start(uint16_t acc_lsb_div);   // clears the ring and starts recording
+void imu_trace_stop();
+bool imu_trace_is_recording();
+void imu_trace_clear();
+void imu_trace_push(uint32_t t_ms, const int16_t raw[3]);
+uint32_t imu_trace_sample_count();
+
+// Write the ring (oldest block first) as text: header, one "B" line per
+// block with its sample count and hex payload, then "#END".
+void imu_trace_dump(Print &out);
+#endif
+
+#endif // IMU_TRACE_H
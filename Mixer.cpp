@@ -0,0 +1,195 @@
+/*
+ * Mixer.cpp - Channel mixer with gain ramps and ducking implementation
+ */
+
+#include "Mixer.h"
+#include <string.h>
+
+#define CHUNK  64                                // accumulator, frames
+
+struct Ramp {
+  int32_t  gain;           // Q30, so slow ramps still move every sample
+  int32_t  step;
+  uint32_t left;
+  uint16_t to;             // Q15 target of the current (or finished) ramp
+};
+
+struct Channel {
+  volatile uint16_t target;
+  volatile uint16_t ramp_ms;
+  Ramp ramp;
+};
+
+static Channel  channels[MIXER_CHANNELS];
+static volatile uint16_t master_target = MIXER_UNITY;
+static volatile uint16_t master_ramp_ms = MIXER_RAMP_MS;
+static Ramp     master;
+static uint32_t rate = 24000;
+
+// Ducking
+static volatile uint8_t duck_channel = 0xFF;     // none
+static volatile uint8_t duck_mask = 0;
+static volatile uint16_t duck_depth = MIXER_UNITY;
+static uint16_t duck_attack_ms = 10, duck_hold_ms = 0, duck_release_ms = 200;
+static bool     ducked = false;
+static bool     duck_ramped = false;             // duck state the current ramp was started for
+static uint32_t hold_left = 0;
+
+static inline uint32_t ms_to_samples(uint16_t ms) {
+  uint32_t n = rate * ms / 1000;
+  return n ? n : 1;
+}
+
+static void ramp_set(Ramp &r, uint16_t gain) {
+  r.gain = (int32_t)gain << 15;
+  r.step = 0;
+  r.left = 0;
+  r.to = gain;
+}
+
+static void ramp_start(Ramp &r, uint16_t to, uint16_t ms) {
+  r.to = to;
+  r.left = ms_to_samples(ms);
+  r.step = (((int32_t)to << 15) - r.gain) / (int32_t)r.left;
+}
+
+static inline void ramp_skip(Ramp &r, uint32_t n) {
+  if (!r.left) return;
+  if (n >= r.left) {
+    ramp_set(r, r.to);
+  } else {
+    r.gain += r.step * (int32_t)n;
+    r.left -= n;
+  }
+}
+
+// acc += buf * gain, ramping as it goes
+static void accumulate(Ramp &r, int32_t *acc, const int16_t *buf, uint32_t n) {
+  uint32_t i = 0;
+  for (; i < n && r.left; i++) {
+    acc[i] += (buf[i] * (r.gain >> 15)) >> 15;
+    r.gain += r.step;
+    if (--r.left == 0) r.gain = (int32_t)r.to << 15;
+  }
+  int32_t g = r.gain >> 15;
+  if (g == MIXER_UNITY) {
+    for (; i < n; i++) acc[i] += buf[i];
+  } else if (g) {
+    for (; i < n; i++) acc[i] += (buf[i] * g) >> 15;
+  }
+}
+
+void mixer_init(uint32_t sample_rate) {
+  rate = sample_rate;
+  for (uint8_t c = 0; c < MIXER_CHANNELS; c++) {
+    channels[c].target = MIXER_UNITY;
+    channels[c].ramp_ms = MIXER_RAMP_MS;
+    ramp_set(channels[c].ramp, MIXER_UNITY);
+  }
+  ramp_set(master, master_target);
+  ducked = duck_ramped = false;
+  hold_left = 0;
+}
+
+void mixer_set_gain(uint8_t channel, uint16_t gain, uint16_t ramp_ms) {
+  if (channel >= MIXER_CHANNELS) return;
+  if (gain > MIXER_UNITY) gain = MIXER_UNITY;
+  channels[channel].ramp_ms = ramp_ms;
+  channels[channel].target = gain;
+}
+
+uint16_t mixer_gain(uint8_t channel) {
+  return channel < MIXER_CHANNELS ? channels[channel].target : 0;
+}
+
+void mixer_set_master(uint16_t gain, uint16_t ramp_ms) {
+  if (gain > MIXER_UNITY) gain = MIXER_UNITY;
+  master_ramp_ms = ramp_ms;
+  master_target = gain;
+}
+
+uint16_t mixer_master() {
+  return master_target;
+}
+
+void mixer_set_duck(uint8_t channel, uint8_t trigger_mask, uint16_t depth,
+                    uint16_t attack_ms, uint16_t hold_ms, uint16_t release_ms) {
+  duck_attack_ms = attack_ms;
+  duck_hold_ms = hold_ms;
+  duck_release_ms = release_ms;
+  duck_depth = depth > MIXER_UNITY ? MIXER_UNITY : depth;
+  duck_mask = trigger_mask & ~(1u << channel);
+  duck_channel = channel;
+}
+
+bool mixer_ducking() {
+  return ducked;
+}
+
+// Render one channel and add it in; true if it made sound
+static bool mix_channel(uint8_t c, int32_t *acc, int16_t *tmp, uint32_t n, MixerRenderFn render) {
+  Channel &ch = channels[c];
+  uint16_t t = ch.target;
+  uint16_t ms = ch.ramp_ms;
+  if (c == duck_channel) {
+    if (ducked) t = (uint16_t)(((uint32_t)t * duck_depth) >> 15);
+    if (ducked != duck_ramped) ms = ducked ? duck_attack_ms : duck_release_ms;
+  }
+  if (t != ch.ramp.to) {
+    ramp_start(ch.ramp, t, ms);
+    if (c == duck_channel) duck_ramped = ducked;
+  }
+
+  if (!render(c, tmp, n)) {
+    ramp_skip(ch.ramp, n);
+    return false;
+  }
+  accumulate(ch.ramp, acc, tmp, n);
+  return true;
+}
+
+bool mixer_mix(int16_t *out, uint32_t frames, MixerRenderFn render) {
+  int32_t acc[CHUNK];
+  int16_t tmp[CHUNK];
+  bool any = false;
+
+  for (uint32_t done = 0; done < frames; done += CHUNK) {
+    uint32_t n = frames - done < CHUNK ? frames - done : CHUNK;
+    memset(acc, 0, n * sizeof(int32_t));
+    bool chunk_sound = false, trigger = false;
+
+    // Everything but the ducked channel first, so the duck decision is current
+    for (uint8_t c = 0; c < MIXER_CHANNELS; c++) {
+      if (c == duck_channel) continue;
+      if (mix_channel(c, acc, tmp, n, render)) {
+        chunk_sound = true;
+        if (duck_mask & (1u << c)) trigger = true;
+      }
+    }
+    if (trigger) {
+      ducked = true;
+      hold_left = ms_to_samples(duck_hold_ms);
+    } else if (ducked) {
+      if (hold_left > n) hold_left -= n;
+      else ducked = false;
+    }
+    if (duck_channel < MIXER_CHANNELS && mix_channel(duck_channel, acc, tmp, n, render)) chunk_sound = true;
+
+    if (master_target != master.to) ramp_start(master, master_target, master_ramp_ms);
+    if (!chunk_sound) {
+      ramp_skip(master, n);
+      memset(out + done, 0, n * sizeof(int16_t));
+      continue;
+    }
+    any = true;
+    for (uint32_t i = 0; i < n; i++) {
+      int32_t s = (int32_t)(((int64_t)acc[i] * (master.gain >> 15)) >> 15);
+      out[done + i] = s > 32767 ? 32767 : (s < -32768 ? -32768 : s);
+      if (master.left) {
+        master.gain += master.step;
+        if (--master.left == 0) master.gain = (int32_t)master.to << 15;
+      }
+    }
+  }
+  return any;
+}
@@ -0,0 +1,48 @@
+/*
+ * Mixer.h - Channel mixer with gain ramps and ducking
+ *
+ * MIXER_CHANNELS channels are rendered separately (through one callback,
+ * by channel number) and summed in 32 bits. Each channel gets its own
+ * gain, then the master gain is applied and the result saturated to int16
+ * once per sample. Every gain change is a linear ramp, so volume, mute
+ * and ducking never click. Gains are plain targets that the render side
+ * picks up at its next call, so setting one from loop() needs no lock.
+ *
+ * One channel (music) can be ducked: while any of its trigger channels
+ * is making sound it is pulled down to a set depth, and once they have
+ * been silent for the hold time it is released back up.
+ * Trigger channels render first, so ducking starts in the same block as
+ * the sound that causes it.
+ *
+ * No Arduino dependencies. Not reentrant.
+ */
+
+#ifndef MIXER_H
+#define MIXER_H
+
+#include <stdint.h>
+
+#define MIXER_CHANNELS   4
+#define MIXER_UNITY      32767
+#define MIXER_RAMP_MS    20          // default gain ramp
+
+// Render frames for channel into buf; false (buf untouched) if silent
+typedef bool (*MixerRenderFn)(uint8_t channel, int16_t *buf, uint32_t frames);
+
+void mixer_init(uint32_t sample_rate);
+
+// Q15 gains, reached by a linear ramp over ramp_ms
+void mixer_set_gain(uint8_t channel, uint16_t gain, uint16_t ramp_ms = MIXER_RAMP_MS);
+uint16_t mixer_gain(uint8_t channel);
+void mixer_set_master(uint16_t gain, uint16_t ramp_ms = MIXER_RAMP_MS);
+uint16_t mixer_master();
+
+// Duck channel to depth (Q15) while any channel in trigger_mask sounds
+void mixer_set_duck(uint8_t channel, uint8_t trigger_mask, uint16_t depth,
+                    uint16_t attack_ms, uint16_t hold_ms, uint16_t release_ms);
+bool mixer_ducking();
+
+// Mix every channel into out (always written); false if nothing sounded
+bool mixer_mix(int16_t *out, uint32_t frames, MixerRenderFn render);
+
+#endif // MIXER_H
@@ -13,38 +13,23 @@
 #include "QMI8658.h"   // <-- IMU for tap-to-wake
 #include <math.h>
 #include "GameAudio.h"
-
-// ---------- AXP2101 Battery Management ----------
-#define AXP2101_SLAVE_ADDRESS    0x34
-#define AXP2101_BAT_PERCENT      0xA4
-#define AXP2101_TEMP_H           0x5C
-#define AXP2101_TEMP_L           0x5D
-#define AXP2101_STATUS2          0x01
-#define AXP2101_ADC_CTRL         0x30
-
-uint8_t get_battery_percentage() {
-    uint8_t percent = DEV_I2C_Read_Byte(AXP2101_SLAVE_ADDRESS, AXP2101_BAT_PERCENT);
-    if (percent > 100) percent = 100;
-    return percent;
-}
-
-float get_temperature() {
-    uint8_t h = DEV_I2C_Read_Byte(AXP2101_SLAVE_ADDRESS, AXP2101_TEMP_H);
-    uint8_t l = DEV_I2C_Read_Byte(AXP2101_SLAVE_ADDRESS, AXP2101_TEMP_L);
-    uint16_t raw = ((h & 0x3F) << 8) | l;
-    return raw * 0.1f - 267.5f; // Returns temperature in Celsius
-}
-
-bool is_charging() {
-    uint8_t status = DEV_I2C_Read_Byte(AXP2101_SLAVE_ADDRESS, AXP2101_STATUS2);
-    return (status >> 5) == 0x01;
-}
-
-void init_axp2101() {
-    // Enable ADC for battery and temperature monitoring
-    uint8_t adc_ctrl = DEV_I2C_Read_Byte(AXP2101_SLAVE_ADDRESS, AXP2101_ADC_CTRL);
-    DEV_I2C_Write_Byte(AXP2101_SLAVE_ADDRESS, AXP2101_ADC_CTRL, adc_ctrl | 0x11);
-}
+#include "AudioOut.h"
+#include "AudioIn.h"
+#include "Spectrum.h"
+#include "Tracker.h"
+#include "DemoSong.h"
+#include "TapDetector.h"
+#include "ImuTrace.h"
+#include "Sensors.h"
+#include "EnergyProfiler.h"
+#include "ClockGovernor.h"
+#include "hardware/clocks.h"
+#include "RtcClock.h"
+#include "Alarms.h"
+#include "Timeline.h"
+#include "Config.h"
+#include "AssetPack.h"
+#include "Game.h"
 
 // ---------- Custom RNG to avoid hardware conflicts ----------
 static unsigned long rng_seed = 1;
@@ -68,16 +53,16 @@ enum VButton : uint8_t { BTN_UP, BTN_SELECT, BTN_DOWN, BTN_BACK };
 enum Screen  : uint8_t { 
   SCR_WATCHFACE, SCR_MENU, SCR_APP, SCR_TL_PAST, SCR_TL_FUTURE, 
   SCR_SETTINGS_MENU, SCR_SET_TIME, SCR_SET_DATE, SCR_SETTINGS_ABOUT,
-  SCR_GAMES_MENU, SCR_GAME_ARCADE, SCR_GAME_TAMAGOTCHI
+  SCR_GAMES_MENU, SCR_GAME_ARCADE, SCR_GAME_TAMAGOTCHI, SCR_SETTINGS_ENERGY,
+  SCR_ALARMS, SCR_ALARM_EDIT, SCR_ALARM_RING, SCR_SPECTRUM, SCR_MUSIC
 };
 
 // Game state enums
-enum GameState { GAME_MENU, ASTEROIDS, TETRIS, SNAKE, BREAKOUT };
 enum PetMood { HAPPY, NEUTRAL, SAD, SICK, SLEEPING };
 enum PetStage { EGG, BABY, CHILD, TEEN, ADULT };
 enum GameScreen { PET_MAIN, PET_STATS, PET_FEED, PET_TIME_SET };
 
-// Timeline card struct
+// Timeline seed card (first boot demo content)
 struct TLCard { 
   const char* title; 
   const char* subtitle; 
@@ -86,24 +71,6 @@ struct TLCard {
   uint8_t mm; 
 };
 
-// Game struct definitions - DEFINED BEFORE USE
-struct Ship { 
-  float x, y, angle, dx, dy; 
-  bool alive; 
-};
-
-struct Bullet { 
-  float x, y, dx, dy; 
-  bool active; 
-  uint32_t fired_time; 
-};
-
-struct Asteroid { 
-  float x, y, dx, dy, angle, spin; 
-  int size; 
-  bool active; 
-};
-
 struct Tamagotchi {
   char name[16];
   PetStage stage;
@@ -133,7 +100,17 @@ void Touch_INT_callback(uint gpio, uint32_t events);
 void draw_watchface();
 void open_watchface();
 void open_menu();
-void draw_tl_card(TLCard &card, bool is_past);
+void open_timeline(bool is_past);
+void draw_tl_card(bool is_past);
+void open_alarms();
+void draw_alarms();
+void open_alarm_edit(const Alarm &a);
+void draw_alarm_edit();
+void save_alarms();
+void open_music();
+void draw_music();
+void open_spectrum();
+void draw_spectrum_frame();
 
 // ---------- Framebuffer ----------
 UWORD *BlackImage = nullptr;
@@ -157,115 +134,46 @@ unsigned long last_dim_ms        = 0;
 const unsigned long DIM_INTERVAL = 15000;      // 15 seconds
 
 // ---------- IMU tap-to-wake (QMI8658, polling-based) ----------
-static float ax_f=0, ay_f=0, az_f=0;     // low-pass for gravity estimate
-static float hx=0, hy=0, hz=0;           // high-pass
-static uint32_t last_qmi_sample_ms = 0;
-
 const uint32_t QMI_POLL_MS   = 25;       // 40Hz polling
 const float    LPF_ALPHA     = 0.05f;    // moderate gravity tracking
 const float    HPF_ALPHA     = 0.95f;    // high-pass for impulses
 const float    TAP_G_THRESH  = 2.5f;     // lower threshold - easier to trigger
 const uint32_t TAP_DEBOUNCE  = 400;      // shorter debounce for better responsiveness
-static uint32_t last_tap_ms  = 0;
+const TapConfig TAP_CONFIG   = { LPF_ALPHA, HPF_ALPHA, TAP_G_THRESH, TAP_DEBOUNCE };
+static TapDetector tap_detector;
+
+// ---------- Clock governor ----------
+const uint32_t INPUT_BOOST_MS = 500;     // full speed for redraws after input
 
 // ---------- App State ----------
 Screen   current_screen = SCR_WATCHFACE;
 
-uint32_t last_tick_ms = 0;
-uint8_t  h = 12, m = 0;             // minutes only
-uint8_t  day = 23, month = 10;
-uint16_t year = 2025;
-
 bool     bt_connected    = true;
-uint8_t  battery_percent = 82;
-int8_t   temp_F          = 72;      // will be updated with live readings
 
 // ---------- Menu ----------
 const char* MENU_ITEMS[] = { "Music", "Alarms", "Weather", "Games", "Settings" };
 int MENU_COUNT = sizeof(MENU_ITEMS)/sizeof(MENU_ITEMS[0]);
 int menu_sel   = 0;
 
+// ---------- Music player ----------
+// The built-in demo, then any songs in the asset pack named music/0..music/7
+#define MUSIC_PACK_SLOTS 8
+
+struct MusicTrack {
+  const uint8_t *data;
+  uint32_t size;
+  char title[TRACKER_TITLE_LEN + 1];
+};
+
+MusicTrack music_tracks[1 + MUSIC_PACK_SLOTS];
+int music_count = 0;
+int music_sel = 0;   // music_count = the mic spectrum row
+
 // ---------- Games Menu ----------
 const char* GAMES_ITEMS[] = { "Arcade", "Tamagotchi" };
 int GAMES_COUNT = sizeof(GAMES_ITEMS)/sizeof(GAMES_ITEMS[0]);
 int games_sel = 0;
 
-// ---------- GAMES STATE ----------
-GameState current_game = GAME_MENU;
-bool game_over = false;
-int game_score = 0;
-int high_scores[4] = {0, 0, 0, 0}; // [asteroids, tetris, snake, breakout]
-
-// Game touch state
-uint16_t game_touch_x = 0, game_touch_y = 0;
-uint16_t game_touch_start_x = 0, game_touch_start_y = 0;
-uint32_t game_touch_start_time = 0;
-bool game_is_swiping = false;
-
-// ASTEROIDS game objects
-Ship ship;
-Bullet bullets[5];
-Asteroid asteroids[15];
-int asteroids_level = 1; // Track current level
-
-// TETRIS
-#define GRID_W 10
-#define GRID_H 20
-#define BLOCK_SIZE 18
-int tetris_grid[GRID_H][GRID_W];
-int tetris_current_piece[4][4];
-int tetris_current_type = 0;
-int tetris_next_type = 0;  // Next piece preview
-int tetris_piece_x = 3, tetris_piece_y = 0;
-uint32_t tetris_last_drop = 0;
-int tetris_drop_speed = 500;
-int tetris_lines_cleared = 0;
-bool tetris_piece_placed = false;
-
-const int tetris_pieces[7][4][4] = {
-  // I-piece
-  {{0,1,0,0},{0,1,0,0},{0,1,0,0},{0,1,0,0}},
-  // O-piece
-  {{1,1,0,0},{1,1,0,0},{0,0,0,0},{0,0,0,0}},
-  // S-piece
-  {{0,1,1,0},{1,1,0,0},{0,0,0,0},{0,0,0,0}},
-  // Z-piece
-  {{1,1,0,0},{0,1,1,0},{0,0,0,0},{0,0,0,0}},
-  // T-piece
-  {{1,1,1,0},{0,1,0,0},{0,0,0,0},{0,0,0,0}},
-  // L-piece
-  {{1,0,0,0},{1,0,0,0},{1,1,0,0},{0,0,0,0}},
-  // J-piece
-  {{0,1,0,0},{0,1,0,0},{1,1,0,0},{0,0,0,0}}
-};
-const uint16_t tetris_piece_colors[7] = {0x7FFF, 0xFFE0, 0x07E0, 0xF800, 0xF81F, 0xFD20, 0x001F};
-
-// SNAKE
-#define SNAKE_MAX_LENGTH 100
-#define SNAKE_GRID_SIZE 12
-#define SNAKE_GRID_W 20  // Fixed size instead of calculated
-#define SNAKE_GRID_H 30  // Fixed size instead of calculated
-int snake_x[SNAKE_MAX_LENGTH], snake_y[SNAKE_MAX_LENGTH];
-int snake_length = 4;
-int snake_dir = 0; // 0=right, 1=down, 2=left, 3=up
-int snake_food_x, snake_food_y;
-uint32_t snake_last_move = 0;
-int snake_speed = 300; // milliseconds between moves
-
-// BREAKOUT
-#define BRICK_ROWS 6
-#define BRICK_COLS 8
-#define BRICK_W 25
-#define BRICK_H 12
-bool bricks[BRICK_ROWS][BRICK_COLS];
-float ball_x, ball_y, ball_dx, ball_dy;
-float paddle_x;
-int paddle_y = 400;
-int paddle_w = 60;
-int paddle_h = 8;
-int ball_radius = 4;
-int bricks_remaining = 0;
-
 // ---------- TAMAGOTCHI STATE ----------
 Tamagotchi pet;
 
@@ -290,15 +198,33 @@ int settings_sel = 0;
 
 // set-time editing state
 int set_time_field = 0; // 0=hour,1=min
+uint8_t set_hour = 12, set_minute = 0; // edited copy, written to the RTC on BACK
 bool set_time_dirty = false;
 uint32_t last_time_button_press = 0; // Track when buttons were last pressed
 
 // set-date editing state
 int set_date_field = 0; // 0=day,1=month,2=year
+uint8_t  set_day = 1, set_month = 1;  // edited copy, written to the RTC on BACK
+uint16_t set_year = 2025;
 bool set_date_dirty = false;
 uint32_t last_date_button_press = 0; // Track when buttons were last pressed
 
-// ---------- Timeline demo ----------
+// ---------- Alarms ----------
+int alarms_sel = 0;                 // alarm/timer rows, then "+ Alarm", "+ Timer"
+const uint32_t QUICK_TIMER_S = 5 * 60;
+const uint8_t REPEAT_PRESETS[] = { ALARM_ONCE, ALARM_DAILY, ALARM_WEEKDAYS, ALARM_WEEKENDS };
+const int REPEAT_PRESET_COUNT = sizeof(REPEAT_PRESETS)/sizeof(REPEAT_PRESETS[0]);
+
+// alarm editing state (copy, applied on BACK)
+int     alarm_edit_field = 0;       // 0=hour,1=min,2=repeat,3=on/off,4=delete
+uint8_t alarm_edit_id = 0;
+uint8_t alarm_edit_hour = 7, alarm_edit_minute = 0;
+int     alarm_edit_repeat = 1;      // index into REPEAT_PRESETS
+bool    alarm_edit_enabled = true;
+bool    alarm_edit_delete = false;
+
+// ---------- Timeline (events live in flash, see Timeline.h) ----------
+// Demo events written to the store on first boot, relative to today
 TLCard TL_PAST[] = {
   {"Email",   "Boss",      "Follow up on Q4 OKRs.", 9,  10},
   {"Meeting", "Daily Sync","Notes saved to Drive.", 10, 30},
@@ -311,7 +237,8 @@ TLCard TL_FUT[] = {
 };
 int TL_PAST_N = sizeof(TL_PAST)/sizeof(TL_PAST[0]);
 int TL_FUT_N  = sizeof(TL_FUT)/sizeof(TL_FUT[0]);
-int tl_idx    = 0;
+int tl_idx    = 0;       // index into the time-sorted store
+int tl_now    = 0;       // first event at or after now (past/future split)
 
 // ---------- Theme / Colors ----------
 struct Theme { uint16_t bg, time, muted, panel, frame, accent; };
@@ -402,6 +329,17 @@ void draw_big_time_centered(int center_x, int base_y, uint8_t hh, uint8_t mm, ui
 }
 
 // ---------- Right-side complications (rectangles around each widget) ----------
+// Font20 unless the asset pack provides "complication" (pinned, drawn every minute)
+sFONT complication_font = Font20;
+
+void load_assets() {
+  if (!asset_pack_init()) return;
+  if (asset_font(ASSET_ID("complication"), &complication_font)) {
+    asset_pin(ASSET_ID("complication"));
+    asset_font(ASSET_ID("complication"), &complication_font);   // point at the SRAM copy
+  }
+}
+
 void draw_right_complications(int startY) {
   const int margin = 10;
   const int widget_width = 60;
@@ -413,36 +351,43 @@ void draw_right_complications(int startY) {
   // 1) Bluetooth widget with rectangle
   if (bt_connected) {
     Paint_DrawRectangle(x, y, x + widget_width, y + widget_height, CASIO_GREEN, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
-    Paint_DrawString_EN(x + 18, y + 8, "BT", &Font20, CASIO_GREEN, THEMES[theme_idx].bg);
+    Paint_DrawString_EN(x + 18, y + 8, "BT", &complication_font, CASIO_GREEN, THEMES[theme_idx].bg);
   }
   y += widget_spacing;
 
   // 2) Battery widget with rectangle - keep % on same line
   char bat_str[8];
-  snprintf(bat_str, sizeof(bat_str), "%d%%", battery_percent);
+  const SensorReading &bat = sensor_hub_get(SENSOR_BATTERY_PERCENT);
+  if (bat.version) snprintf(bat_str, sizeof(bat_str), "%d%%", (int)bat.v[0]);
+  else strcpy(bat_str, "--%");
   Paint_DrawRectangle(x, y, x + widget_width, y + widget_height, CASIO_GREEN, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
-  int bat_text_width = strlen(bat_str) * 10; // Approximate width for Font20
+  int bat_text_width = strlen(bat_str) * complication_font.Width;
   int bat_text_x = x + (widget_width - bat_text_width) / 2; // Center the text
-  Paint_DrawString_EN(bat_text_x, y + 8, bat_str, &Font20, CASIO_GREEN, THEMES[theme_idx].bg);
+  Paint_DrawString_EN(bat_text_x, y + 8, bat_str, &complication_font, CASIO_GREEN, THEMES[theme_idx].bg);
   y += widget_spacing;
 
   // 3) Temperature widget with rectangle and F suffix
   char temp_str[8];
-  int display_temp = abs(temp_F);
-  snprintf(temp_str, sizeof(temp_str), "%dF", display_temp);
+  const SensorReading &temp = sensor_hub_get(SENSOR_PMIC_TEMP);
+  if (temp.version) {
+    int8_t temp_F = (int8_t)(temp.v[0] * 9.0f / 5.0f + 32.0f);
+    snprintf(temp_str, sizeof(temp_str), "%dF", abs(temp_F));
+  } else {
+    strcpy(temp_str, "--F");
+  }
   Paint_DrawRectangle(x, y, x + widget_width, y + widget_height, CASIO_GREEN, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
-  int temp_text_width = strlen(temp_str) * 10; // Approximate width for Font20
+  int temp_text_width = strlen(temp_str) * complication_font.Width;
   int temp_text_x = x + (widget_width - temp_text_width) / 2; // Center the text
-  Paint_DrawString_EN(temp_text_x, y + 8, temp_str, &Font20, CASIO_GREEN, THEMES[theme_idx].bg);
+  Paint_DrawString_EN(temp_text_x, y + 8, temp_str, &complication_font, CASIO_GREEN, THEMES[theme_idx].bg);
   y += widget_spacing;
 
   // 4) Date widget with rectangle
   char date_str[8];
-  snprintf(date_str, sizeof(date_str), "%d", day);
+  snprintf(date_str, sizeof(date_str), "%d", rtc_clock_now().day);
   Paint_DrawRectangle(x, y, x + widget_width, y + widget_height, CASIO_GREEN, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
-  int date_text_width = strlen(date_str) * 10; // Approximate width for Font20
+  int date_text_width = strlen(date_str) * complication_font.Width;
   int date_text_x = x + (widget_width - date_text_width) / 2; // Center the text
-  Paint_DrawString_EN(date_text_x, y + 8, date_str, &Font20, CASIO_GREEN, THEMES[theme_idx].bg);
+  Paint_DrawString_EN(date_text_x, y + 8, date_str, &complication_font, CASIO_GREEN, THEMES[theme_idx].bg);
 }
 
 // ---------- Memory Usage Display ----------
@@ -457,753 +402,36 @@ void get_memory_info(char* flash_str, char* ram_str) {
   snprintf(ram_str, 32, "RAM: ~%ldKB / %ldKB", estimated_ram_kb, total_ram_kb);
 }
 
-// ---------- GAME IMPLEMENTATIONS ----------
-
-// ======== TETRIS GAME ========
-void init_tetris() {
-  game_score = 0;
-  game_over = false;
-  tetris_lines_cleared = 0;
-  tetris_drop_speed = 500;
-  tetris_last_drop = millis();
-  tetris_piece_placed = false;
-  
-  // Clear grid
-  for(int y = 0; y < GRID_H; y++) {
-    for(int x = 0; x < GRID_W; x++) {
-      tetris_grid[y][x] = 0;
-    }
-  }
-  
-  // Spawn first piece
-  tetris_current_type = rng(7);
-  tetris_next_type = rng(7);  // Generate next piece
-  tetris_piece_x = 3;
-  tetris_piece_y = 0;
-  
-  // Copy piece pattern
-  for(int y = 0; y < 4; y++) {
-    for(int x = 0; x < 4; x++) {
-      tetris_current_piece[y][x] = tetris_pieces[tetris_current_type][y][x];
-    }
-  }
-}
-
-bool tetris_can_place_piece(int px, int py, int piece[4][4]) {
-  for(int y = 0; y < 4; y++) {
-    for(int x = 0; x < 4; x++) {
-      if(piece[y][x]) {
-        int nx = px + x;
-        int ny = py + y;
-        if(nx < 0 || nx >= GRID_W || ny >= GRID_H) return false;
-        if(ny >= 0 && tetris_grid[ny][nx]) return false;
-      }
-    }
-  }
-  return true;
-}
-
-void tetris_place_piece() {
-  for(int y = 0; y < 4; y++) {
-    for(int x = 0; x < 4; x++) {
-      if(tetris_current_piece[y][x]) {
-        int nx = tetris_piece_x + x;
-        int ny = tetris_piece_y + y;
-        if(ny >= 0 && ny < GRID_H && nx >= 0 && nx < GRID_W) {
-          tetris_grid[ny][nx] = tetris_current_type + 1;
-        }
-      }
-    }
-  }
-}
-
-void tetris_clear_lines() {
-  int lines = 0;
-  for(int y = GRID_H - 1; y >= 0; y--) {
-    bool full = true;
-    for(int x = 0; x < GRID_W; x++) {
-      if(!tetris_grid[y][x]) {
-        full = false;
-        break;
-      }
-    }
-    if(full) {
-      lines++;
-      // Move everything down
-      for(int move_y = y; move_y > 0; move_y--) {
-        for(int x = 0; x < GRID_W; x++) {
-          tetris_grid[move_y][x] = tetris_grid[move_y - 1][x];
-        }
-      }
-      // Clear top line
-      for(int x = 0; x < GRID_W; x++) {
-        tetris_grid[0][x] = 0;
-      }
-      y++; // Check same line again
-    }
-  }
-  
-  if(lines > 0) {
-    tetris_lines_cleared += lines;
-    game_score += lines * 100;
-    if(tetris_lines_cleared >= 10) {
-      tetris_drop_speed = max(100, tetris_drop_speed - 50);
-      tetris_lines_cleared = 0;
-    }
-  }
-}
-
-void tetris_rotate_piece() {
-  int temp[4][4];
-  // Rotate counter-clockwise: temp[i][j] = current_piece[j][3-i]
-  for(int i = 0; i < 4; i++) {
-    for(int j = 0; j < 4; j++) {
-      temp[i][j] = tetris_current_piece[3-j][i];
-    }
-  }
-  
-  // Try original position first
-  if(tetris_can_place_piece(tetris_piece_x, tetris_piece_y, temp)) {
-    memcpy(tetris_current_piece, temp, sizeof(temp));
-    return;
-  }
-  
-  // Try wall kicks - push piece away from walls if needed
-  int kick_offsets[][2] = {{-1, 0}, {1, 0}, {-2, 0}, {2, 0}, {0, -1}};
-  for(int i = 0; i < 5; i++) {
-    int new_x = tetris_piece_x + kick_offsets[i][0];
-    int new_y = tetris_piece_y + kick_offsets[i][1];
-    if(tetris_can_place_piece(new_x, new_y, temp)) {
-      tetris_piece_x = new_x;
-      tetris_piece_y = new_y;
-      memcpy(tetris_current_piece, temp, sizeof(temp));
-      return;
-    }
-  }
-  
-  // If no valid position found, don't rotate (piece stays as is)
-}
-
-void tetris_spawn_new_piece() {
-  // Use the next piece as current
-  tetris_current_type = tetris_next_type;
-  // Generate new next piece
-  tetris_next_type = rng(7);
-  
-  tetris_piece_x = 3;
-  tetris_piece_y = 0;
-  
-  for(int y = 0; y < 4; y++) {
-    for(int x = 0; x < 4; x++) {
-      tetris_current_piece[y][x] = tetris_pieces[tetris_current_type][y][x];
-    }
-  }
-  
-  if(!tetris_can_place_piece(tetris_piece_x, tetris_piece_y, tetris_current_piece)) {
-    game_over = true;
-    if(game_score > high_scores[1]) high_scores[1] = game_score;
-  }
-}
-
-void update_tetris() {
-  if(game_over) return;
-  
-  uint32_t now = millis();
-  if(now - tetris_last_drop > tetris_drop_speed) {
-    tetris_last_drop = now;
-    
-    if(tetris_can_place_piece(tetris_piece_x, tetris_piece_y + 1, tetris_current_piece)) {
-      tetris_piece_y++;
-    } else {
-      tetris_place_piece();
-      tetris_clear_lines();
-      tetris_spawn_new_piece();
-    }
-  }
-}
-
-void draw_tetris_game() {
-  Paint_Clear(BLACK);
-  
-  if(game_over) {
-    Paint_DrawString_EN(60, 180, "GAME OVER", &Font24, 0xF800, BLACK);
-    char score_str[32];
-    sprintf(score_str, "Score: %d", game_score);
-    Paint_DrawString_EN(80, 210, score_str, &Font24, WHITE, BLACK);
-    sprintf(score_str, "High: %d", high_scores[1]);
-    Paint_DrawString_EN(80, 230, score_str, &Font24, WHITE, BLACK);
-    Paint_DrawString_EN(60, 260, "Touch to play again", &Font24, 0x7FFF, BLACK);
-    AMOLED_1IN8_Display(BlackImage);
-    return;
-  }
-  
-  // Draw playing field border - matching Games.txt layout
-  int grid_start_x = 64;
-  int grid_start_y = 40;
-  int grid_width = GRID_W * BLOCK_SIZE;
-  int grid_height = GRID_H * BLOCK_SIZE;
-  
-  // Draw outer border - simple single pixel border like Games.txt
-  Paint_DrawRectangle(grid_start_x - 2, grid_start_y - 2, 
-                      grid_start_x + grid_width + 2, grid_start_y + grid_height + 2, 
-                      WHITE, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
-  
-  // Draw grid cells - simple like Games.txt
-  for(int y = 0; y < GRID_H; y++) {
-    for(int x = 0; x < GRID_W; x++) {
-      if(tetris_grid[y][x]) {
-        int px = grid_start_x + x * BLOCK_SIZE;
-        int py = grid_start_y + y * BLOCK_SIZE;
-        uint16_t color = tetris_piece_colors[tetris_grid[y][x] - 1];
-        Paint_DrawRectangle(px, py, px + BLOCK_SIZE - 1, py + BLOCK_SIZE - 1, 
-                          color, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-      }
-    }
-  }
-  
-  // Draw current piece - simple solid blocks
-  uint16_t piece_color = tetris_piece_colors[tetris_current_type];
-  for(int y = 0; y < 4; y++) {
-    for(int x = 0; x < 4; x++) {
-      if(tetris_current_piece[y][x]) {
-        int px = grid_start_x + (tetris_piece_x + x) * BLOCK_SIZE;
-        int py = grid_start_y + (tetris_piece_y + y) * BLOCK_SIZE;
-        Paint_DrawRectangle(px, py, px + BLOCK_SIZE - 1, py + BLOCK_SIZE - 1, 
-                          piece_color, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-      }
-    }
-  }
-  
-  // Draw score at top like Games.txt
-  char score_str[32];
-  snprintf(score_str, sizeof(score_str), "Score:%d Hi:%d", game_score, high_scores[1]);
-  Paint_DrawString_EN(10, 10, score_str, &Font24, WHITE, BLACK);
-  
-  // Draw NEXT piece preview box on the right
-  int next_box_x = 260;
-  int next_box_y = 100;
-  int next_box_size = 80;
-  
-  // Draw "NEXT" label
-  Paint_DrawString_EN(next_box_x + 10, next_box_y - 30, "NEXT", &Font24, CYAN, BLACK);
-  
-  // Draw box border
-  Paint_DrawRectangle(next_box_x, next_box_y, next_box_x + next_box_size, next_box_y + next_box_size, 
-                     WHITE, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
-  
-  // Draw next piece in the center of the box (scaled to fit)
-  int piece_size = 16; // Smaller blocks for preview
-  uint16_t next_color = tetris_piece_colors[tetris_next_type];
-  
-  // Calculate centering offset for the piece
-  int piece_offset_x = next_box_x + 10;
-  int piece_offset_y = next_box_y + 10;
-  
-  for(int y = 0; y < 4; y++) {
-    for(int x = 0; x < 4; x++) {
-      if(tetris_pieces[tetris_next_type][y][x]) {
-        int px = piece_offset_x + x * piece_size;
-        int py = piece_offset_y + y * piece_size;
-        Paint_DrawRectangle(px, py, px + piece_size - 1, py + piece_size - 1, 
-                          next_color, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-      }
-    }
-  }
-  
-  // Draw controls at bottom like Games.txt
-  Paint_DrawString_EN(10, 460, "L:Left M:Rotate R:Right", &Font24, GRAY, BLACK);
-  
-  AMOLED_1IN8_Display(BlackImage);
-}
-
-// ======== SNAKE GAME ========
-void init_snake() {
-  game_score = 0;
-  game_over = false;
-  snake_length = 4;
-  snake_dir = 0;
-  snake_speed = 300;
-  snake_last_move = millis();
-  
-  // Initialize snake in center with bounds checking
-  int start_x = max(4, SNAKE_GRID_W / 2);
-  int start_y = max(4, SNAKE_GRID_H / 2);
-  
-  for(int i = 0; i < snake_length && i < SNAKE_MAX_LENGTH; i++) {
-    snake_x[i] = start_x - i;
-    snake_y[i] = start_y;
-  }
-  
-  // Place food safely
-  do {
-    snake_food_x = rng(2, SNAKE_GRID_W - 2);
-    snake_food_y = rng(2, SNAKE_GRID_H - 2);
-  } while((snake_food_x == snake_x[0] && snake_food_y == snake_y[0]) && snake_food_x < SNAKE_GRID_W && snake_food_y < SNAKE_GRID_H);
-}
-
-bool snake_check_collision(int x, int y) {
-  // Check walls
-  if(x < 0 || x >= SNAKE_GRID_W || y < 0 || y >= SNAKE_GRID_H) return true;
-  
-  // Check self collision
-  for(int i = 0; i < snake_length; i++) {
-    if(snake_x[i] == x && snake_y[i] == y) return true;
-  }
-  
-  return false;
-}
-
-void update_snake() {
-  if(game_over) return;
-  
-  uint32_t now = millis();
-  if(now - snake_last_move < snake_speed) return;
-  snake_last_move = now;
-  
-  // Calculate new head position
-  int new_x = snake_x[0];
-  int new_y = snake_y[0];
-  
-  switch(snake_dir) {
-    case 0: new_x++; break; // right
-    case 1: new_y++; break; // down
-    case 2: new_x--; break; // left
-    case 3: new_y--; break; // up
-  }
-  
-  // Check collision
-  if(snake_check_collision(new_x, new_y)) {
-    game_over = true;
-    if(game_score > high_scores[2]) high_scores[2] = game_score;
-    return;
-  }
-  
-  // Check food
-  bool ate_food = (new_x == snake_food_x && new_y == snake_food_y);
-  
-  if(ate_food) {
-    game_score += 10;
-    snake_length++;
-    snake_speed = max(100, snake_speed - 5);
-    
-    // Place new food
-    do {
-      snake_food_x = rng(SNAKE_GRID_W);
-      snake_food_y = rng(SNAKE_GRID_H);
-    } while(snake_check_collision(snake_food_x, snake_food_y));
-  }
-  
-  // Move snake
-  for(int i = snake_length - 1; i > 0; i--) {
-    snake_x[i] = snake_x[i-1];
-    snake_y[i] = snake_y[i-1];
-  }
-  snake_x[0] = new_x;
-  snake_y[0] = new_y;
-  
-  if(!ate_food && snake_length > 0) {
-    snake_length--; // Don't grow tail if no food eaten
-    snake_length++; // Restore length (effectively moves tail)
-  }
-}
-
-void draw_snake_game() {
-  Paint_Clear(BLACK);
-  
-  if(game_over) {
-    Paint_DrawString_EN(60, 180, "GAME OVER", &Font24, 0xF800, BLACK);
-    char score_str[32];
-    sprintf(score_str, "Score: %d", game_score);
-    Paint_DrawString_EN(80, 210, score_str, &Font24, WHITE, BLACK);
-    sprintf(score_str, "High: %d", high_scores[2]);
-    Paint_DrawString_EN(80, 230, score_str, &Font24, WHITE, BLACK);
-    Paint_DrawString_EN(60, 260, "Touch to play again", &Font24, 0x7FFF, BLACK);
-    AMOLED_1IN8_Display(BlackImage);
-    return;
-  }
-  
-  // Draw border
-  Paint_DrawRectangle(0, 0, AMOLED_1IN8_WIDTH-1, AMOLED_1IN8_HEIGHT-1, WHITE, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
-  
-  // Draw snake
-  for(int i = 0; i < snake_length; i++) {
-    int x = snake_x[i] * SNAKE_GRID_SIZE;
-    int y = snake_y[i] * SNAKE_GRID_SIZE;
-    uint16_t color = (i == 0) ? 0x07E0 : 0x07C0; // Head brighter
-    Paint_DrawRectangle(x, y, x + SNAKE_GRID_SIZE - 1, y + SNAKE_GRID_SIZE - 1, color, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-  }
-  
-  // Draw food
-  int fx = snake_food_x * SNAKE_GRID_SIZE;
-  int fy = snake_food_y * SNAKE_GRID_SIZE;
-  Paint_DrawRectangle(fx, fy, fx + SNAKE_GRID_SIZE - 1, fy + SNAKE_GRID_SIZE - 1, 0xF800, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-  
-  // Draw score
-  char score_str[32];
-  sprintf(score_str, "Score: %d", game_score);
-  Paint_DrawString_EN(5, 5, score_str, &Font12, WHITE, BLACK);
-  
-  AMOLED_1IN8_Display(BlackImage);
-}
-
-// ======== BREAKOUT GAME ========
-void init_breakout() {
-  game_score = 0;
-  game_over = false;
-  bricks_remaining = 0;
-  
-  // Initialize bricks
-  for(int row = 0; row < BRICK_ROWS; row++) {
-    for(int col = 0; col < BRICK_COLS; col++) {
-      bricks[row][col] = true;
-      bricks_remaining++;
-    }
-  }
-  
-  // Initialize ball
-  ball_x = AMOLED_1IN8_WIDTH / 2;
-  ball_y = 300;
-  ball_dx = 2;
-  ball_dy = -3;
-  
-  // Initialize paddle
-  paddle_x = (AMOLED_1IN8_WIDTH - paddle_w) / 2;
-}
-
-void update_breakout() {
-  if(game_over) return;
-  
-  // Move ball
-  ball_x += ball_dx;
-  ball_y += ball_dy;
-  
-  // Ball collision with walls
-  if(ball_x <= ball_radius || ball_x >= AMOLED_1IN8_WIDTH - ball_radius) {
-    ball_dx = -ball_dx;
-  }
-  if(ball_y <= ball_radius) {
-    ball_dy = -ball_dy;
-  }
-  
-  // Ball hits bottom - game over
-  if(ball_y >= AMOLED_1IN8_HEIGHT - ball_radius) {
-    game_over = true;
-    if(game_score > high_scores[3]) high_scores[3] = game_score;
-    return;
-  }
-  
-  // Ball collision with paddle
-  if(ball_y + ball_radius >= paddle_y && ball_y - ball_radius <= paddle_y + paddle_h &&
-     ball_x >= paddle_x && ball_x <= paddle_x + paddle_w) {
-    ball_dy = -abs(ball_dy); // Always bounce up
-    // Add some angle based on where it hit the paddle
-    float hit_pos = (ball_x - paddle_x) / paddle_w; // 0 to 1
-    ball_dx = (hit_pos - 0.5f) * 4; // -2 to +2
-  }
-  
-  // Ball collision with bricks
-  int brick_start_y = 50;
-  for(int row = 0; row < BRICK_ROWS; row++) {
-    for(int col = 0; col < BRICK_COLS; col++) {
-      if(!bricks[row][col]) continue;
-      
-      int brick_x = col * (AMOLED_1IN8_WIDTH / BRICK_COLS);
-      int brick_y = brick_start_y + row * BRICK_H;
-      
-      if(ball_x + ball_radius >= brick_x && ball_x - ball_radius <= brick_x + BRICK_W &&
-         ball_y + ball_radius >= brick_y && ball_y - ball_radius <= brick_y + BRICK_H) {
-        bricks[row][col] = false;
-        bricks_remaining--;
-        game_score += 10;
-        ball_dy = -ball_dy;
-        
-        if(bricks_remaining == 0) {
-          // Level complete - could restart with faster ball
-          init_breakout();
-          ball_dx *= 1.2f;
-          ball_dy *= 1.2f;
-        }
-        break;
-      }
-    }
-  }
-}
-
-void draw_breakout_game() {
-  Paint_Clear(BLACK);
-  
-  if(game_over) {
-    Paint_DrawString_EN(60, 180, "GAME OVER", &Font24, 0xF800, BLACK);
-    char score_str[32];
-    sprintf(score_str, "Score: %d", game_score);
-    Paint_DrawString_EN(80, 210, score_str, &Font24, WHITE, BLACK);
-    sprintf(score_str, "High: %d", high_scores[3]);
-    Paint_DrawString_EN(80, 230, score_str, &Font24, WHITE, BLACK);
-    Paint_DrawString_EN(60, 260, "Touch to play again", &Font24, 0x7FFF, BLACK);
-    AMOLED_1IN8_Display(BlackImage);
-    return;
-  }
-  
-  // Draw bricks
-  int brick_start_y = 50;
-  uint16_t brick_colors[] = {0xF800, 0xFCA0, 0xFFE0, 0x07E0, 0x001F, 0xF81F}; // Different colors per row
-  
-  for(int row = 0; row < BRICK_ROWS; row++) {
-    for(int col = 0; col < BRICK_COLS; col++) {
-      if(!bricks[row][col]) continue;
-      
-      int brick_x = col * (AMOLED_1IN8_WIDTH / BRICK_COLS);
-      int brick_y = brick_start_y + row * BRICK_H;
-      uint16_t color = brick_colors[row % 6];
-      
-      Paint_DrawRectangle(brick_x, brick_y, brick_x + BRICK_W - 2, brick_y + BRICK_H - 1, color, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-    }
-  }
-  
-  // Draw paddle
-  Paint_DrawRectangle(paddle_x, paddle_y, paddle_x + paddle_w, paddle_y + paddle_h, WHITE, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-  
-  // Draw ball
-  Paint_DrawCircle(ball_x, ball_y, ball_radius, WHITE, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-  
-  // Draw score
-  char score_str[32];
-  sprintf(score_str, "Score: %d", game_score);
-  Paint_DrawString_EN(5, 5, score_str, &Font12, WHITE, BLACK);
-  
-  // Draw remaining bricks count
-  sprintf(score_str, "Bricks: %d", bricks_remaining);
-  Paint_DrawString_EN(5, 20, score_str, &Font12, WHITE, BLACK);
-  
-  AMOLED_1IN8_Display(BlackImage);
-}
-
-// ======== ASTEROIDS (EXISTING) ========
-void init_asteroids() {
-  game_score = 0;
-  game_over = false;
-  ship.x = 184.0f; 
-  ship.y = 260.0f; 
-  ship.angle = -90.0f;
-  ship.dx = 0.0f; 
-  ship.dy = 0.0f; 
-  ship.alive = true;
-  
-  for(int i = 0; i < 5; i++) bullets[i].active = false;
-  for(int i = 0; i < 15; i++) asteroids[i].active = false;
-  
-  // Initialize asteroids based on level - start with 4, add 1 per level, max 10
-  int num_asteroids = min(3 + asteroids_level, 10);
-  for(int i = 0; i < num_asteroids; i++) {
-    asteroids[i].active = true; 
-    asteroids[i].size = 2;
-    asteroids[i].x = rng(50, 318); 
-    asteroids[i].y = rng(50, 430);
-    asteroids[i].dx = (rng(0, 100) / 50.0f) - 1.0f;
-    asteroids[i].dy = (rng(0, 100) / 50.0f) - 1.0f;
-    asteroids[i].angle = rng(0, 360);
-    asteroids[i].spin = (rng(0, 100) / 100.0f) - 0.5f;
-  }
-}
-
-void update_asteroids() {
-  if(game_over || !ship.alive) return;
-  
-  // Check if all asteroids destroyed - advance to next level
-  bool any_active = false;
-  for(int i = 0; i < 15; i++) {
-    if(asteroids[i].active) {
-      any_active = true;
-      break;
-    }
-  }
-  if(!any_active) {
-    // Level complete! Advance to next level
-    asteroids_level++;
-    init_asteroids();
-    return;
-  }
-  
-  // Update ship physics with simple drag
-  ship.dx *= 0.98f;
-  ship.dy *= 0.98f;
-  ship.x += ship.dx;
-  ship.y += ship.dy;
-  
-  // Wrap ship around screen
-  if(ship.x < 0) ship.x = AMOLED_1IN8_WIDTH;
-  if(ship.x > AMOLED_1IN8_WIDTH) ship.x = 0;
-  if(ship.y < 0) ship.y = AMOLED_1IN8_HEIGHT;
-  if(ship.y > AMOLED_1IN8_HEIGHT) ship.y = 0;
-  
-  // Update bullets
-  for(int i = 0; i < 5; i++) {
-    if(!bullets[i].active) continue;
-    bullets[i].x += bullets[i].dx;
-    bullets[i].y += bullets[i].dy;
-    
-    // Remove bullets that go off screen or are too old
-    if(bullets[i].x < 0 || bullets[i].x > AMOLED_1IN8_WIDTH ||
-       bullets[i].y < 0 || bullets[i].y > AMOLED_1IN8_HEIGHT ||
-       millis() - bullets[i].fired_time > 2000) {
-      bullets[i].active = false;
-    }
-  }
-  
-  // Update asteroids
-  for(int i = 0; i < 15; i++) {
-    if(!asteroids[i].active) continue;
-    asteroids[i].x += asteroids[i].dx;
-    asteroids[i].y += asteroids[i].dy;
-    asteroids[i].angle += asteroids[i].spin;
-    
-    // Wrap around screen
-    if(asteroids[i].x < 0) asteroids[i].x = AMOLED_1IN8_WIDTH;
-    if(asteroids[i].x > AMOLED_1IN8_WIDTH) asteroids[i].x = 0;
-    if(asteroids[i].y < 0) asteroids[i].y = AMOLED_1IN8_HEIGHT;
-    if(asteroids[i].y > AMOLED_1IN8_HEIGHT) asteroids[i].y = 0;
-  }
-  
-  // Check bullet-asteroid collisions - use actual radius like Games.txt
-  for(int b = 0; b < 5; b++) {
-    if(!bullets[b].active) continue;
-    for(int a = 0; a < 15; a++) {
-      if(!asteroids[a].active) continue;
-      int ar = (asteroids[a].size == 2) ? 20 : (asteroids[a].size == 1) ? 12 : 6;
-      float dx = bullets[b].x - asteroids[a].x;
-      float dy = bullets[b].y - asteroids[a].y;
-      float dist = sqrt(dx*dx + dy*dy);
-      if(dist < ar) {
-        bullets[b].active = false;
-        int old_size = asteroids[a].size;
-        float old_x = asteroids[a].x;
-        float old_y = asteroids[a].y;
-        asteroids[a].active = false;
-        game_score += (old_size + 1) * 10;
-        
-        // Split into smaller asteroids if not already smallest
-        if(old_size > 0) {
-          // Find two empty asteroid slots
-          int split_count = 0;
-          for(int i = 0; i < 15 && split_count < 2; i++) {
-            if(!asteroids[i].active) {
-              asteroids[i] = asteroids[a];
-              asteroids[i].size = old_size - 1;
-              asteroids[i].x = old_x + rng(-10, 10);
-              asteroids[i].y = old_y + rng(-10, 10);
-              asteroids[i].dx = -asteroids[a].dx + (rng(100) / 100.0f);
-              asteroids[i].dy = -asteroids[a].dy + (rng(100) / 100.0f);
-              asteroids[i].active = true;
-              split_count++;
-            }
-          }
-        }
-        break;
-      }
-    }
-  }
-  
-  // Check ship-asteroid collisions - use actual radius like Games.txt
-  for(int a = 0; a < 15; a++) {
-    if(!asteroids[a].active) continue;
-    int ar = (asteroids[a].size == 2) ? 20 : (asteroids[a].size == 1) ? 12 : 6;
-    float dx = ship.x - asteroids[a].x;
-    float dy = ship.y - asteroids[a].y;
-    float dist = sqrt(dx*dx + dy*dy);
-    if(dist < ar + 10) {
-      ship.alive = false;
-      game_over = true;
-      if(game_score > high_scores[0]) high_scores[0] = game_score;
-      break;
-    }
-  }
-}
-
-void draw_asteroids_game() {
-  Paint_Clear(BLACK);
-  
-  if(game_over) {
-    Paint_DrawString_EN(60, 180, "GAME OVER", &Font24, 0xF800, BLACK);
-    char score_str[32];
-    sprintf(score_str, "Score: %d", game_score);
-    Paint_DrawString_EN(80, 210, score_str, &Font24, WHITE, BLACK);
-    sprintf(score_str, "High: %d", high_scores[0]);
-    Paint_DrawString_EN(80, 230, score_str, &Font24, WHITE, BLACK);
-    Paint_DrawString_EN(60, 260, "Touch to play again", &Font24, 0x7FFF, BLACK);
-    AMOLED_1IN8_Display(BlackImage);
-    return;
-  }
-  
-  // Draw ship if alive
-  if(ship.alive) {
-    float rad = ship.angle * 3.14159f / 180.0f;
-    int x1 = ship.x + 10 * cos(rad);
-    int y1 = ship.y + 10 * sin(rad);
-    int x2 = ship.x + 6 * cos(rad + 2.5f);
-    int y2 = ship.y + 6 * sin(rad + 2.5f);
-    int x3 = ship.x + 6 * cos(rad - 2.5f);
-    int y3 = ship.y + 6 * sin(rad - 2.5f);
-    
-    Paint_DrawLine(x1, y1, x2, y2, WHITE, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
-    Paint_DrawLine(x2, y2, x3, y3, WHITE, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
-    Paint_DrawLine(x3, y3, x1, y1, WHITE, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
-  }
-  
-  // Draw bullets
-  for(int i = 0; i < 5; i++) {
-    if(bullets[i].active) {
-      Paint_DrawCircle(bullets[i].x, bullets[i].y, 2, 0xFFE0, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-    }
-  }
-  
-  // Draw asteroids as irregular polygons (jagged rocks)
-  for(int i = 0; i < 15; i++) {
-    if(asteroids[i].active) {
-      int base_r = (asteroids[i].size == 2) ? 20 : (asteroids[i].size == 1) ? 12 : 6;
-      // Create 8 vertices with varied radii for irregular shape
-      int num_vertices = 8;
-      int vertices_x[8], vertices_y[8];
-      
-      for(int j = 0; j < num_vertices; j++) {
-        float angle = (asteroids[i].angle + j * 45) * 3.14159f / 180.0f;
-        // Vary radius between 70% and 100% of base for irregular look
-        int variation = (i * 7 + j * 3) % 30; // Pseudo-random but consistent per asteroid
-        float r = base_r * (0.7f + variation / 100.0f);
-        vertices_x[j] = asteroids[i].x + r * cos(angle);
-        vertices_y[j] = asteroids[i].y + r * sin(angle);
-      }
-      
-      // Draw lines between vertices
-      for(int j = 0; j < num_vertices; j++) {
-        int next = (j + 1) % num_vertices;
-        Paint_DrawLine(vertices_x[j], vertices_y[j], vertices_x[next], vertices_y[next], 
-                      WHITE, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
-      }
-    }
-  }
-  
-  // Draw score and level
-  char score_str[32];
-  sprintf(score_str, "Score:%d Lvl:%d", game_score, asteroids_level);
-  Paint_DrawString_EN(5, 5, score_str, &Font12, WHITE, BLACK);
-  
-  AMOLED_1IN8_Display(BlackImage);
+// ---------- Arcade ----------
+void print_game_loop_stats(Print &out) {
+  GameLoopStats st;
+  game_loop_stats(&st, true);
+  const GameTiming &t = game_loop_timing();
+  out.printf("Game loop: %u Hz steps, %u fps target; %lu steps, %lu frames, %lu skipped, %lu ms dropped\n",
+             t.step_hz, t.render_hz, (unsigned long)st.steps, (unsigned long)st.frames,
+             (unsigned long)st.skipped_frames, (unsigned long)st.dropped_ms);
+  out.printf("Game arena: %lu of %u bytes at most\n", (unsigned long)game_arena_peak(), GAME_ARENA_BYTES);
 }
 
 // ---------- Button virtual mappings ----------
 void process_button(VButton b) {
   set_brightness_and_restart(255);
+  clock_governor_boost(INPUT_BOOST_MS);
 
   if (current_screen == SCR_WATCHFACE) {
-    if      (b == BTN_UP)   { current_screen = SCR_TL_FUTURE; draw_tl_card(TL_FUT[0], false); }
-    else if (b == BTN_DOWN) { current_screen = SCR_TL_PAST;   draw_tl_card(TL_PAST[0], true); }
+    if      (b == BTN_UP)   open_timeline(false);
+    else if (b == BTN_DOWN) open_timeline(true);
     else if (b == BTN_SELECT) open_menu();
   }
   else if (current_screen == SCR_MENU) {
     if (b == BTN_UP && menu_sel > 0) { menu_sel--; open_menu(); }
     else if (b == BTN_DOWN && menu_sel < MENU_COUNT-1) { menu_sel++; open_menu(); }
     else if (b == BTN_SELECT) {
-      if (menu_sel == 3) { // Games
+      if (menu_sel == 0) { // Music
+        open_music();
+      } else if (menu_sel == 1) { // Alarms
+        open_alarms();
+      } else if (menu_sel == 3) { // Games
         current_screen = SCR_GAMES_MENU;
         draw_games_menu();
       } else if (menu_sel == 4) { // Settings
@@ -1219,7 +447,6 @@ void process_button(VButton b) {
     else if (b == BTN_SELECT) {
       if (games_sel == 0) { // Arcade
         current_screen = SCR_GAME_ARCADE;
-        current_game = GAME_MENU;
         draw_arcade_menu();
       } else if (games_sel == 1) { // Tamagotchi
         current_screen = SCR_GAME_TAMAGOTCHI;
@@ -1229,14 +456,12 @@ void process_button(VButton b) {
     else if (b == BTN_BACK) open_menu();
   }
   else if (current_screen == SCR_GAME_ARCADE) {
-    if (current_game == GAME_MENU) {
-      if (b == BTN_BACK) {
+    if (b == BTN_BACK) {
+      if (game_current() < 0) {
         current_screen = SCR_GAMES_MENU;
         draw_games_menu();
-      }
-    } else if (current_game == ASTEROIDS || current_game == TETRIS || current_game == SNAKE || current_game == BREAKOUT) {
-      if (b == BTN_BACK) {
-        current_game = GAME_MENU;
+      } else {
+        game_stop();
         draw_arcade_menu();
       }
     }
@@ -1252,15 +477,27 @@ void process_button(VButton b) {
     else if (b == BTN_DOWN && settings_sel < SETTINGS_COUNT-1) { settings_sel++; draw_settings_menu(); }
     else if (b == BTN_SELECT) {
       if (settings_sel == 0) { // Set Time
+        RtcTime t = rtc_clock_now();
         current_screen = SCR_SET_TIME;
         set_time_field = 0;
         set_time_dirty = false;
+        set_hour = t.hour;
+        set_minute = t.minute;
         draw_set_time();
       } else if (settings_sel == 1) { // Set Date
+        RtcTime t = rtc_clock_now();
         current_screen = SCR_SET_DATE;
         set_date_field = 0;
         set_date_dirty = false;
+        set_day = t.day;
+        set_month = t.month;
+        set_year = t.year;
         draw_set_date();
+      } else if (settings_sel == 2) { // Theme
+        theme_idx = (theme_idx + 1) % themes_count;
+        uint8_t t = theme_idx;
+        config_set(CFG_KEY_THEME, &t, sizeof(t));
+        draw_settings_menu();
       } else if (settings_sel == 3) { // About
         current_screen = SCR_SETTINGS_ABOUT;
         draw_about();
@@ -1271,14 +508,14 @@ void process_button(VButton b) {
   else if (current_screen == SCR_SET_TIME) {
     last_time_button_press = millis();
     if (b == BTN_UP) {
-      if (set_time_field == 0) { h = (h + 1) % 24; }
-      else { m = (m + 1) % 60; }
+      if (set_time_field == 0) { set_hour = (set_hour + 1) % 24; }
+      else { set_minute = (set_minute + 1) % 60; }
       set_time_dirty = true;
       draw_set_time();
     }
     else if (b == BTN_DOWN) {
-      if (set_time_field == 0) { h = (h == 0) ? 23 : h - 1; }
-      else { m = (m == 0) ? 59 : m - 1; }
+      if (set_time_field == 0) { set_hour = (set_hour == 0) ? 23 : set_hour - 1; }
+      else { set_minute = (set_minute == 0) ? 59 : set_minute - 1; }
       set_time_dirty = true;
       draw_set_time();
     }
@@ -1287,6 +524,11 @@ void process_button(VButton b) {
       draw_set_time();
     }
     else if (b == BTN_BACK) {
+      if (set_time_dirty) {
+        uint32_t before = rtc_clock_epoch();
+        rtc_clock_set_time(set_hour, set_minute);
+        alarms_reschedule(before);
+      }
       current_screen = SCR_SETTINGS_MENU;
       draw_settings_menu();
     }
@@ -1294,16 +536,16 @@ void process_button(VButton b) {
   else if (current_screen == SCR_SET_DATE) {
     last_date_button_press = millis();
     if (b == BTN_UP) {
-      if (set_date_field == 0) { day = (day % 31) + 1; }
-      else if (set_date_field == 1) { month = (month % 12) + 1; }
-      else { year++; }
+      if (set_date_field == 0) { set_day = (set_day % rtc_days_in_month(set_year, set_month)) + 1; }
+      else if (set_date_field == 1) { set_month = (set_month % 12) + 1; }
+      else { set_year++; }
       set_date_dirty = true;
       draw_set_date();
     }
     else if (b == BTN_DOWN) {
-      if (set_date_field == 0) { day = (day == 1) ? 31 : day - 1; }
-      else if (set_date_field == 1) { month = (month == 1) ? 12 : month - 1; }
-      else { year--; }
+      if (set_date_field == 0) { set_day = (set_day == 1) ? rtc_days_in_month(set_year, set_month) : set_day - 1; }
+      else if (set_date_field == 1) { set_month = (set_month == 1) ? 12 : set_month - 1; }
+      else if (set_year > 2000) { set_year--; }
       set_date_dirty = true;
       draw_set_date();
     }
@@ -1312,18 +554,121 @@ void process_button(VButton b) {
       draw_set_date();
     }
     else if (b == BTN_BACK) {
+      if (set_date_dirty) {
+        uint32_t before = rtc_clock_epoch();
+        rtc_clock_set_date(set_year, set_month, set_day);
+        alarms_reschedule(before);
+      }
       current_screen = SCR_SETTINGS_MENU;
       draw_settings_menu();
     }
   }
   else if (current_screen == SCR_SETTINGS_ABOUT) {
-    if (b == BTN_BACK) {
+    if (b == BTN_DOWN) {
+      current_screen = SCR_SETTINGS_ENERGY;
+      draw_energy_report();
+    }
+    else if (b == BTN_BACK) {
       current_screen = SCR_SETTINGS_MENU;
       draw_settings_menu();
     }
   }
-  else if (current_screen == SCR_TL_PAST || current_screen == SCR_TL_FUTURE) {
-    if (b == BTN_BACK) open_watchface();
+  else if (current_screen == SCR_SETTINGS_ENERGY) {
+    if (b == BTN_SELECT) draw_energy_report(); // refresh
+    else if (b == BTN_BACK) {
+      current_screen = SCR_SETTINGS_ABOUT;
+      draw_about();
+    }
+  }
+  else if (current_screen == SCR_TL_PAST) {
+    // DOWN = older, UP = back towards now
+    if (b == BTN_DOWN && tl_idx > 0) { tl_idx--; draw_tl_card(true); }
+    else if (b == BTN_UP) {
+      if (tl_idx + 1 < tl_now) { tl_idx++; draw_tl_card(true); }
+      else open_watchface();
+    }
+    else if (b == BTN_BACK) open_watchface();
+  }
+  else if (current_screen == SCR_TL_FUTURE) {
+    // UP = later, DOWN = back towards now
+    if (b == BTN_UP && tl_idx + 1 < (int)timeline_count()) { tl_idx++; draw_tl_card(false); }
+    else if (b == BTN_DOWN) {
+      if (tl_idx > tl_now) { tl_idx--; draw_tl_card(false); }
+      else open_watchface();
+    }
+    else if (b == BTN_BACK) open_watchface();
+  }
+  else if (current_screen == SCR_ALARMS) {
+    int rows = alarm_count() + 2;
+    if (b == BTN_UP && alarms_sel > 0) { alarms_sel--; draw_alarms(); }
+    else if (b == BTN_DOWN && alarms_sel < rows-1) { alarms_sel++; draw_alarms(); }
+    else if (b == BTN_SELECT) {
+      Alarm a;
+      if (alarm_get(alarms_sel, &a)) {
+        if (a.kind == ALARM_KIND_TIMER) alarm_remove(a.id);   // cancel timer
+        else open_alarm_edit(a);
+        if (current_screen == SCR_ALARMS) draw_alarms();
+      } else if (alarms_sel == rows-2) { // + Alarm
+        int8_t id = alarm_add(7, 0, ALARM_DAILY);
+        if (id >= 0 && alarm_find(id, &a)) open_alarm_edit(a);
+      } else { // + Timer
+        timer_start(QUICK_TIMER_S);
+        draw_alarms();
+      }
+    }
+    else if (b == BTN_BACK) open_menu();
+  }
+  else if (current_screen == SCR_ALARM_EDIT) {
+    if (b == BTN_UP || b == BTN_DOWN) {
+      int d = (b == BTN_UP) ? 1 : -1;
+      if (alarm_edit_field == 0) alarm_edit_hour = (alarm_edit_hour + 24 + d) % 24;
+      else if (alarm_edit_field == 1) alarm_edit_minute = (alarm_edit_minute + 60 + d) % 60;
+      else if (alarm_edit_field == 2) alarm_edit_repeat = (alarm_edit_repeat + REPEAT_PRESET_COUNT + d) % REPEAT_PRESET_COUNT;
+      else if (alarm_edit_field == 3) alarm_edit_enabled = !alarm_edit_enabled;
+      else alarm_edit_delete = !alarm_edit_delete;
+      draw_alarm_edit();
+    }
+    else if (b == BTN_SELECT) {
+      alarm_edit_field = (alarm_edit_field + 1) % 5;
+      draw_alarm_edit();
+    }
+    else if (b == BTN_BACK) {
+      if (alarm_edit_delete) alarm_remove(alarm_edit_id);
+      else alarm_update(alarm_edit_id, alarm_edit_hour, alarm_edit_minute,
+                        REPEAT_PRESETS[alarm_edit_repeat], alarm_edit_enabled);
+      save_alarms();
+      open_alarms();
+    }
+  }
+  else if (current_screen == SCR_MUSIC) {
+    if (b == BTN_UP && music_sel > 0) { music_sel--; draw_music(); }
+    else if (b == BTN_DOWN && music_sel < music_count) { music_sel++; draw_music(); }
+    else if (b == BTN_SELECT) {
+      if (music_sel == music_count) {   // last row: the mic spectrum
+        open_spectrum();
+      } else {
+        const MusicTrack &t = music_tracks[music_sel];
+        if (audio_music_playing() && tracker_song() == t.data) audio_stop_music();
+        else audio_play_music(t.data, t.size);
+        draw_music();
+      }
+    }
+    else if (b == BTN_BACK) open_menu();
+  }
+  else if (current_screen == SCR_SPECTRUM) {
+    if (b == BTN_SELECT) {
+      spectrum_start(spectrum_points() == 512 ? 256 : 512);
+      open_spectrum();
+    }
+    else if (b == BTN_BACK) {
+      spectrum_stop();
+      open_music();
+    }
+  }
+  else if (current_screen == SCR_ALARM_RING) {
+    if (b == BTN_UP || b == BTN_SELECT) alarm_snooze();
+    else { alarm_dismiss(); save_alarms(); }   // one-shot alarms switch off
+    open_watchface();
   }
 }
 
@@ -1331,7 +676,8 @@ void process_button(VButton b) {
 void draw_watchface() {
   Paint_Clear(THEMES[theme_idx].bg);
   int centerX = AMOLED_1IN8_WIDTH / 2 - 60; // Moved 60 pixels left to avoid overlap
-  draw_big_time_centered(centerX, 30, h, m, CASIO_GREEN); // GREEN digits
+  RtcTime now = rtc_clock_now();
+  draw_big_time_centered(centerX, 30, now.hour, now.minute, CASIO_GREEN); // GREEN digits
   draw_right_complications(50);
   AMOLED_1IN8_Display(BlackImage);
 }
@@ -1352,6 +698,83 @@ void open_menu() {
   AMOLED_1IN8_Display(BlackImage);
 }
 
+void open_alarms() {
+  current_screen = SCR_ALARMS;
+  int rows = alarm_count() + 2;
+  if (alarms_sel >= rows) alarms_sel = rows - 1;
+  draw_alarms();
+}
+
+void draw_alarms() {
+  Paint_Clear(THEMES[theme_idx].bg);
+  Paint_DrawString_EN(20, 30, "ALARMS", &Font24, THEMES[theme_idx].accent, THEMES[theme_idx].bg);
+
+  const int VISIBLE = 10;
+  int rows = alarm_count() + 2;
+  int first = (alarms_sel >= VISIBLE) ? alarms_sel - VISIBLE + 1 : 0;
+  for (int i = first; i < rows && i < first + VISIBLE; i++) {
+    char line[32];
+    Alarm a;
+    if (alarm_get(i, &a)) {
+      if (a.kind == ALARM_KIND_TIMER) snprintf(line, sizeof(line), "%02d:%02d Timer", a.hour, a.minute);
+      else snprintf(line, sizeof(line), "%02d:%02d %-8s %s", a.hour, a.minute,
+                    alarm_days_label(a.days), a.enabled ? "ON" : "off");
+    } else if (i == rows - 2) {
+      snprintf(line, sizeof(line), "+ Alarm");
+    } else {
+      snprintf(line, sizeof(line), "+ Timer %lu min", (unsigned long)(QUICK_TIMER_S / 60));
+    }
+    uint16_t color = (i == alarms_sel) ? THEMES[theme_idx].accent : THEMES[theme_idx].time;
+    Paint_DrawString_EN(30, 70 + (i - first)*30, line, &Font20, color, THEMES[theme_idx].bg);
+  }
+  Paint_DrawString_EN(30, 400, "SELECT: Edit/cancel", &Font16, THEMES[theme_idx].muted, THEMES[theme_idx].bg);
+  AMOLED_1IN8_Display(BlackImage);
+}
+
+void open_alarm_edit(const Alarm &a) {
+  current_screen = SCR_ALARM_EDIT;
+  alarm_edit_id = a.id;
+  alarm_edit_hour = a.hour;
+  alarm_edit_minute = a.minute;
+  alarm_edit_enabled = a.enabled;
+  alarm_edit_delete = false;
+  alarm_edit_field = 0;
+  alarm_edit_repeat = 0;
+  for (int i = 0; i < REPEAT_PRESET_COUNT; i++) {
+    if (REPEAT_PRESETS[i] == a.days) alarm_edit_repeat = i;
+  }
+  draw_alarm_edit();
+}
+
+void draw_alarm_edit() {
+  Paint_Clear(THEMES[theme_idx].bg);
+  Paint_DrawString_EN(20, 30, "EDIT ALARM", &Font24, THEMES[theme_idx].accent, THEMES[theme_idx].bg);
+
+  char field_indicators[5][8] = {"HOUR", "MIN", "REPEAT", "STATE", "DELETE"};
+  Paint_DrawString_EN(30, 80, field_indicators[alarm_edit_field], &Font24, THEMES[theme_idx].accent, THEMES[theme_idx].bg);
+
+  char line[24];
+  snprintf(line, sizeof(line), "%02d:%02d", alarm_edit_hour, alarm_edit_minute);
+  Paint_DrawString_EN(30, 120, line, &Font24, THEMES[theme_idx].time, THEMES[theme_idx].bg);
+  Paint_DrawString_EN(30, 150, alarm_days_label(REPEAT_PRESETS[alarm_edit_repeat]), &Font20, THEMES[theme_idx].time, THEMES[theme_idx].bg);
+  Paint_DrawString_EN(30, 175, alarm_edit_enabled ? "Enabled" : "Disabled", &Font20, THEMES[theme_idx].time, THEMES[theme_idx].bg);
+  if (alarm_edit_delete) Paint_DrawString_EN(30, 200, "Delete on save", &Font20, RED, THEMES[theme_idx].bg);
+  Paint_DrawString_EN(30, 240, "UP/DOWN: Change", &Font24, THEMES[theme_idx].muted, THEMES[theme_idx].bg);
+  Paint_DrawString_EN(30, 260, "SELECT: Next", &Font24, THEMES[theme_idx].muted, THEMES[theme_idx].bg);
+  Paint_DrawString_EN(30, 280, "BACK: Save", &Font24, THEMES[theme_idx].muted, THEMES[theme_idx].bg);
+  AMOLED_1IN8_Display(BlackImage);
+}
+
+void draw_alarm_ring(const Alarm &a) {
+  Paint_Clear(BLACK);
+  Paint_DrawString_EN(110, 60, a.kind == ALARM_KIND_TIMER ? "TIMER" : "ALARM", &Font24, CASIO_GREEN, BLACK);
+  RtcTime now = rtc_clock_now();
+  draw_big_time_centered(AMOLED_1IN8_WIDTH / 2 - 60, 100, now.hour, now.minute, CASIO_GREEN);
+  Paint_DrawString_EN(40, 400, "UP/SEL: Snooze", &Font20, COL_WHITE, BLACK);
+  Paint_DrawString_EN(40, 425, "DOWN/BACK: Stop", &Font20, COL_WHITE, BLACK);
+  AMOLED_1IN8_Display(BlackImage);
+}
+
 void draw_games_menu() {
   Paint_Clear(THEMES[theme_idx].bg);
   Paint_DrawString_EN(20, 30, "GAMES", &Font24, THEMES[theme_idx].accent, THEMES[theme_idx].bg);
@@ -1364,17 +787,24 @@ void draw_games_menu() {
   AMOLED_1IN8_Display(BlackImage);
 }
 
+// One box per registered game, ARCADE_BOX_PITCH apart from ARCADE_BOX_TOP
+#define ARCADE_BOX_TOP    120
+#define ARCADE_BOX_H      60
+#define ARCADE_BOX_PITCH  80
+
 void draw_arcade_menu() {
   Paint_Clear(BLACK);
   Paint_DrawString_EN(90, 40, "ARCADE", &Font24, CYAN, BLACK);
-  Paint_DrawRectangle(40, 120, 328, 180, WHITE, DOT_PIXEL_2X2, DRAW_FILL_EMPTY);
-  Paint_DrawString_EN(110, 140, "ASTEROIDS", &Font20, WHITE, BLACK);
-  Paint_DrawRectangle(40, 200, 328, 260, WHITE, DOT_PIXEL_2X2, DRAW_FILL_EMPTY);
-  Paint_DrawString_EN(130, 220, "TETRIS", &Font20, WHITE, BLACK);
-  Paint_DrawRectangle(40, 280, 328, 340, WHITE, DOT_PIXEL_2X2, DRAW_FILL_EMPTY);
-  Paint_DrawString_EN(135, 300, "SNAKE", &Font20, WHITE, BLACK);
-  Paint_DrawRectangle(40, 360, 328, 420, WHITE, DOT_PIXEL_2X2, DRAW_FILL_EMPTY);
-  Paint_DrawString_EN(120, 380, "BREAKOUT", &Font20, WHITE, BLACK);
+  for (uint8_t i = 0; i < game_count(); i++) {
+    const char *name = game_get(i)->name;
+    char label[16];
+    uint8_t n = 0;
+    for (; name[n] && n < sizeof(label) - 1; n++) label[n] = toupper(name[n]);
+    label[n] = 0;
+    int y = ARCADE_BOX_TOP + i * ARCADE_BOX_PITCH;
+    Paint_DrawRectangle(40, y, 328, y + ARCADE_BOX_H, WHITE, DOT_PIXEL_2X2, DRAW_FILL_EMPTY);
+    Paint_DrawString_EN(184 - n * Font20.Width / 2, y + 20, label, &Font20, WHITE, BLACK);
+  }
   Paint_DrawString_EN(50, 450, "ALL GAMES READY!", &Font24, 0x07E0, BLACK);
   Paint_DrawString_EN(50, 470, "Touch to play", &Font24, CYAN, BLACK);
   AMOLED_1IN8_Display(BlackImage);
@@ -1398,7 +828,7 @@ void draw_set_time() {
   Paint_DrawString_EN(30, 80, field_indicators[set_time_field], &Font24, THEMES[theme_idx].accent, THEMES[theme_idx].bg);
 
   char time_display[16];
-  snprintf(time_display, sizeof(time_display), "%02d:%02d", h, m);
+  snprintf(time_display, sizeof(time_display), "%02d:%02d", set_hour, set_minute);
   Paint_DrawString_EN(30, 120, time_display, &Font24, THEMES[theme_idx].time, THEMES[theme_idx].bg);
   Paint_DrawString_EN(30, 180, "UP/DOWN: Change", &Font24, THEMES[theme_idx].muted, THEMES[theme_idx].bg);
   Paint_DrawString_EN(30, 200, "SELECT: Next", &Font24, THEMES[theme_idx].muted, THEMES[theme_idx].bg);
@@ -1414,7 +844,7 @@ void draw_set_date() {
   Paint_DrawString_EN(30, 80, field_indicators[set_date_field], &Font24, THEMES[theme_idx].accent, THEMES[theme_idx].bg);
 
   char date_display[16];
-  snprintf(date_display, sizeof(date_display), "%02d/%02d/%d", month, day, year);
+  snprintf(date_display, sizeof(date_display), "%02d/%02d/%d", set_month, set_day, set_year);
   Paint_DrawString_EN(30, 120, date_display, &Font24, THEMES[theme_idx].time, THEMES[theme_idx].bg);
   Paint_DrawString_EN(30, 180, "UP/DOWN: Change", &Font24, THEMES[theme_idx].muted, THEMES[theme_idx].bg);
   Paint_DrawString_EN(30, 200, "SELECT: Next", &Font24, THEMES[theme_idx].muted, THEMES[theme_idx].bg);
@@ -1438,30 +868,353 @@ void draw_about() {
   Paint_DrawString_EN(20, 330, "Live monitoring", &Font24, COL_WHITE, BLACK);
   Paint_DrawString_EN(20, 360, "Tap-to-wake", &Font24, COL_WHITE, BLACK);
   Paint_DrawString_EN(20, 390, "Auto-dimming", &Font24, COL_WHITE, BLACK);
+  Paint_DrawString_EN(20, 425, "DOWN: Energy use", &Font16, COL_GRAY, BLACK);
+
+  AMOLED_1IN8_Display(BlackImage);
+}
+
+// ---------- Music player ----------
+static void add_music_track(const uint8_t *data, uint32_t size) {
+  TrackerInfo info;
+  if (!tracker_validate(data, size, &info)) return;
+  MusicTrack &t = music_tracks[music_count++];
+  t.data = data;
+  t.size = size;
+  memcpy(t.title, info.title, sizeof(t.title));
+  if (!t.title[0]) snprintf(t.title, sizeof(t.title), "Track %d", music_count);
+}
+
+void scan_music() {
+  music_count = 0;
+  add_music_track(DEMO_SONG, sizeof(DEMO_SONG));
+  for (int i = 0; i < MUSIC_PACK_SLOTS; i++) {
+    char name[12];
+    snprintf(name, sizeof(name), "music/%d", i);
+    Asset a;
+    if (asset_find(name, &a) && a.format == ASSET_SONG) add_music_track(a.data, a.size);
+  }
+  if (music_sel > music_count) music_sel = music_count;
+}
+
+// Position line, redrawn on its own while a song plays
+void draw_music_status() {
+  char line[40];
+  uint8_t order, row;
+  tracker_position(&order, &row);
+  if (audio_music_playing()) snprintf(line, sizeof(line), "Order %02u  Row %02u        ", order, row);
+  else snprintf(line, sizeof(line), "Stopped                 ");
+  Paint_DrawString_EN(30, 380, line, &Font20, THEMES[theme_idx].time, THEMES[theme_idx].bg);
+  AMOLED_1IN8_DisplayWindows(0, 380, AMOLED_1IN8_WIDTH, 380 + Font20.Height, BlackImage);
+}
+
+void open_music() {
+  current_screen = SCR_MUSIC;
+  scan_music();
+  draw_music();
+}
+
+void draw_music() {
+  Paint_Clear(THEMES[theme_idx].bg);
+  Paint_DrawString_EN(20, 30, "MUSIC", &Font24, THEMES[theme_idx].accent, THEMES[theme_idx].bg);
+  const uint8_t *playing = audio_music_playing() ? tracker_song() : nullptr;
+  for (int i = 0; i <= music_count; i++) {
+    char line[32];
+    if (i < music_count) snprintf(line, sizeof(line), "%c %s", music_tracks[i].data == playing ? '>' : ' ',
+                                  music_tracks[i].title);
+    else snprintf(line, sizeof(line), "  Mic spectrum");
+    uint16_t color = (i == music_sel) ? THEMES[theme_idx].accent : THEMES[theme_idx].time;
+    Paint_DrawString_EN(20, 70 + i*30, line, &Font20, color, THEMES[theme_idx].bg);
+  }
+  Paint_DrawString_EN(30, 430, "SELECT: Play/stop", &Font16, THEMES[theme_idx].muted, THEMES[theme_idx].bg);
+  AMOLED_1IN8_Display(BlackImage);
+  draw_music_status();
+}
+
+// ---------- Music: live microphone spectrum ----------
+#define SPEC_BARS    32
+#define SPEC_BAR_W   11                   // 10 px bar + 1 px gap
+#define SPEC_LEFT    ((AMOLED_1IN8_WIDTH - SPEC_BARS * SPEC_BAR_W) / 2)
+#define SPEC_TOP     80
+#define SPEC_BOTTOM  400                  // baseline row, drawn once
+#define SPEC_HEIGHT  (SPEC_BOTTOM - SPEC_TOP)
+
+static uint32_t spec_cycles = 0;          // spectrum + drawing, this second
+static uint16_t spec_frames = 0;
+static uint32_t spec_window_start = 0;
+
+void draw_spectrum_footer(uint16_t fps, uint32_t permille) {
+  char line[40];
+  snprintf(line, sizeof(line), "FFT %u  %u fps  %lu.%lu%% core  ", spectrum_points(), fps,
+           (unsigned long)permille / 10, (unsigned long)permille % 10);
+  Paint_DrawString_EN(20, 412, line, &Font16, THEMES[theme_idx].muted, THEMES[theme_idx].bg);
+  AMOLED_1IN8_DisplayWindows(0, 412, AMOLED_1IN8_WIDTH, 412 + Font16.Height, BlackImage);
+}
+
+void open_spectrum() {
+  current_screen = SCR_SPECTRUM;
+  if (!spectrum_active() && !spectrum_start(512)) {
+    Paint_Clear(THEMES[theme_idx].bg);
+    Paint_DrawString_EN(20, 30, "MUSIC", &Font24, THEMES[theme_idx].accent, THEMES[theme_idx].bg);
+    Paint_DrawString_EN(20, 80, "Microphone unavailable", &Font16, THEMES[theme_idx].time, THEMES[theme_idx].bg);
+    AMOLED_1IN8_Display(BlackImage);
+    return;
+  }
+  Paint_Clear(THEMES[theme_idx].bg);
+  Paint_DrawString_EN(20, 30, "SPECTRUM", &Font24, THEMES[theme_idx].accent, THEMES[theme_idx].bg);
+  Paint_DrawLine(SPEC_LEFT, SPEC_BOTTOM, SPEC_LEFT + SPEC_BARS * SPEC_BAR_W - 1, SPEC_BOTTOM,
+                 THEMES[theme_idx].muted, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+  Paint_DrawString_EN(SPEC_LEFT, SPEC_BOTTOM + 2, "80Hz", &Font8, THEMES[theme_idx].muted, THEMES[theme_idx].bg);
+  char nyquist[8];
+  snprintf(nyquist, sizeof(nyquist), "%luk", (unsigned long)(audio_in_sample_rate() / 2000));
+  Paint_DrawString_EN(SPEC_LEFT + SPEC_BARS * SPEC_BAR_W - 30, SPEC_BOTTOM + 2, nyquist, &Font8,
+                      THEMES[theme_idx].muted, THEMES[theme_idx].bg);
+  Paint_DrawString_EN(20, 430, "SELECT: 256/512 points", &Font12, THEMES[theme_idx].muted, THEMES[theme_idx].bg);
+  AMOLED_1IN8_Display(BlackImage);
+  spec_cycles = 0;
+  spec_frames = 0;
+  spec_window_start = millis();
+}
+
+// Bars go straight into the framebuffer (stored big-endian) and only
+// their rectangle is sent, so a frame costs a fraction of a full redraw
+void draw_spectrum_frame() {
+  uint32_t t0 = rp2040.getCycleCount();
+  uint8_t bars[SPEC_BARS];
+  if (!spectrum_update(bars, SPEC_BARS)) return;
+
+  uint16_t heights[SPEC_BARS];
+  for (int b = 0; b < SPEC_BARS; b++) heights[b] = bars[b] * SPEC_HEIGHT / 255;
+  UWORD bg = __builtin_bswap16(THEMES[theme_idx].bg);
+  UWORD fg = __builtin_bswap16(THEMES[theme_idx].accent);
+  for (int y = SPEC_TOP; y < SPEC_BOTTOM; y++) {
+    UWORD *px = BlackImage + y * AMOLED_1IN8_WIDTH + SPEC_LEFT;
+    uint16_t level = SPEC_BOTTOM - y;
+    for (int b = 0; b < SPEC_BARS; b++) {
+      UWORD c = heights[b] >= level ? fg : bg;
+      for (int i = 0; i < SPEC_BAR_W - 1; i++) *px++ = c;
+      *px++ = bg;
+    }
+  }
+  AMOLED_1IN8_DisplayWindows(SPEC_LEFT, SPEC_TOP, SPEC_LEFT + SPEC_BARS * SPEC_BAR_W, SPEC_BOTTOM, BlackImage);
+
+  // Load over the last second: cycles spent / cycles available
+  spec_cycles += rp2040.getCycleCount() - t0;
+  spec_frames++;
+  uint32_t now = millis();
+  if (now - spec_window_start >= 1000) {
+    uint32_t hz = clock_get_hz(clk_sys);
+    uint64_t avail = (uint64_t)hz * (now - spec_window_start) / 1000;
+    draw_spectrum_footer(spec_frames * 1000 / (now - spec_window_start),
+                         (uint32_t)((uint64_t)spec_cycles * 1000 / avail));
+    spec_cycles = 0;
+    spec_frames = 0;
+    spec_window_start = now;
+  }
+}
+
+// ---------- Clock level per workload ----------
+ClockLevel clock_level_for_screen() {
+  if (current_screen == SCR_GAME_ARCADE && game_current() >= 0) return CLOCK_BOOST;
+  if (current_screen == SCR_WATCHFACE) return CLOCK_IDLE;
+  return CLOCK_NORMAL;
+}
+
+// ---------- Energy profile (About sub-page) ----------
+#define ENERGY_STATE_GAME_BASE 32   // arcade games are profiled separately
+
+uint8_t energy_state() {
+  if (current_screen == SCR_GAME_ARCADE && game_current() >= 0) {
+    return ENERGY_STATE_GAME_BASE + game_current();
+  }
+  return current_screen;
+}
+
+const char* energy_state_name(uint8_t state) {
+  if (state >= ENERGY_STATE_GAME_BASE && state < ENERGY_STATE_GAME_BASE + game_count()) {
+    return game_get(state - ENERGY_STATE_GAME_BASE)->name;
+  }
+  switch (state) {
+    case SCR_WATCHFACE:        return "Watchface";
+    case SCR_MENU:             return "Menu";
+    case SCR_APP:              return "App";
+    case SCR_TL_PAST:          return "Timeline past";
+    case SCR_TL_FUTURE:        return "Timeline fut";
+    case SCR_SETTINGS_MENU:    return "Settings";
+    case SCR_SET_TIME:         return "Set time";
+    case SCR_SET_DATE:         return "Set date";
+    case SCR_SETTINGS_ABOUT:   return "About";
+    case SCR_SETTINGS_ENERGY:  return "Energy";
+    case SCR_ALARMS:           return "Alarms";
+    case SCR_ALARM_EDIT:       return "Alarm edit";
+    case SCR_ALARM_RING:       return "Alarm ring";
+    case SCR_SPECTRUM:         return "Spectrum";
+    case SCR_MUSIC:            return "Music";
+    case SCR_GAMES_MENU:       return "Games menu";
+    case SCR_GAME_ARCADE:      return "Arcade menu";
+    case SCR_GAME_TAMAGOTCHI:  return "Tamagotchi";
+    default:                   return "Other";
+  }
+}
+
+void draw_energy_report() {
+  Paint_Clear(BLACK);
+  Paint_DrawString_EN(60, 20, "Energy use", &Font24, CASIO_GREEN, BLACK);
+
+  char line[40];
+  snprintf(line, sizeof(line), "%u gauge steps, %d mAh cell", energy_profiler_steps(), BATTERY_CAPACITY_MAH);
+  Paint_DrawString_EN(20, 55, line, &Font16, COL_GRAY, BLACK);
+  Paint_DrawString_EN(20, 85, "State         mA   min", &Font16, COL_WHITE, BLACK);
+
+  EnergyReport rep[ENERGY_MAX_STATES];
+  uint8_t n = energy_profiler_report(rep, ENERGY_MAX_STATES);
+  int y = 110;
+  for (uint8_t i = 0; i < n && y < 420; i++, y += 22) {
+    snprintf(line, sizeof(line), "%-12s %5.1f %5lu",
+             energy_state_name(rep[i].state), rep[i].ma, (unsigned long)(rep[i].seconds / 60));
+    Paint_DrawString_EN(20, y, line, &Font16, COL_WHITE, BLACK);
+  }
+  if (n == 0) Paint_DrawString_EN(20, y, "No data yet", &Font16, COL_GRAY, BLACK);
 
+  Paint_DrawString_EN(20, 425, "SELECT: Refresh", &Font16, COL_GRAY, BLACK);
   AMOLED_1IN8_Display(BlackImage);
 }
 
-void draw_tl_card(TLCard &card, bool is_past) {
+// Split the store at now (binary search) and show the nearest event
+void open_timeline(bool is_past) {
+  tl_now = timeline_lower_bound(rtc_clock_epoch());
+  tl_idx = is_past ? tl_now - 1 : tl_now;
+  current_screen = is_past ? SCR_TL_PAST : SCR_TL_FUTURE;
+  draw_tl_card(is_past);
+}
+
+void draw_tl_card(bool is_past) {
   Paint_Clear(BLACK);
 
   uint16_t title_color = is_past ? COL_GRAY : CASIO_GREEN;
   uint16_t time_color = is_past ? 0x39E7 : 0xFFE0;
+  const char* label = is_past ? "PAST" : "FUTURE";
+
+  TimelineEvent ev;
+  if (!timeline_get(tl_idx, &ev) || (is_past ? tl_idx >= tl_now : tl_idx < tl_now)) {
+    Paint_DrawString_EN(20, 50, is_past ? "Nothing earlier" : "Nothing upcoming", &Font20, title_color, BLACK);
+    Paint_DrawString_EN(20, 390, label, &Font12, title_color, BLACK);
+    AMOLED_1IN8_Display(BlackImage);
+    return;
+  }
 
-  Paint_DrawString_EN(20, 50, card.title, &Font20, title_color, BLACK);
-  Paint_DrawString_EN(20, 80, card.subtitle, &Font24, COL_WHITE, BLACK);
-  Paint_DrawString_EN(20, 120, card.body, &Font12, COL_GRAY, BLACK);
+  Paint_DrawString_EN(20, 50, ev.title, &Font20, title_color, BLACK);
+  Paint_DrawString_EN(20, 80, ev.subtitle, &Font24, COL_WHITE, BLACK);
+  Paint_DrawString_EN(20, 120, ev.body, &Font12, COL_GRAY, BLACK);
 
-  char time_str[8];
-  sprintf(time_str, "%02d:%02d", card.hh, card.mm);
+  // Time, with the date when it is not today
+  RtcTime t = rtc_from_epoch(ev.time);
+  RtcTime today = rtc_clock_now();
+  char time_str[20];
+  if (t.year == today.year && t.month == today.month && t.day == today.day) {
+    sprintf(time_str, "%02d:%02d", t.hour, t.minute);
+  } else {
+    sprintf(time_str, "%02d:%02d %02d/%02d", t.hour, t.minute, t.month, t.day);
+  }
   Paint_DrawString_EN(20, 350, time_str, &Font24, time_color, BLACK);
 
-  const char* label = is_past ? "PAST" : "FUTURE";
-  Paint_DrawString_EN(20, 390, label, &Font12, title_color, BLACK);
+  // Position within this half of the timeline
+  char pos_str[24];
+  int n = is_past ? tl_now : (int)timeline_count() - tl_now;
+  int pos = is_past ? tl_now - tl_idx : tl_idx - tl_now + 1;
+  snprintf(pos_str, sizeof(pos_str), "%s %d/%d", label, pos, n);
+  Paint_DrawString_EN(20, 390, pos_str, &Font12, title_color, BLACK);
 
   AMOLED_1IN8_Display(BlackImage);
 }
 
+// First boot: put the demo cards into the store around today
+void seed_timeline() {
+  if (timeline_count() > 0) return;
+  RtcTime t = rtc_clock_now();
+  uint32_t midnight = rtc_to_epoch(t) - (t.hour * 3600UL + t.minute * 60UL + t.second);
+  for (int i = 0; i < TL_PAST_N; i++) {
+    timeline_add(midnight + TL_PAST[i].hh * 3600UL + TL_PAST[i].mm * 60UL,
+                 TL_PAST[i].title, TL_PAST[i].subtitle, TL_PAST[i].body);
+  }
+  for (int i = 0; i < TL_FUT_N; i++) {
+    timeline_add(midnight + TL_FUT[i].hh * 3600UL + TL_FUT[i].mm * 60UL,
+                 TL_FUT[i].title, TL_FUT[i].subtitle, TL_FUT[i].body);
+  }
+}
+
+// ---------- Persistence (Config key/value store) ----------
+// Only the durable part of the pet; animation state and millis() stamps restart
+struct PetSave {
+  char name[16];
+  uint8_t stage, mood;
+  uint8_t hunger, happiness, health, cleanliness;
+  uint8_t age_hours;
+  uint16_t age_days;
+  bool is_sleeping, needs_cleanup;
+  uint8_t petting_count;
+};
+
+struct AlarmSave { uint8_t hour, minute, days, enabled; };
+
+void save_pet() {
+  PetSave ps;
+  memcpy(ps.name, pet.name, sizeof(ps.name));
+  ps.stage = pet.stage;
+  ps.mood = pet.mood;
+  ps.hunger = pet.hunger;
+  ps.happiness = pet.happiness;
+  ps.health = pet.health;
+  ps.cleanliness = pet.cleanliness;
+  ps.age_hours = pet.age_hours;
+  ps.age_days = pet.age_days;
+  ps.is_sleeping = pet.is_sleeping;
+  ps.needs_cleanup = pet.needs_cleanup;
+  ps.petting_count = pet.petting_count;
+  config_set(CFG_KEY_PET, &ps, sizeof(ps));
+}
+
+void save_alarms() {
+  AlarmSave list[ALARM_MAX];
+  uint8_t n = 0;
+  Alarm a;
+  for (uint8_t i = 0; alarm_get(i, &a); i++) {
+    if (a.kind != ALARM_KIND_ALARM) continue;     // timers are not persisted
+    list[n++] = { a.hour, a.minute, a.days, a.enabled };
+  }
+  if (n) config_set(CFG_KEY_ALARMS, list, n * sizeof(AlarmSave));
+  else config_remove(CFG_KEY_ALARMS);
+}
+
+void load_settings() {
+  uint8_t t;
+  if (config_get(CFG_KEY_THEME, &t, sizeof(t)) == sizeof(t) && t < themes_count) theme_idx = t;
+
+  game_load_high_scores();
+
+  PetSave ps;
+  if (config_get(CFG_KEY_PET, &ps, sizeof(ps)) == sizeof(ps)) {
+    memcpy(pet.name, ps.name, sizeof(pet.name));
+    pet.name[sizeof(pet.name) - 1] = 0;
+    pet.stage = (PetStage)ps.stage;
+    pet.mood = (PetMood)ps.mood;
+    pet.hunger = ps.hunger;
+    pet.happiness = ps.happiness;
+    pet.health = ps.health;
+    pet.cleanliness = ps.cleanliness;
+    pet.age_hours = ps.age_hours;
+    pet.age_days = ps.age_days;
+    pet.is_sleeping = ps.is_sleeping;
+    pet.needs_cleanup = ps.needs_cleanup;
+    pet.petting_count = ps.petting_count;
+  }
+
+  AlarmSave list[ALARM_MAX];
+  int16_t len = config_get(CFG_KEY_ALARMS, list, sizeof(list));
+  for (int i = 0; len > 0 && i < len / (int)sizeof(AlarmSave) && i < ALARM_MAX; i++) {
+    alarm_add(list[i].hour, list[i].minute, list[i].days, list[i].enabled);
+  }
+}
+
 // ---------- PET FUNCTIONS ----------
 void init_pet() {
   strcpy(pet.name, "Buddy");
@@ -1611,7 +1364,9 @@ void draw_pet_main_screen() {
 }
 
 // ---------- Touch handling ----------
+// Shared GPIO callback: the SDK allows only one, so the RTC INT pin lands here too
 void Touch_INT_callback(uint gpio, uint32_t events) {
+  if (gpio == RTC_INT_PIN) { rtc_clock_irq(); return; }
   if (i2c_lock) return;
   if (gpio == Touch_INT_PIN) touch_flag = 1;
 }
@@ -1619,11 +1374,14 @@ void Touch_INT_callback(uint gpio, uint32_t events) {
 void handle_touch() {
   if (!touch_flag) return;
   static uint32_t last_touch_ms = 0;
+  static uint32_t quiet_ms = 0;
   uint32_t now = millis();
-  if (now - last_touch_ms < 60) { touch_flag = 0; return; } // debounce
+  if (now - last_touch_ms < quiet_ms) { touch_flag = 0; return; } // debounce
   last_touch_ms = now;
+  quiet_ms = 60;
 
   touch_flag = 0;
+  clock_governor_boost(INPUT_BOOST_MS);
 
   while(i2c_lock);
   I2C_LOCK();
@@ -1631,111 +1389,18 @@ void handle_touch() {
   uint16_t ty = FT3168.y_point;
   uint16_t tx = FT3168.x_point;
   I2C_UNLOCK();
+
+  float point[3] = { (float)tx, (float)ty, 0 };
+  sensor_hub_publish(SENSOR_TOUCH, point);
   
   // Game arcade touch handling
   if (current_screen == SCR_GAME_ARCADE) {
-    if (current_game == GAME_MENU) {
-      // Arcade menu - select games with original coordinates
-      if (ty >= 120 && ty <= 180) {
-        // ASTEROIDS
-        current_game = ASTEROIDS;
-        asteroids_level = 1; // Reset level
-        init_asteroids();
-        delay(200);
-      } else if (ty >= 200 && ty <= 260) {
-        // TETRIS
-        current_game = TETRIS;
-        init_tetris();
-        delay(200);
-      } else if (ty >= 280 && ty <= 340) {
-        // SNAKE
-        current_game = SNAKE;
-        init_snake();
-        delay(200);
-      } else if (ty >= 360 && ty <= 420) {
-        // BREAKOUT
-        current_game = BREAKOUT;
-        init_breakout();
-        delay(200);
-      }
-    } else if (current_game == ASTEROIDS) {
-      if (game_over) {
-        // Game over - touch resets game
-        asteroids_level = 1; // Reset level
-        init_asteroids();
-      } else {
-        // Simple controls: left third = rotate left, right third = rotate right, middle = fire
-        if (tx < AMOLED_1IN8_WIDTH / 3) {
-          ship.angle -= 15;
-        } else if (tx > (AMOLED_1IN8_WIDTH * 2) / 3) {
-          ship.angle += 15;
-        } else {
-          // Fire bullet
-          for(int i = 0; i < 5; i++) {
-            if(!bullets[i].active) {
-              bullets[i].active = true; 
-              bullets[i].x = ship.x; 
-              bullets[i].y = ship.y;
-              float rad = ship.angle * 3.14159f / 180.0f;
-              bullets[i].dx = 5.0f * cos(rad); 
-              bullets[i].dy = 5.0f * sin(rad);
-              bullets[i].fired_time = millis(); 
-              break;
-            }
-          }
-        }
-      }
-    } else if (current_game == TETRIS) {
-      if (game_over) {
-        init_tetris();
-        delay(200);
-      } else {
-        // Simple immediate response like Games.txt with bounds checking
-        bool left = tx < 123;
-        bool middle = tx >= 123 && tx <= 245;
-        bool right = tx > 245;
-        
-        if (left) {
-          // Try to move left, with collision check
-          if (tetris_can_place_piece(tetris_piece_x - 1, tetris_piece_y, tetris_current_piece)) {
-            tetris_piece_x--;
-          }
-        } else if (middle) {
-          // Rotate piece
-          tetris_rotate_piece();
-        } else if (right) {
-          // Try to move right, with collision check
-          if (tetris_can_place_piece(tetris_piece_x + 1, tetris_piece_y, tetris_current_piece)) {
-            tetris_piece_x++;
-          }
-        }
-        
-        delay(150);
-      }
-      draw_tetris_game();
-    } else if (current_game == SNAKE) {
-      if (game_over) {
-        init_snake();
-      } else {
-        // Snake direction controls
-        if (tx < AMOLED_1IN8_WIDTH / 3) {
-          snake_dir = 2; // left
-        } else if (tx > (AMOLED_1IN8_WIDTH * 2) / 3) {
-          snake_dir = 0; // right
-        } else if (ty < AMOLED_1IN8_HEIGHT / 2) {
-          snake_dir = 3; // up
-        } else {
-          snake_dir = 1; // down
-        }
-      }
-    } else if (current_game == BREAKOUT) {
-      if (game_over) {
-        init_breakout();
-      } else {
-        // Move paddle to touch X position
-        paddle_x = tx - paddle_w / 2;
-        if (paddle_x < 0) paddle_x = 0;
-        if (paddle_x > AMOLED_1IN8_WIDTH - paddle_w) paddle_x = AMOLED_1IN8_WIDTH - paddle_w;
+    if (game_current() >= 0) {
+      game_touch(tx, ty);
+    } else if (ty >= ARCADE_BOX_TOP) {
+      uint8_t i = (ty - ARCADE_BOX_TOP) / ARCADE_BOX_PITCH;
+      if ((ty - ARCADE_BOX_TOP) % ARCADE_BOX_PITCH <= ARCADE_BOX_H && game_start(i, millis())) {
+        quiet_ms = 200;   // keep the starting tap out of the game without blocking
       }
     }
     return;
@@ -1788,24 +1453,24 @@ void handle_touch() {
   else                       process_button(BTN_SELECT); // Middle = SELECT
 }
 
-// ---------- Time tick (minutes only) ----------
-void tick_time() {
-  uint32_t now = millis();
-  if (now - last_tick_ms >= 1000) {
-    last_tick_ms = now;
-    static uint16_t sec_acc = 0;
-    if (++sec_acc >= 60) {
-      sec_acc = 0;
-      if (++m >= 60) { m = 0; h = (h + 1) % 24; }
-      if (current_screen == SCR_WATCHFACE) draw_watchface();
-    }
-  }
+// ---------- Minute tick (PCF85063 minute interrupt) ----------
+void on_rtc_minute(const RtcTime &t) {
+  if (current_screen == SCR_WATCHFACE) draw_watchface();
+}
+
+// ---------- Alarm ringing ----------
+void on_alarm_ring(const Alarm &a) {
+  set_brightness_and_restart(255);
+  game_stop();                            // a game cut short still scores
+  current_screen = SCR_ALARM_RING;
+  draw_alarm_ring(a);
 }
 
 // ---------- Backlight dimming control ----------
 void update_dimming() {
-  // Don't dim during games
-  if (current_screen == SCR_GAME_ARCADE || current_screen == SCR_GAME_TAMAGOTCHI) {
+  // Don't dim during games or while an alarm rings
+  if (current_screen == SCR_GAME_ARCADE || current_screen == SCR_GAME_TAMAGOTCHI ||
+      current_screen == SCR_ALARM_RING) {
     return;
   }
   
@@ -1827,71 +1492,123 @@ void set_brightness_and_restart(uint8_t v) {
   last_dim_ms = millis();
 }
 
-// ---------- QMI8658 tap polling ----------
-static inline bool qmi_read_accel_g(float &gx, float &gy, float &gz) {
-  float acc[3] = {0,0,0};
-  QMI8658_read_acc_xyz(acc);
-  gx = acc[0];
-  gy = acc[1];
-  gz = acc[2];
-  return true;
-}
-
-void qmi_poll_for_tap_wake() {
-  uint32_t now = millis();
-  if (now - last_qmi_sample_ms < QMI_POLL_MS) return;
-  last_qmi_sample_ms = now;
+// ---------- QMI8658 tap detection (sensor hub subscriber) ----------
+void on_accel_sample(SensorId id, const SensorReading &r, void *ctx) {
+  int16_t raw[3] = { (int16_t)r.v[0], (int16_t)r.v[1], (int16_t)r.v[2] };
+  imu_trace_push(r.t_ms, raw);
 
-  float gx, gy, gz;
-  if (!qmi_read_accel_g(gx, gy, gz)) return;
+  if (tap_detector_feed(&tap_detector, raw, QMI8658_get_acc_lsb_div(), r.t_ms)) {
+    // Wake to 50% and restart dim cadence
+    set_brightness_and_restart(128);
+    if (current_screen == SCR_WATCHFACE) draw_watchface();
+  }
+}
 
-  // Slow gravity adaptation to filter out orientation changes
-  ax_f = (1.0f - LPF_ALPHA) * ax_f + LPF_ALPHA * gx;
-  ay_f = (1.0f - LPF_ALPHA) * ay_f + LPF_ALPHA * gy;
-  az_f = (1.0f - LPF_ALPHA) * az_f + LPF_ALPHA * gz;
+// Battery / temperature complications only need a redraw when they change
+void on_complication_changed(SensorId id, const SensorReading &r, void *ctx) {
+  if (current_screen == SCR_WATCHFACE) draw_watchface();
+}
 
-  // Remove gravity to get dynamic acceleration
-  float dx = gx - ax_f;
-  float dy = gy - ay_f;
-  float dz = gz - az_f;
+// ---------- Serial debug commands ----------
+// r = start/stop IMU trace recording, d = dump IMU trace, e = energy profile,
+// c = clock governor residency, k = config store, a = asset pack,
+// y = synth load, m = start/stop the microphone level meter, f = FFT benchmark
+static int8_t   mic_meter = -1;
+static int32_t  mic_peak = 0;
+static uint32_t mic_frames = 0;
+
+// AudioIn subscriber: prints the peak level once a second
+void mic_meter_block(const int16_t *samples, uint32_t frames, void *ctx) {
+  for (uint32_t i = 0; i < frames; i++) {
+    int32_t v = samples[i] < 0 ? -samples[i] : samples[i];
+    if (v > mic_peak) mic_peak = v;
+  }
+  mic_frames += frames;
+  if (mic_frames < audio_in_sample_rate()) return;
+  Serial.printf("Mic peak %ld (%ld%% FS), overruns %lu, FIFO overflows %lu\n",
+                (long)mic_peak, (long)(mic_peak * 100 / 32768),
+                (unsigned long)audio_in_overruns(), (unsigned long)audio_in_fifo_overflows());
+  mic_peak = 0;
+  mic_frames = 0;
+}
 
-  // High-pass filter to isolate impulses
-  hx = HPF_ALPHA * hx + (1.0f - HPF_ALPHA) * dx;
-  hy = HPF_ALPHA * hy + (1.0f - HPF_ALPHA) * dy;
-  hz = HPF_ALPHA * hz + (1.0f - HPF_ALPHA) * dz;
+// Audio glitch overlay (serial 'o'): two lines over the top of any screen,
+// each covering the half second since the last. Shares its window with 'y'.
+bool audio_overlay = false;
+
+void draw_audio_overlay() {
+  AudioStats st;
+  audio_get_stats(&st);
+  char line[48];
+  Paint_ClearWindows(0, 0, AMOLED_1IN8_WIDTH, 2 * Font12.Height, BLACK);
+  snprintf(line, sizeof(line), "blk %lu urun %lu late %lu",
+           (unsigned long)st.blocks, (unsigned long)st.underruns, (unsigned long)st.late_refills);
+  Paint_DrawString_EN(2, 0, line, &Font12, st.underruns || st.late_refills ? RED : GREEN, BLACK);
+  snprintf(line, sizeof(line), "fill %u%% pk %u%% room %lums sfx %lums",
+           st.refill_avg_pm / 10, st.refill_peak_pm / 10,
+           (unsigned long)st.headroom_us / 1000, (unsigned long)st.sfx_latency_max_us / 1000);
+  Paint_DrawString_EN(2, Font12.Height, line, &Font12, WHITE, BLACK);
+  AMOLED_1IN8_DisplayWindows(0, 0, AMOLED_1IN8_WIDTH, 2 * Font12.Height, BlackImage);
+}
 
-  // Calculate total acceleration magnitude
-  float mag = sqrt(hx*hx + hy*hy + hz*hz);
-  
-  // Simple threshold check - should detect deliberate taps
-  if (mag >= TAP_G_THRESH) {
-    if (now - last_tap_ms >= TAP_DEBOUNCE) {
-      last_tap_ms = now;
-      // Wake to 50% and restart dim cadence
-      set_brightness_and_restart(128);
-      if (current_screen == SCR_WATCHFACE) draw_watchface();
+void handle_serial_commands() {
+  while (Serial.available() > 0) {
+    int c = Serial.read();
+    switch (c) {
+      case 'r':
+        if (imu_trace_is_recording()) {
+          imu_trace_stop();
+          Serial.print("IMU trace stopped, samples=");
+          Serial.println(imu_trace_sample_count());
+        } else {
+          imu_trace_start(QMI8658_get_acc_lsb_div());
+          Serial.println("IMU trace recording");
+        }
+        break;
+      case 'd':
+        imu_trace_dump(Serial);
+        break;
+      case 'e':
+        energy_profiler_print(Serial);
+        break;
+      case 'c':
+        clock_governor_print(Serial);
+        break;
+      case 'k':
+        config_print(Serial);
+        break;
+      case 'a':
+        asset_pack_print(Serial);
+        break;
+      case 'y':
+        audio_print_stats(Serial);
+        break;
+      case 'f':
+        spectrum_benchmark(Serial);
+        break;
+      case 'g':
+        print_game_loop_stats(Serial);
+        break;
+      case 'o':
+        audio_overlay = !audio_overlay;
+        Serial.println(audio_overlay ? "Audio overlay on" : "Audio overlay off");
+        break;
+      case 'm':
+        if (mic_meter >= 0) {
+          audio_in_unsubscribe(mic_meter);
+          mic_meter = -1;
+          Serial.println("Mic meter stopped");
+        } else {
+          mic_meter = audio_in_subscribe(mic_meter_block, nullptr);
+          Serial.println(mic_meter >= 0 ? "Mic meter running" : "Mic capture unavailable");
+        }
+        break;
+      default:
+        break;
     }
   }
 }
 
-// ---------- Live sensor readings ----------
-void update_sensor_readings() {
-  // Protect I2C access from conflicts with touch sensor
-  if (i2c_lock) return; // Skip if I2C is busy
-  
-  while(i2c_lock);
-  I2C_LOCK();
-  
-  // Update battery percentage from AXP2101
-  battery_percent = get_battery_percentage();
-  
-  // Update temperature from AXP2101 (convert Celsius to Fahrenheit)
-  float temp_c = get_temperature();
-  temp_F = (int8_t)(temp_c * 9.0f / 5.0f + 32.0f);
-  
-  I2C_UNLOCK();
-}
-
 // ---------- Setup / Loop ----------
 void setup() {
   // Display init
@@ -1910,6 +1627,7 @@ void setup() {
   UDOUBLE ImageSize = AMOLED_1IN8_HEIGHT * AMOLED_1IN8_WIDTH * 2;
   BlackImage = (UWORD*)malloc(ImageSize);
   Paint_NewImage((UBYTE*)BlackImage, AMOLED_1IN8.WIDTH, AMOLED_1IN8.HEIGHT, 0, BLACK);
+  game_framework_init(BlackImage);
   Paint_SetScale(65);
   Paint_SetRotate(ROTATE_0);
   Paint_Clear(BLACK);
@@ -1919,19 +1637,43 @@ void setup() {
   DEV_KEY_Config(Touch_INT_PIN);
   DEV_IRQ_SET(Touch_INT_PIN, GPIO_IRQ_EDGE_RISE, &Touch_INT_callback);
 
+  // PCF85063 RTC: wall clock, minute interrupt on RTC_INT_PIN
+  rtc_clock_init(on_rtc_minute);
+  alarms_init(on_alarm_ring);
+
+  // Timeline event store (flash log + RAM index)
+  if (timeline_init()) seed_timeline();
+
   // Physical BACK button
   pinMode(BACK_BUTTON_PIN, INPUT);
 
   // QMI8658 IMU init
   QMI8658_init();
+  tap_detector_init(&tap_detector, &TAP_CONFIG);
+
+  // Sensor hub: AXP2101 battery/temperature, QMI8658, touch
+  sensors_init();
+  energy_profiler_init(energy_state_name);
+  sensor_hub_subscribe(SENSOR_ACCEL, QMI_POLL_MS, 0.0f, on_accel_sample);
+  sensor_hub_subscribe(SENSOR_BATTERY_PERCENT, 30000, 1.0f, on_complication_changed);
+  sensor_hub_subscribe(SENSOR_PMIC_TEMP, 30000, 0.5f, on_complication_changed);
 
-  // AXP2101 power management init
-  init_axp2101();
+  // Clock governor: MCLK generation sets the floor (GameAudio moves it with the
+  // sample rate), loop() picks the level
+  clock_governor_init();
+  clock_governor_set_min_khz(audio_min_sys_khz());
 
   // Initialize game systems - use custom RNG to avoid hardware conflicts
   seed_rng(millis());
   init_pet();
 
+  // Persistent settings and game state (flushed by core1, see loop1)
+  config_init();
+  load_settings();
+
+  // Asset pack (optional, see tools/asset_packer)
+  load_assets();
+
   // Splash
   Paint_DrawString_EN(30, 180, "Pebble-Style Watch", &Font24, CASIO_GREEN, COL_BLACK);
   Paint_DrawString_EN(10, 210, "Complete Games Edition", &Font24, CASIO_GREEN, COL_BLACK);
@@ -1942,12 +1684,12 @@ void setup() {
   AMOLED_1IN8_Display(BlackImage);
   delay(3000);
 
-  last_tick_ms = millis();
   open_watchface();
 }
 
 void loop() {
   handle_touch();
+  handle_serial_commands();
 
   // BACK button debounce + brightness pop to 100%
   bool reading = digitalRead(BACK_BUTTON_PIN);
@@ -1963,32 +1705,56 @@ void loop() {
   }
   backLastState = reading;
 
-  tick_time();
+  rtc_clock_poll();
+  alarms_poll();
+  if (current_screen == SCR_ALARM_RING && !alarm_is_ringing()) open_watchface();  // timed out
   update_dimming();
-  qmi_poll_for_tap_wake();
+
+  // Sensor hub reads only what subscribers need (tap detection, battery, temp)
+  sensor_hub_poll();
+  energy_profiler_set_state(energy_state());
+  audio_out_poll();                       // drops the governor lock once playback stops
+  audio_in_poll();                        // feeds mic subscribers
+  clock_governor_request(clock_level_for_screen());
+  clock_governor_poll();
   
-  // Update sensor readings every loop
-  update_sensor_readings();
+  // Games: fixed simulation steps, frames at each game's own rate
+  if (current_screen == SCR_GAME_ARCADE) {
+    game_run(time_us_32());
+  }
   
-  // Update games - but not every loop to prevent overload
-  static uint32_t last_game_update = 0;
-  if (current_screen == SCR_GAME_ARCADE && millis() - last_game_update > 50) { // 20 FPS max
-    last_game_update = millis();
-    if (current_game == ASTEROIDS) {
-      update_asteroids();
-      draw_asteroids_game();
-    } else if (current_game == TETRIS) {
-      update_tetris();
-      draw_tetris_game();
-    } else if (current_game == SNAKE) {
-      update_snake();
-      draw_snake_game();
-    } else if (current_game == BREAKOUT) {
-      update_breakout();
-      draw_breakout_game();
+  // Spectrum visualiser, ~30 FPS; capture stops once the screen is left
+  if (current_screen == SCR_SPECTRUM) {
+    static uint32_t last_spectrum_frame = 0;
+    if (millis() - last_spectrum_frame >= 33) {
+      last_spectrum_frame = millis();
+      draw_spectrum_frame();
+    }
+  } else if (spectrum_active()) {
+    spectrum_stop();
+  }
+
+  // Music player position, and the '>' marker once a one-shot song ends
+  if (current_screen == SCR_MUSIC) {
+    static uint32_t last_music_status = 0;
+    static bool was_playing = false;
+    if (millis() - last_music_status >= 250) {
+      last_music_status = millis();
+      bool playing = audio_music_playing();
+      if (playing != was_playing) draw_music();
+      else if (playing) draw_music_status();
+      was_playing = playing;
     }
   }
-  
+
+  if (audio_overlay) {
+    static uint32_t last_overlay = 0;
+    if (millis() - last_overlay >= 500) {
+      last_overlay = millis();
+      draw_audio_overlay();
+    }
+  }
+
   // Tamagotchi updates
   if (current_screen == SCR_GAME_TAMAGOTCHI) {
     uint32_t now = millis();
@@ -2021,6 +1787,13 @@ void loop() {
         pet.health = max(0, pet.health - 3);
       }
     }
+
+    // Persist the pet; unchanged state costs nothing
+    static uint32_t last_pet_save = 0;
+    if (now - last_pet_save > 10000) {
+      last_pet_save = now;
+      save_pet();
+    }
     
     // Redraw every second to show animations
     if (now - last_redraw > 1000) {
@@ -2036,3 +1809,12 @@ void loop() {
 
   delay(10);
 }
+
+// ---------- Core1: background flash writes ----------
+void setup1() {
+}
+
+void loop1() {
+  config_flush_task();
+  delay(20);
+}
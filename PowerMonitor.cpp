@@ -0,0 +1,136 @@
+/*
+ * PowerMonitor.cpp - AXP2101 fuel gauge sampler implementation
+ */
+
+#include "PowerMonitor.h"
+#include "DEV_Config.h"
+#include "Sensors.h"
+
+// Shared with the touch handler in the sketch
+extern volatile uint8_t i2c_lock;
+
+// ---------- AXP2101 registers ----------
+#define AXP2101_SLAVE_ADDRESS    0x34
+#define AXP2101_STATUS1          0x00
+#define AXP2101_STATUS2          0x01
+#define AXP2101_ADC_CTRL         0x30
+#define AXP2101_ADC_VBAT_H       0x34     // 0x34..0x3D: VBAT, TS, VBUS, VSYS, TDIE
+#define AXP2101_ADC_BLOCK_LEN    10
+#define AXP2101_BAT_PERCENT      0xA4
+
+static PowerState state;
+static PowerState published;           // last values pushed to the sensor hub
+static bool       state_valid = false;
+static uint32_t   reads = 0;
+static uint32_t   last_read_ms = 0;
+
+static PowerSample history[POWER_HISTORY_LEN];
+static uint16_t    history_head = 0;     // next slot to write
+static uint16_t    history_count = 0;
+static uint32_t    last_history_ms = 0;
+
+void power_monitor_init() {
+  // Enable ADC for battery voltage and die temperature
+  uint8_t adc_ctrl = DEV_I2C_Read_Byte(AXP2101_SLAVE_ADDRESS, AXP2101_ADC_CTRL);
+  DEV_I2C_Write_Byte(AXP2101_SLAVE_ADDRESS, AXP2101_ADC_CTRL, adc_ctrl | 0x11);
+  state_valid = false;
+}
+
+static uint32_t current_period() {
+  if (!state_valid) return 0;
+  if (state.charging) return POWER_PERIOD_CHARGING_MS;
+  if (state.percent <= POWER_LOW_PERCENT) return POWER_PERIOD_LOW_MS;
+  return POWER_PERIOD_IDLE_MS;
+}
+
+// Three bursts: status, ADC block, gauge
+static void read_pmic(PowerState &s) {
+  uint8_t status[2];
+  uint8_t adc[AXP2101_ADC_BLOCK_LEN];
+
+  DEV_I2C_Read_nByte(AXP2101_SLAVE_ADDRESS, AXP2101_STATUS1, status, sizeof(status));
+  DEV_I2C_Read_nByte(AXP2101_SLAVE_ADDRESS, AXP2101_ADC_VBAT_H, adc, sizeof(adc));
+  uint8_t percent = DEV_I2C_Read_Byte(AXP2101_SLAVE_ADDRESS, AXP2101_BAT_PERCENT);
+
+  s.percent = percent > 100 ? 100 : percent;
+  s.charging = (status[1] >> 5) == 0x01;
+  s.vbat_mv = ((adc[0] & 0x3F) << 8) | adc[1];
+  uint16_t tdie = ((adc[8] & 0x3F) << 8) | adc[9];
+  s.temp_c = 22.0f + (7274 - (int)tdie) / 20.0f;
+}
+
+static void history_push(const PowerState &s) {
+  PowerSample &h = history[history_head];
+  h.vbat_mv = s.vbat_mv;
+  h.percent = s.percent | (s.charging ? 0x80 : 0);
+  h.temp_c = (int8_t)constrain((int)lroundf(s.temp_c), -128, 127);
+  history_head = (history_head + 1) % POWER_HISTORY_LEN;
+  if (history_count < POWER_HISTORY_LEN) history_count++;
+}
+
+static void publish(SensorId id, float v) {
+  float vals[3] = { v, 0, 0 };
+  sensor_hub_publish(id, vals);
+}
+
+void power_monitor_poll() {
+  uint32_t now = millis();
+  if (state_valid && now - last_read_ms < current_period()) return;
+
+  // Protect I2C access from conflicts with touch sensor
+  if (i2c_lock) return;
+  i2c_lock = 1;
+  PowerState s;
+  read_pmic(s);
+  i2c_lock = 0;
+
+  s.t_ms = now;
+  last_read_ms = now;
+  reads++;
+
+  bool first = !state_valid;
+  state = s;
+  state_valid = true;
+
+  // Only wake the UI for values that actually moved since last published
+  if (first || s.percent != published.percent) {
+    published.percent = s.percent;
+    publish(SENSOR_BATTERY_PERCENT, s.percent);
+  }
+  if (first || s.charging != published.charging) {
+    published.charging = s.charging;
+    publish(SENSOR_CHARGING, s.charging ? 1.0f : 0.0f);
+  }
+  if (first || s.vbat_mv != published.vbat_mv) {
+    published.vbat_mv = s.vbat_mv;
+    publish(SENSOR_BATTERY_VOLTAGE, s.vbat_mv);
+  }
+  if (first || fabsf(s.temp_c - published.temp_c) >= 0.5f) {
+    published.temp_c = s.temp_c;
+    publish(SENSOR_PMIC_TEMP, s.temp_c);
+  }
+
+  if (first || now - last_history_ms >= POWER_HISTORY_INTERVAL_MS) {
+    last_history_ms = now;
+    history_push(s);
+  }
+}
+
+const PowerState &power_monitor_state() {
+  return state;
+}
+
+uint32_t power_monitor_read_count() {
+  return reads;
+}
+
+uint16_t power_history_count() {
+  return history_count;
+}
+
+bool power_history_get(uint16_t idx, PowerSample *out) {
+  if (idx >= history_count) return false;
+  uint16_t oldest = (history_head + POWER_HISTORY_LEN - history_count) % POWER_HISTORY_LEN;
+  *out = history[(oldest + idx) % POWER_HISTORY_LEN];
+  return true;
+}
@@ -0,0 +1,48 @@
+/*
+ * PowerMonitor.h - AXP2101 fuel gauge sampler
+ *
+ * Samples the PMIC at an adaptive rate (fast while charging, slow while
+ * idle on battery), reads status, ADC and gauge registers in bursts and
+ * keeps a compact 24 hour history. New values are published into the
+ * sensor hub only when they actually change.
+ */
+
+#ifndef POWER_MONITOR_H
+#define POWER_MONITOR_H
+
+#include <Arduino.h>
+
+// Sampling cadence
+#define POWER_PERIOD_CHARGING_MS   5000
+#define POWER_PERIOD_LOW_MS        15000     // on battery, below POWER_LOW_PERCENT
+#define POWER_PERIOD_IDLE_MS       60000     // on battery
+#define POWER_LOW_PERCENT          15
+
+// History: one entry every 5 minutes for 24 hours
+#define POWER_HISTORY_INTERVAL_MS  (5UL * 60UL * 1000UL)
+#define POWER_HISTORY_LEN          288
+
+struct PowerSample {
+  uint16_t vbat_mv;
+  uint8_t  percent;     // bit 7 = charging
+  int8_t   temp_c;
+};
+
+struct PowerState {
+  uint8_t  percent;
+  bool     charging;
+  uint16_t vbat_mv;
+  float    temp_c;
+  uint32_t t_ms;        // when the PMIC was last read
+};
+
+void power_monitor_init();
+void power_monitor_poll();            // call from loop()
+const PowerState &power_monitor_state();
+uint32_t power_monitor_read_count();  // I2C bursts since boot
+
+// History access, index 0 = oldest
+uint16_t power_history_count();
+bool power_history_get(uint16_t idx, PowerSample *out);
+
+#endif // POWER_MONITOR_H
@@ -327,6 +327,21 @@ void QMI8658_read_acc_xyz(float acc_xyz[3])
 	// QMI8658_printf("fis210x acc:	%f	%f	%f\n", acc_xyz[0], acc_xyz[1], acc_xyz[2]);
 }
 
+void QMI8658_read_acc_raw(short raw_acc_xyz[3])
+{
+	unsigned char buf_reg[6];
+
+	QMI8658_read_reg(QMI8658Register_Ax_L, buf_reg, 6); // 0x19, 25
+	raw_acc_xyz[0] = (short)((unsigned short)(buf_reg[1] << 8) | (buf_reg[0]));
+	raw_acc_xyz[1] = (short)((unsigned short)(buf_reg[3] << 8) | (buf_reg[2]));
+	raw_acc_xyz[2] = (short)((unsigned short)(buf_reg[5] << 8) | (buf_reg[4]));
+}
+
+unsigned short QMI8658_get_acc_lsb_div(void)
+{
+	return acc_lsb_div;
+}
+
 void QMI8658_read_gyro_xyz(float gyro_xyz[3])
 {
 	unsigned char buf_reg[6];
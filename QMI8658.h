@@ -477,6 +477,8 @@ extern unsigned char QMI8658_init(void);
 extern void QMI8658_Config_apply(struct QMI8658Config const *config);
 extern void QMI8658_enableSensors(unsigned char enableFlags);
 extern void QMI8658_read_acc_xyz(float acc_xyz[3]);
+extern void QMI8658_read_acc_raw(short raw_acc_xyz[3]);
+extern unsigned short QMI8658_get_acc_lsb_div(void);
 extern void QMI8658_read_gyro_xyz(float gyro_xyz[3]);
 extern void QMI8658_read_xyz(float acc[3], float gyro[3], unsigned int *tim_count);
 extern void QMI8658_read_xyz_raw(short raw_acc_xyz[3], short raw_gyro_xyz[3], unsigned int *tim_count);
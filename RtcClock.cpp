@@ -0,0 +1,250 @@
+/*
+ * RtcClock.cpp - PCF85063 wall clock implementation
+ */
+
+#include "RtcClock.h"
+#include "DEV_Config.h"
+#include "SensorPCF85063.hpp"
+
+// Shared with the touch handler in the sketch
+extern volatile uint8_t i2c_lock;
+
+static SensorPCF85063 rtc;
+static bool     rtc_present = false;
+static bool     lost_power = false;
+static RtcMinuteFn minute_fn = nullptr;
+
+static RtcTime  cached;                  // time at sync_ms
+static uint32_t cached_epoch = 0;        // rtc_to_epoch(cached)
+static uint32_t sync_ms = 0;
+static uint32_t next_boundary_ms = 0;    // expected millis() of the next minute
+static volatile bool     irq_pending = false;
+static volatile uint32_t irq_count = 0;
+static uint32_t reads = 0;
+static bool     alarm_flag = false;
+
+uint8_t rtc_days_in_month(uint16_t year, uint8_t month) {
+  static const uint8_t DAYS[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+  if (month == 2 && ((year % 4 == 0 && year % 100 != 0) || year % 400 == 0)) return 29;
+  return DAYS[(month - 1) % 12];
+}
+
+// Sakamoto's method, 0 = Sunday
+uint8_t rtc_day_of_week(uint16_t year, uint8_t month, uint8_t day) {
+  static const uint8_t T[12] = { 0, 3, 2, 5, 0, 3, 5, 1, 4, 6, 2, 4 };
+  if (month < 3) year--;
+  return (year + year / 4 - year / 100 + year / 400 + T[month - 1] + day) % 7;
+}
+
+static void set_cache(const RtcTime &t) {
+  cached = t;
+  cached_epoch = rtc_to_epoch(t);
+  sync_ms = millis();
+  next_boundary_ms = sync_ms + (60 - t.second) * 1000UL;
+}
+
+// Software timekeeping when no RTC answers
+static void advance_minute(RtcTime &t) {
+  t.second = 0;
+  if (++t.minute < 60) return;
+  t.minute = 0;
+  if (++t.hour < 24) return;
+  t.hour = 0;
+  t.weekday = (t.weekday + 1) % 7;
+  if (++t.day <= rtc_days_in_month(t.year, t.month)) return;
+  t.day = 1;
+  if (++t.month <= 12) return;
+  t.month = 1;
+  t.year++;
+}
+
+static bool read_rtc(RtcTime &t) {
+  if (i2c_lock) return false;
+  i2c_lock = 1;
+  if (rtc.readAndClearFlags() & PCF85063_CTRL2_AF) alarm_flag = true;
+  RTC_DateTime dt = rtc.getDateTime();
+  i2c_lock = 0;
+  reads++;
+
+  t.year = dt.year;
+  t.month = dt.month;
+  t.day = dt.day;
+  t.hour = dt.hour;
+  t.minute = dt.minute;
+  t.second = dt.second;
+  t.weekday = dt.weekday;
+  return true;
+}
+
+static void write_rtc(const RtcTime &t) {
+  if (rtc_present) {
+    while (i2c_lock);
+    i2c_lock = 1;
+    rtc.setDateTime(t.year, t.month, t.day, t.hour, t.minute, t.second, t.weekday);
+    i2c_lock = 0;
+  }
+  set_cache(t);
+}
+
+bool rtc_clock_init(RtcMinuteFn on_minute) {
+  minute_fn = on_minute;
+  rtc_present = rtc.begin(Wire1);
+
+  // Last known defaults, used when the RTC is missing or lost power
+  RtcTime t = { 2025, 10, 23, 12, 0, 0, 0 };
+  t.weekday = rtc_day_of_week(t.year, t.month, t.day);
+
+  if (!rtc_present) {
+    set_cache(t);
+    return false;
+  }
+
+  rtc.start();
+  lost_power = !rtc.isClockIntegrityOK();
+  if (lost_power) {
+    write_rtc(t);
+  } else {
+    read_rtc(t);
+    set_cache(t);
+  }
+  rtc.enableMinuteInterrupt(true);
+
+  gpio_init(RTC_INT_PIN);
+  gpio_set_dir(RTC_INT_PIN, GPIO_IN);
+  gpio_pull_up(RTC_INT_PIN);
+  gpio_set_irq_enabled(RTC_INT_PIN, GPIO_IRQ_EDGE_FALL, true);
+  return true;
+}
+
+void rtc_clock_irq() {
+  irq_pending = true;
+  irq_count++;
+}
+
+void rtc_clock_poll() {
+  uint32_t now = millis();
+
+  if (!rtc_present) {
+    if ((int32_t)(now - next_boundary_ms) < 0) return;
+    advance_minute(cached);
+    cached_epoch = rtc_to_epoch(cached);
+    sync_ms = next_boundary_ms;          // keep the software clock drift-free
+    next_boundary_ms += 60000UL;
+    if (minute_fn) minute_fn(cached);
+    return;
+  }
+
+  bool overdue = (int32_t)(now - next_boundary_ms) >= (int32_t)RTC_IRQ_GRACE_MS;
+  if (!irq_pending && !overdue) return;
+
+  RtcTime t;
+  if (!read_rtc(t)) return;              // bus busy, retry next loop
+  irq_pending = false;
+
+  bool new_minute = t.minute != cached.minute || t.hour != cached.hour || t.day != cached.day;
+  set_cache(t);
+  if (new_minute && minute_fn) minute_fn(cached);
+}
+
+RtcTime rtc_clock_now() {
+  RtcTime t = cached;
+  uint32_t s = t.second + (millis() - sync_ms) / 1000;
+  t.second = s > 59 ? 59 : s;
+  return t;
+}
+
+void rtc_clock_set_time(uint8_t hour, uint8_t minute) {
+  RtcTime t = cached;
+  t.hour = hour;
+  t.minute = minute;
+  t.second = 0;
+  write_rtc(t);
+}
+
+void rtc_clock_set_date(uint16_t year, uint8_t month, uint8_t day) {
+  RtcTime t = rtc_clock_now();
+  t.year = year;
+  t.month = month;
+  uint8_t dim = rtc_days_in_month(year, month);
+  t.day = day > dim ? dim : day;
+  t.weekday = rtc_day_of_week(t.year, t.month, t.day);
+  write_rtc(t);
+}
+
+uint32_t rtc_to_epoch(const RtcTime &t) {
+  uint32_t days = 0;
+  for (uint16_t y = 2000; y < t.year; y++) days += rtc_days_in_month(y, 2) == 29 ? 366 : 365;
+  for (uint8_t m = 1; m < t.month; m++) days += rtc_days_in_month(t.year, m);
+  days += t.day - 1;
+  return days * 86400UL + t.hour * 3600UL + t.minute * 60UL + t.second;
+}
+
+RtcTime rtc_from_epoch(uint32_t epoch) {
+  RtcTime t;
+  uint32_t days = epoch / 86400UL;
+  uint32_t rem = epoch % 86400UL;
+  t.hour = rem / 3600;
+  t.minute = (rem / 60) % 60;
+  t.second = rem % 60;
+  t.weekday = (6 + days) % 7;            // 2000-01-01 was a Saturday
+  t.year = 2000;
+  for (;;) {
+    uint16_t len = rtc_days_in_month(t.year, 2) == 29 ? 366 : 365;
+    if (days < len) break;
+    days -= len;
+    t.year++;
+  }
+  t.month = 1;
+  while (days >= rtc_days_in_month(t.year, t.month)) {
+    days -= rtc_days_in_month(t.year, t.month);
+    t.month++;
+  }
+  t.day = days + 1;
+  return t;
+}
+
+uint32_t rtc_clock_epoch() {
+  uint32_t s = (millis() - sync_ms) / 1000;
+  if (cached.second + s > 59) s = 59 - cached.second;    // as rtc_clock_now()
+  return cached_epoch + s;
+}
+
+void rtc_clock_set_alarm(uint32_t epoch) {
+  if (!rtc_present) return;
+  RtcTime t = rtc_from_epoch(epoch);
+  while (i2c_lock);
+  i2c_lock = 1;
+  rtc.setAlarm(t.day, t.hour, t.minute, t.second);
+  i2c_lock = 0;
+}
+
+void rtc_clock_clear_alarm() {
+  if (!rtc_present) return;
+  while (i2c_lock);
+  i2c_lock = 1;
+  rtc.disableAlarm();
+  i2c_lock = 0;
+  alarm_flag = false;
+}
+
+bool rtc_clock_take_alarm_flag() {
+  bool f = alarm_flag;
+  alarm_flag = false;
+  return f;
+}
+
+bool rtc_clock_present() {
+  return rtc_present;
+}
+
+bool rtc_clock_lost_power() {
+  return lost_power;
+}
+
+uint32_t rtc_clock_irq_count() {
+  return irq_count;
+}
+
+uint32_t rtc_clock_read_count() {
+  return reads;
+}
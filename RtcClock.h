@@ -0,0 +1,74 @@
+/*
+ * RtcClock.h - PCF85063 wall clock
+ *
+ * The RTC is the only source of date and time. At every minute boundary
+ * it sets TF and pulls INT (open drain, active low) down; INT is a level,
+ * not a pulse, and stays low until the flags are read and cleared. The
+ * falling edge schedules one read of the clock, which is cached so
+ * callers never touch the bus, and that read also clears TF so the next
+ * boundary gives a fresh edge. If no edge arrives (the pin is not wired,
+ * or the line was already low) the clock is re-read shortly after the
+ * expected boundary instead, which clears TF just the same.
+ * Without a responding RTC, time is kept in software from millis().
+ * The same INT line carries the hardware alarm used by the Alarms module.
+ */
+
+#ifndef RTC_CLOCK_H
+#define RTC_CLOCK_H
+
+#include <Arduino.h>
+
+// Re-read the RTC this long after an expected minute boundary that
+// produced no interrupt
+#define RTC_IRQ_GRACE_MS   1500
+
+struct RtcTime {
+  uint16_t year;
+  uint8_t  month;     // 1..12
+  uint8_t  day;       // 1..31
+  uint8_t  hour;      // 0..23
+  uint8_t  minute;
+  uint8_t  second;
+  uint8_t  weekday;   // 0 = Sunday
+};
+
+// Called from rtc_clock_poll() once per new minute
+typedef void (*RtcMinuteFn)(const RtcTime &t);
+
+// Probe the RTC, start it (setting a default time if it lost power),
+// enable the minute interrupt and arm RTC_INT_PIN. The sketch's GPIO
+// callback must forward RTC_INT_PIN events to rtc_clock_irq().
+bool rtc_clock_init(RtcMinuteFn on_minute);
+
+// GPIO interrupt context: only flags the event
+void rtc_clock_irq();
+
+// Service interrupt flags / fallback reads; call from loop()
+void rtc_clock_poll();
+
+// Cached time, seconds extrapolated from millis()
+RtcTime rtc_clock_now();
+
+void rtc_clock_set_time(uint8_t hour, uint8_t minute);
+void rtc_clock_set_date(uint16_t year, uint8_t month, uint8_t day);
+
+// Seconds since 2000-01-01 00:00 (the RTC's epoch), from the cached time;
+// the calendar maths runs once per minute, so this is cheap every loop
+uint32_t rtc_clock_epoch();
+uint32_t rtc_to_epoch(const RtcTime &t);
+RtcTime rtc_from_epoch(uint32_t epoch);
+
+// Hardware alarm: one pending alarm at an absolute time, raised on INT
+void rtc_clock_set_alarm(uint32_t epoch);
+void rtc_clock_clear_alarm();
+bool rtc_clock_take_alarm_flag();     // true once per alarm that fired
+
+bool rtc_clock_present();
+bool rtc_clock_lost_power();          // time was invalid at boot
+uint32_t rtc_clock_irq_count();
+uint32_t rtc_clock_read_count();
+
+uint8_t rtc_days_in_month(uint16_t year, uint8_t month);
+uint8_t rtc_day_of_week(uint16_t year, uint8_t month, uint8_t day);
+
+#endif // RTC_CLOCK_H
@@ -0,0 +1,141 @@
+/*
+ * SamplePlayer.cpp - Streaming clip playback from flash implementation
+ */
+
+#include "SamplePlayer.h"
+#include "AssetPack.h"
+#include "Adpcm.h"
+#include <string.h>
+
+struct ClipVoice {
+  bool     active;
+  bool     adpcm;
+  const uint8_t *data;       // PCM samples or the first ADPCM block
+  uint32_t total;            // samples in the clip
+  uint32_t pos;              // next sample to decode
+  uint16_t block_bytes;
+  uint32_t block_samples;
+  AdpcmState st;
+  uint32_t frac;             // 16.16 position between s0 and s1
+  uint32_t step;             // 16.16 clip samples per output sample
+  int32_t  s0, s1;
+  int32_t  volume;           // Q15
+  uint32_t started;
+  uint8_t  bus;
+};
+
+static ClipVoice clips[SAMPLE_VOICES];
+static uint32_t  out_rate = 24000;
+static uint32_t  start_count = 0;
+
+// Next clip sample, decoded from flash on demand
+static int32_t next_sample(ClipVoice &v) {
+  if (v.pos >= v.total) return 0;
+  uint32_t i = v.pos++;
+  if (!v.adpcm) {
+    const uint8_t *p = v.data + i * 2;
+    return (int16_t)(p[0] | p[1] << 8);
+  }
+
+  uint32_t in_block = i % v.block_samples;
+  const uint8_t *block = v.data + (i / v.block_samples) * v.block_bytes;
+  if (in_block == 0) {
+    v.st.predictor = (int16_t)(block[0] | block[1] << 8);
+    v.st.index = block[2] > 88 ? 88 : block[2];
+    return v.st.predictor;
+  }
+  uint32_t nib = in_block - 1;
+  uint8_t byte = block[4 + nib / 2];
+  return adpcm_decode_nibble(v.st, (nib & 1) ? byte >> 4 : byte & 0x0F);
+}
+
+void sample_player_init(uint32_t output_rate) {
+  out_rate = output_rate;
+  memset(clips, 0, sizeof(clips));
+}
+
+int8_t sample_player_start(const uint8_t *data, uint32_t size, uint16_t format, uint32_t rate,
+                           uint16_t volume, uint8_t bus) {
+  if (!data || !rate) return -1;
+
+  ClipVoice c = {};
+  if (format == ASSET_PCM16) {
+    c.data = data;
+    c.total = size / 2;
+  } else if (format == ASSET_ADPCM) {
+    if (size < sizeof(AdpcmHeader)) return -1;
+    AdpcmHeader h;
+    memcpy(&h, data, sizeof(h));
+    if (h.block_bytes <= 4) return -1;
+    c.adpcm = true;
+    c.data = data + sizeof(AdpcmHeader);
+    c.block_bytes = h.block_bytes;
+    c.block_samples = adpcm_samples_per_block(h.block_bytes);
+    uint32_t blocks = (size - sizeof(AdpcmHeader)) / h.block_bytes;
+    c.total = h.sample_count < blocks * c.block_samples ? h.sample_count : blocks * c.block_samples;
+  } else {
+    return -1;
+  }
+  if (!c.total) return -1;
+
+  int8_t slot = 0;
+  for (int8_t i = 0; i < SAMPLE_VOICES; i++) {
+    if (!clips[i].active) {
+      slot = i;
+      break;
+    }
+    if ((int32_t)(clips[i].started - clips[slot].started) < 0) slot = i;
+  }
+
+  c.step = (uint32_t)(((uint64_t)rate << 16) / out_rate);
+  c.volume = volume;
+  c.bus = bus;
+  c.started = start_count++;
+  c.s0 = next_sample(c);
+  c.s1 = next_sample(c);
+  c.active = true;
+  clips[slot] = c;
+  return slot;
+}
+
+void sample_player_stop(int8_t voice) {
+  if (voice >= 0 && voice < SAMPLE_VOICES) clips[voice].active = false;
+}
+
+void sample_player_stop_all() {
+  for (uint8_t i = 0; i < SAMPLE_VOICES; i++) clips[i].active = false;
+}
+
+uint8_t sample_player_active() {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < SAMPLE_VOICES; i++) n += clips[i].active;
+  return n;
+}
+
+bool sample_player_mix(int16_t *out, uint32_t frames, uint8_t bus) {
+  bool any = false;
+  for (uint8_t c = 0; c < SAMPLE_VOICES; c++) {
+    ClipVoice &v = clips[c];
+    if (!v.active || v.bus != bus) continue;
+    any = true;
+
+    for (uint32_t i = 0; i < frames; i++) {
+      int32_t s = v.s0 + (((v.s1 - v.s0) * (int32_t)(v.frac >> 1)) >> 15);
+      int32_t mixed = out[i] + ((s * v.volume) >> 15);
+      out[i] = mixed > 32767 ? 32767 : (mixed < -32768 ? -32768 : mixed);
+
+      v.frac += v.step;
+      while (v.frac >= 0x10000) {
+        v.frac -= 0x10000;
+        v.s0 = v.s1;
+        v.s1 = next_sample(v);
+      }
+      // Both taps are past the end of the clip
+      if (v.pos >= v.total && v.s0 == 0 && v.s1 == 0) {
+        v.active = false;
+        break;
+      }
+    }
+  }
+  return any;
+}
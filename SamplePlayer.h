@@ -0,0 +1,37 @@
+/*
+ * SamplePlayer.h - Streaming clip playback from flash
+ *
+ * Plays ASSET_PCM16 and ASSET_ADPCM clips straight out of their XIP
+ * pointers: each refill decodes just the samples it needs into the output
+ * block, so nothing is copied or allocated and RAM use does not depend
+ * on clip length. Clips recorded at another rate (8 or 16 kHz voice, say)
+ * are resampled to the output rate with linear interpolation.
+ *
+ * No Arduino dependencies. Not reentrant: callers serialise start/stop
+ * against sample_player_mix().
+ */
+
+#ifndef SAMPLE_PLAYER_H
+#define SAMPLE_PLAYER_H
+
+#include <stdint.h>
+
+#define SAMPLE_VOICES  2
+
+void sample_player_init(uint32_t output_rate);
+
+// data/size/format/param as in an Asset (format ASSET_PCM16 or ASSET_ADPCM,
+// param = the clip's sample rate); volume is Q15; bus is the mixer channel
+// it plays on. Returns the voice, or -1 for an unsupported clip. The oldest
+// clip is replaced when all are busy.
+int8_t sample_player_start(const uint8_t *data, uint32_t size, uint16_t format, uint32_t rate,
+                           uint16_t volume, uint8_t bus = 0);
+
+void sample_player_stop(int8_t voice);
+void sample_player_stop_all();
+uint8_t sample_player_active();
+
+// Add the clips playing on bus into out (saturating); false if there were none
+bool sample_player_mix(int16_t *out, uint32_t frames, uint8_t bus);
+
+#endif // SAMPLE_PLAYER_H
@@ -5,6 +5,24 @@
 
 #define PCF85063_SLAVE_ADDRESS 0x51
 
+// Registers
+#define PCF85063_CONTROL_1     0x00
+#define PCF85063_CONTROL_2     0x01
+#define PCF85063_SECONDS       0x04
+#define PCF85063_SECOND_ALARM  0x0B
+
+// Control_1 bits
+#define PCF85063_CTRL1_STOP    0x20
+
+// Control_2 bits
+#define PCF85063_CTRL2_AIE     0x80   // alarm interrupt enable
+#define PCF85063_CTRL2_AF      0x40   // alarm flag
+#define PCF85063_CTRL2_MI      0x20   // minute interrupt enable
+#define PCF85063_CTRL2_TF      0x08   // timer / minute interrupt flag
+
+#define PCF85063_SECONDS_OS    0x80   // oscillator stopped, time invalid
+#define PCF85063_ALARM_OFF     0x80   // AEN_x: 1 = field ignored
+
 // Simple date/time container
 class RTC_DateTime {
 public:
@@ -14,6 +32,7 @@ public:
   uint8_t hour;
   uint8_t minute;
   uint8_t second;
+  uint8_t weekday;   // 0 = Sunday
 };
 
 // Minimal PCF85063 driver
@@ -51,26 +70,88 @@ public:
     t.day    = bcd2dec(day);
     t.month  = bcd2dec(month);
     t.year   = 2000 + bcd2dec(year);
+    t.weekday = weekday;
     return t;
   }
 
-  void setDateTime(uint16_t y, uint8_t m, uint8_t d, uint8_t h, uint8_t mi, uint8_t s) {
+  void setDateTime(uint16_t y, uint8_t m, uint8_t d, uint8_t h, uint8_t mi, uint8_t s, uint8_t wd = 0) {
     _wire->beginTransmission(_addr);
     _wire->write(0x04); // start at seconds register
     _wire->write(dec2bcd(s));
     _wire->write(dec2bcd(mi));
     _wire->write(dec2bcd(h));
     _wire->write(dec2bcd(d));
-    _wire->write(0x00); // weekday not set
+    _wire->write(wd & 0x07);
     _wire->write(dec2bcd(m));
     _wire->write(dec2bcd(y - 2000));
     _wire->endTransmission();
   }
 
+  // False if the oscillator stopped since the time was last set
+  bool isClockIntegrityOK() {
+    return !(readReg(PCF85063_SECONDS) & PCF85063_SECONDS_OS);
+  }
+
+  void start() {
+    writeReg(PCF85063_CONTROL_1, readReg(PCF85063_CONTROL_1) & ~PCF85063_CTRL1_STOP);
+  }
+
+  // Set TF at every minute boundary; INT stays low until TF is cleared
+  // with readAndClearFlags()
+  void enableMinuteInterrupt(bool en) {
+    uint8_t c2 = readReg(PCF85063_CONTROL_2) & ~(PCF85063_CTRL2_AF | PCF85063_CTRL2_TF);
+    if (en) c2 |= PCF85063_CTRL2_MI; else c2 &= ~PCF85063_CTRL2_MI;
+    writeReg(PCF85063_CONTROL_2, c2 | PCF85063_CTRL2_AF);   // writing AF=1 leaves it unchanged
+  }
+
+  // Alarm when day (1..31, 0 = every day), hour, minute and second match;
+  // INT stays low until the flag is cleared
+  void setAlarm(uint8_t day, uint8_t hour, uint8_t minute, uint8_t second = 0) {
+    _wire->beginTransmission(_addr);
+    _wire->write(PCF85063_SECOND_ALARM);
+    _wire->write(dec2bcd(second));
+    _wire->write(dec2bcd(minute));
+    _wire->write(dec2bcd(hour));
+    _wire->write(day ? dec2bcd(day) : PCF85063_ALARM_OFF);
+    _wire->write(PCF85063_ALARM_OFF);      // weekday
+    _wire->endTransmission();
+    uint8_t c2 = readReg(PCF85063_CONTROL_2) & ~PCF85063_CTRL2_AF;
+    writeReg(PCF85063_CONTROL_2, c2 | PCF85063_CTRL2_AIE | PCF85063_CTRL2_TF);
+  }
+
+  void disableAlarm() {
+    uint8_t c2 = readReg(PCF85063_CONTROL_2) & ~(PCF85063_CTRL2_AIE | PCF85063_CTRL2_AF);
+    writeReg(PCF85063_CONTROL_2, c2 | PCF85063_CTRL2_TF);
+  }
+
+  // Read and clear the alarm / minute flags; returns the Control_2 bits
+  // that were set (PCF85063_CTRL2_AF, PCF85063_CTRL2_TF)
+  uint8_t readAndClearFlags() {
+    uint8_t c2 = readReg(PCF85063_CONTROL_2);
+    uint8_t flags = c2 & (PCF85063_CTRL2_AF | PCF85063_CTRL2_TF);
+    if (flags) writeReg(PCF85063_CONTROL_2, c2 & ~flags);
+    return flags;
+  }
+
 private:
   TwoWire *_wire;
   uint8_t _addr;
 
+  uint8_t readReg(uint8_t reg) {
+    _wire->beginTransmission(_addr);
+    _wire->write(reg);
+    _wire->endTransmission(false);
+    _wire->requestFrom(_addr, (uint8_t)1);
+    return _wire->read();
+  }
+
+  void writeReg(uint8_t reg, uint8_t val) {
+    _wire->beginTransmission(_addr);
+    _wire->write(reg);
+    _wire->write(val);
+    _wire->endTransmission();
+  }
+
   uint8_t bcd2dec(uint8_t val) { return ((val / 16 * 10) + (val % 16)); }
   uint8_t dec2bcd(uint8_t val) { return ((val / 10 * 16) + (val % 10)); }
 };
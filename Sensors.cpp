@@ -1,3 +1,184 @@
 #include "Sensors.h"
 
 // Sensors module implementation
+
+#include "DEV_Config.h"
+#include "QMI8658.h"
+#include "PowerMonitor.h"
+
+// Shared with the touch handler in the sketch
+extern volatile uint8_t i2c_lock;
+
+static bool read_accel(float out[3]) {
+  short raw[3];
+  QMI8658_read_acc_raw(raw);
+  out[0] = raw[0];
+  out[1] = raw[1];
+  out[2] = raw[2];
+  return true;
+}
+
+// ---------- Hub state ----------
+struct SensorSource {
+  SensorReadFn  fn;
+  uint32_t      native_period;
+  uint32_t      period;         // effective poll period, 0 = nobody listening
+  uint32_t      last_read_ms;
+  uint32_t      reads;
+  SensorReading reading;
+};
+
+struct SensorSubscriber {
+  bool           used;
+  bool           notified;
+  SensorId       id;
+  uint32_t       period;
+  float          min_delta;
+  SensorCallback cb;
+  void          *ctx;
+  uint32_t       last_notify_ms;
+  float          last_v[3];
+};
+
+static SensorSource     sources[SENSOR_COUNT];
+static SensorSubscriber subscribers[SENSOR_MAX_SUBSCRIBERS];
+
+// Poll a source as fast as its most demanding subscriber wants, but never
+// faster than the hardware produces new data
+static void recompute_period(SensorId id) {
+  SensorSource &src = sources[id];
+  uint32_t period = 0;
+  for (int i = 0; i < SENSOR_MAX_SUBSCRIBERS; i++) {
+    const SensorSubscriber &s = subscribers[i];
+    if (!s.used || s.id != id) continue;
+    uint32_t p = max(s.period, src.native_period);
+    if (period == 0 || p < period) period = p;
+  }
+  src.period = period;
+}
+
+static void notify(SensorId id) {
+  const SensorReading &r = sources[id].reading;
+  for (int i = 0; i < SENSOR_MAX_SUBSCRIBERS; i++) {
+    SensorSubscriber &s = subscribers[i];
+    if (!s.used || s.id != id) continue;
+    if (s.notified) {
+      if (r.t_ms - s.last_notify_ms < s.period) continue;
+      if (s.min_delta > 0.0f) {
+        bool changed = false;
+        for (int k = 0; k < 3; k++) {
+          if (fabsf(r.v[k] - s.last_v[k]) >= s.min_delta) { changed = true; break; }
+        }
+        if (!changed) continue;
+      }
+    }
+    s.notified = true;
+    s.last_notify_ms = r.t_ms;
+    memcpy(s.last_v, r.v, sizeof(s.last_v));
+    s.cb(id, r, s.ctx);
+  }
+}
+
+void sensor_hub_register(SensorId id, uint32_t native_period_ms, SensorReadFn fn) {
+  sources[id].fn = fn;
+  sources[id].native_period = native_period_ms;
+  recompute_period(id);
+}
+
+int8_t sensor_hub_subscribe(SensorId id, uint32_t period_ms, float min_delta, SensorCallback cb, void *ctx) {
+  for (int i = 0; i < SENSOR_MAX_SUBSCRIBERS; i++) {
+    SensorSubscriber &s = subscribers[i];
+    if (s.used) continue;
+    s.used = true;
+    s.notified = false;
+    s.id = id;
+    s.period = period_ms;
+    s.min_delta = min_delta;
+    s.cb = cb;
+    s.ctx = ctx;
+    recompute_period(id);
+    // Hand over a cached value straight away if there is one
+    if (sources[id].reading.version) notify(id);
+    return i;
+  }
+  return -1;
+}
+
+void sensor_hub_unsubscribe(int8_t handle) {
+  if (handle < 0 || handle >= SENSOR_MAX_SUBSCRIBERS || !subscribers[handle].used) return;
+  subscribers[handle].used = false;
+  recompute_period(subscribers[handle].id);
+}
+
+void sensor_hub_publish(SensorId id, const float v[3]) {
+  SensorReading &r = sources[id].reading;
+  memcpy(r.v, v, sizeof(r.v));
+  r.t_ms = millis();
+  r.version++;
+  notify(id);
+}
+
+const SensorReading &sensor_hub_get(SensorId id) {
+  return sources[id].reading;
+}
+
+uint32_t sensor_hub_read_count(SensorId id) {
+  return sources[id].reads;
+}
+
+// One bus read of a polled source, with the touch handler held off the bus
+static void read_source(SensorId id, uint32_t now) {
+  SensorSource &src = sources[id];
+  float v[3] = {0, 0, 0};
+  i2c_lock = 1;
+  bool ok = src.fn(v);
+  i2c_lock = 0;
+  src.last_read_ms = now;
+  src.reads++;
+  if (!ok) return;
+
+  memcpy(src.reading.v, v, sizeof(v));
+  src.reading.t_ms = now;
+  src.reading.version++;
+  notify(id);
+}
+
+void sensor_hub_poll() {
+  // PMIC runs its own adaptive schedule
+  power_monitor_poll();
+
+  // Protect I2C access from conflicts with touch sensor
+  if (i2c_lock) return;
+
+  uint32_t now = millis();
+  int best = -1;
+  uint32_t best_late = 0;
+  for (int i = 0; i < SENSOR_COUNT; i++) {
+    const SensorSource &src = sources[i];
+    if (!src.fn || !src.period) continue;
+    uint32_t since = now - src.last_read_ms;
+    if (src.reading.version && since < src.period) continue;
+    uint32_t late = src.reading.version ? since - src.period : UINT32_MAX;
+    if (best < 0 || late > best_late) { best = i; best_late = late; }
+  }
+  if (best >= 0) read_source((SensorId)best, now);
+}
+
+void sensors_init() {
+  // AXP2101 channels are pushed by the power monitor on change
+  power_monitor_init();
+  sensor_hub_register(SENSOR_BATTERY_PERCENT,  0,  nullptr);
+  sensor_hub_register(SENSOR_BATTERY_VOLTAGE,  0,  nullptr);
+  sensor_hub_register(SENSOR_PMIC_TEMP,        0,  nullptr);
+  sensor_hub_register(SENSOR_CHARGING,         0,  nullptr);
+
+  sensor_hub_register(SENSOR_ACCEL,           25,  read_accel);   // 40Hz
+  sensor_hub_register(SENSOR_TOUCH,            0,  nullptr);      // pushed by the touch handler
+
+  // First sample now, so the getters and the first subscribers see real
+  // readings rather than zeroes (0 %, 32F) until the loop gets round to it
+  power_monitor_poll();
+  for (int i = 0; i < SENSOR_COUNT; i++) {
+    if (sources[i].fn) read_source((SensorId)i, millis());
+  }
+}
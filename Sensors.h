@@ -1,3 +1,62 @@
 #pragma once
 
 // Sensors module header
+//
+// Sensor hub: every source declares its native rate, consumers subscribe
+// with a desired period and/or an on-change delta, and the hub reads each
+// source only as often as the most demanding subscriber needs (and never
+// faster than its native rate). Readings are cached with a timestamp and
+// version so UI code can read them at any time without touching the bus.
+
+#include <Arduino.h>
+
+enum SensorId : uint8_t {
+  SENSOR_BATTERY_PERCENT,   // v[0] = 0..100 %
+  SENSOR_PMIC_TEMP,         // v[0] = AXP2101 die temperature, Celsius
+  SENSOR_CHARGING,          // v[0] = 1 while charging
+  SENSOR_BATTERY_VOLTAGE,   // v[0] = battery voltage, mV
+  SENSOR_ACCEL,             // v[0..2] = raw QMI8658 accelerometer counts
+  SENSOR_TOUCH,             // v[0..1] = last touch point (pushed, not polled)
+  SENSOR_COUNT
+};
+
+struct SensorReading {
+  float    v[3];
+  uint32_t t_ms;            // millis() when the value was read
+  uint32_t version;         // bumps on every new reading, 0 = never read
+};
+
+// Returns false if the read could not be done (value left untouched)
+typedef bool (*SensorReadFn)(float out[3]);
+typedef void (*SensorCallback)(SensorId id, const SensorReading &r, void *ctx);
+
+#define SENSOR_MAX_SUBSCRIBERS 12
+
+// Register a polled source. native_period_ms is the fastest useful rate;
+// use sensor_hub_publish() instead for event-driven sources.
+void sensor_hub_register(SensorId id, uint32_t native_period_ms, SensorReadFn fn);
+
+// Subscribe to a sensor. period_ms is the desired update period (0 = the
+// source's native rate). min_delta > 0 only notifies when any component
+// moved by at least that much since the last notification. Returns a
+// handle, or -1 if the subscriber table is full.
+int8_t sensor_hub_subscribe(SensorId id, uint32_t period_ms, float min_delta, SensorCallback cb, void *ctx = nullptr);
+void sensor_hub_unsubscribe(int8_t handle);
+
+// Push a new value for an event-driven source (or override a polled one)
+void sensor_hub_publish(SensorId id, const float v[3]);
+
+// Cached value, free to call from anywhere
+const SensorReading &sensor_hub_get(SensorId id);
+
+// Service due sources (and the PMIC monitor); call from loop(). Does at
+// most one polled-source bus read per call.
+void sensor_hub_poll();
+
+// Number of hardware reads performed for a source since boot
+uint32_t sensor_hub_read_count(SensorId id);
+
+// Register the board's standard sources (AXP2101 via PowerMonitor,
+// QMI8658, touch) and take a first reading of each polled one, so every
+// value except touch is valid (version > 0) once this returns
+void sensors_init();
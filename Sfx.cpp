@@ -0,0 +1,164 @@
+/*
+ * Sfx.cpp - Sound effect sequencer implementation
+ */
+
+#include "Sfx.h"
+
+#define SFX_BARRIER() __asm__ volatile("" ::: "memory")
+
+struct Player {
+  const SfxScript *script;
+  uint8_t  id;
+  uint8_t  step;
+  bool     active;
+  uint32_t next_at;          // sample clock of the next step
+  uint32_t started;
+};
+
+static const SynthEnvelope ENV_BOOM = { 1, 450,     0, 50 };
+static const SynthEnvelope ENV_BLIP = { 1,   0, 32767,  8 };
+
+static const SynthEnvelope *const ENVELOPES[] = {
+  &SYNTH_ENV_PLUCK, &SYNTH_ENV_ORGAN, &SYNTH_ENV_SOFT, &ENV_BOOM, &ENV_BLIP,
+};
+
+static const SfxScript *scripts = nullptr;
+static uint8_t  script_count = 0;
+static uint32_t rate = 24000;
+static Player   players[SFX_PLAYERS];
+
+// Trigger requests: loop() produces, the refill interrupt consumes
+static uint8_t  requests[SFX_QUEUE_LEN];
+static volatile uint8_t req_head = 0;
+static volatile uint8_t req_tail = 0;
+static volatile bool    cancel_requested = false;
+
+// Synth tag of a player's notes (0 is left for untagged notes)
+static inline uint8_t tag_of(uint8_t p) {
+  return p + 1;
+}
+
+static void cut(uint8_t p) {
+  synth_release_tag(tag_of(p));
+  players[p].active = false;
+}
+
+static void start(uint8_t id, uint32_t now) {
+  if (id >= script_count) return;
+  const SfxScript &s = scripts[id];
+
+  // Same effect, or same group: the newcomer must not be outranked
+  bool conflict[SFX_PLAYERS] = {};
+  for (uint8_t p = 0; p < SFX_PLAYERS; p++) {
+    const Player &pl = players[p];
+    if (!pl.active) continue;
+    if (pl.id == id || (s.group != SFX_GROUP_NONE && pl.script->group == s.group)) {
+      if (pl.script->priority > s.priority) return;
+      conflict[p] = true;
+    }
+  }
+  int8_t slot = -1;
+  for (uint8_t p = 0; p < SFX_PLAYERS; p++) {
+    if (conflict[p]) {
+      cut(p);
+      if (slot < 0) slot = p;
+    }
+  }
+
+  // Otherwise a free player, else the weakest (oldest on ties) if it does not outrank us
+  for (uint8_t p = 0; slot < 0 && p < SFX_PLAYERS; p++) {
+    if (!players[p].active) slot = p;
+  }
+  if (slot < 0) {
+    uint8_t victim = 0;
+    for (uint8_t p = 1; p < SFX_PLAYERS; p++) {
+      const Player &a = players[p], &b = players[victim];
+      if (a.script->priority < b.script->priority ||
+          (a.script->priority == b.script->priority && (int32_t)(a.started - b.started) < 0)) {
+        victim = p;
+      }
+    }
+    if (players[victim].script->priority > s.priority) return;
+    cut(victim);
+    slot = victim;
+  }
+
+  Player &pl = players[slot];
+  pl.script = &s;
+  pl.id = id;
+  pl.step = 0;
+  pl.next_at = now;
+  pl.started = now;
+  pl.active = true;
+}
+
+static void run_step(uint8_t p) {
+  Player &pl = players[p];
+  const SfxStep &st = pl.script->steps[pl.step];
+  if (st.freq_hz) {
+    SynthNote n;
+    n.wave = st.wave;
+    n.freq_hz = st.freq_hz;
+    n.end_freq_hz = st.end_hz;
+    n.gate_ms = st.gate_ms;
+    n.volume = (uint16_t)st.volume << 7;
+    n.env = *ENVELOPES[st.env];
+    n.bus = pl.script->bus;
+    synth_note_on(n, tag_of(p));
+  }
+  pl.next_at += rate * st.next_ms / 1000;
+  if (++pl.step >= pl.script->count) pl.active = false;
+}
+
+void sfx_init(const SfxScript *table, uint8_t count, uint32_t sample_rate) {
+  scripts = table;
+  script_count = count;
+  rate = sample_rate;
+  for (uint8_t p = 0; p < SFX_PLAYERS; p++) players[p].active = false;
+  req_tail = req_head;
+}
+
+bool sfx_trigger(uint8_t id) {
+  uint8_t head = req_head;
+  if ((uint8_t)(head - req_tail) >= SFX_QUEUE_LEN) return false;
+  requests[head % SFX_QUEUE_LEN] = id;
+  SFX_BARRIER();
+  req_head = head + 1;
+  return true;
+}
+
+void sfx_cancel_all() {
+  cancel_requested = true;
+}
+
+uint32_t sfx_service(uint32_t now) {
+  if (cancel_requested) {
+    cancel_requested = false;
+    req_tail = req_head;
+    for (uint8_t p = 0; p < SFX_PLAYERS; p++) {
+      if (players[p].active) cut(p);
+    }
+  }
+  while (req_tail != req_head) {
+    uint8_t id = requests[req_tail % SFX_QUEUE_LEN];
+    SFX_BARRIER();
+    req_tail = req_tail + 1;
+    start(id, now);
+  }
+
+  uint32_t next = UINT32_MAX;
+  for (uint8_t p = 0; p < SFX_PLAYERS; p++) {
+    Player &pl = players[p];
+    while (pl.active && (int32_t)(pl.next_at - now) <= 0) run_step(p);
+    if (pl.active && pl.next_at - now < next) next = pl.next_at - now;
+  }
+  return next;
+}
+
+bool sfx_busy() {
+  if (req_tail != req_head) return true;
+  for (uint8_t p = 0; p < SFX_PLAYERS; p++) {
+    if (players[p].active || synth_tag_active(tag_of(p))) return true;
+  }
+  return false;
+}
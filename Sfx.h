@@ -0,0 +1,74 @@
+/*
+ * Sfx.h - Sound effect sequencer
+ *
+ * A sound effect is a script: a short table of steps, each starting one
+ * synth note (or resting) and saying how long until the next step. Up to
+ * SFX_PLAYERS scripts run at once. The sequencer is advanced from the
+ * audio refill interrupt, sample-accurately, so triggering an effect only
+ * appends its id to a lock-free request queue and never blocks.
+ *
+ * Scripts carry a priority and a group. A new effect replaces a running
+ * effect of the same group (e.g. an explosion cuts a shot) unless that one
+ * has a higher priority, in which case the new one is dropped. With every
+ * player busy, the lowest-priority, oldest effect is cut if it does not
+ * outrank the newcomer. Cut effects release their notes rather than
+ * stopping them dead, so preemption does not click.
+ *
+ * No Arduino dependencies; runs wherever Synth.cpp does.
+ */
+
+#ifndef SFX_H
+#define SFX_H
+
+#include <stdint.h>
+#include "Synth.h"
+
+#define SFX_PLAYERS      4
+#define SFX_QUEUE_LEN    8           // pending triggers, power of two
+#define SFX_GROUP_NONE   0           // never replaces anything by group
+
+enum SfxEnv : uint8_t {
+  SFX_ENV_PLUCK,
+  SFX_ENV_ORGAN,
+  SFX_ENV_SOFT,
+  SFX_ENV_BOOM,                      // instant hit, long decay
+  SFX_ENV_BLIP,                      // very short click-free blip
+};
+
+struct SfxStep {
+  uint16_t freq_hz;                  // 0 = rest
+  uint16_t end_hz;                   // slide target, 0 = none
+  uint16_t gate_ms;
+  uint16_t next_ms;                  // until the following step starts
+  SynthWave wave;
+  SfxEnv   env;
+  uint8_t  volume;                   // 0-255, full scale at 255
+};
+
+struct SfxScript {
+  const SfxStep *steps;
+  uint8_t count;
+  uint8_t priority;                  // higher wins
+  uint8_t group;
+  uint8_t bus;                       // synth bus (mixer channel) of its notes
+};
+
+#define SFX_SCRIPT(steps, priority, group, bus) { steps, sizeof(steps) / sizeof(steps[0]), priority, group, bus }
+
+void sfx_init(const SfxScript *scripts, uint8_t count, uint32_t sample_rate);
+
+// Queue an effect by index; false if the request queue is full. Safe from
+// loop() while the refill interrupt runs.
+bool sfx_trigger(uint8_t id);
+
+// Ask the sequencer to cut everything at its next service
+void sfx_cancel_all();
+
+// Refill side: start every step due at sample clock now; returns samples
+// until the next step is due (UINT32_MAX when nothing is scheduled)
+uint32_t sfx_service(uint32_t now);
+
+// True while any effect is scheduled or its notes are still sounding
+bool sfx_busy();
+
+#endif // SFX_H
@@ -0,0 +1,99 @@
+/*
+ * SnakeEngine.cpp - Constant-time Snake core implementation
+ */
+
+#include "SnakeEngine.h"
+#include <string.h>
+
+// The ring holds length - 1 moves, never more than SNAKE_CELLS - 1
+#define RING  SNAKE_CELLS
+
+static const int8_t DX[4] = { 1, 0, -1, 0 };
+static const int8_t DY[4] = { 0, 1, 0, -1 };
+
+static uint8_t ring_get(const SnakeBoard *b, uint16_t i) {
+  i %= RING;
+  return (b->moves[i >> 2] >> ((i & 3) * 2)) & 3;
+}
+
+static void ring_put(SnakeBoard *b, uint16_t i, uint8_t dir) {
+  i %= RING;
+  uint8_t shift = (i & 3) * 2;
+  b->moves[i >> 2] = (b->moves[i >> 2] & ~(3 << shift)) | (dir << shift);
+}
+
+static void set_cell(SnakeBoard *b, uint16_t cell) {
+  b->occupied[cell >> 5] |= 1u << (cell & 31);
+}
+
+static void clear_cell(SnakeBoard *b, uint16_t cell) {
+  b->occupied[cell >> 5] &= ~(1u << (cell & 31));
+}
+
+// Neighbour of cell in dir, no bounds check
+static uint16_t step_cell(uint16_t cell, uint8_t dir) {
+  return cell + DY[dir] * SNAKE_W + DX[dir];
+}
+
+void snake_reset(SnakeBoard *b, uint8_t x, uint8_t y, uint8_t length, uint8_t dir) {
+  memset(b, 0, sizeof(*b));
+  if (length < 1) length = 1;
+  b->dir = dir & 3;
+  b->length = length;
+  b->food = SNAKE_NO_FOOD;
+  b->tail = (y - DY[b->dir] * (length - 1)) * SNAKE_W + (x - DX[b->dir] * (length - 1));
+  uint16_t cell = b->tail;
+  set_cell(b, cell);
+  for (uint16_t i = 0; i < length - 1; i++) {
+    ring_put(b, i, b->dir);
+    cell = step_cell(cell, b->dir);
+    set_cell(b, cell);
+  }
+  b->head = cell;
+}
+
+SnakeResult snake_step(SnakeBoard *b) {
+  int x = b->head % SNAKE_W + DX[b->dir];
+  int y = b->head / SNAKE_W + DY[b->dir];
+  if (x < 0 || x >= SNAKE_W || y < 0 || y >= SNAKE_H) return SNAKE_DIED;
+  uint16_t next = y * SNAKE_W + x;
+  bool ate = next == b->food;
+
+  // Unless the snake grows its tail leaves this move, so the head may take it
+  if (snake_occupied(b, next) && (ate || next != b->tail)) return SNAKE_DIED;
+
+  if (ate) {
+    b->length++;
+  } else {
+    clear_cell(b, b->tail);
+    if (b->length > 1) {
+      b->tail = step_cell(b->tail, ring_get(b, b->first_move));
+      b->first_move = (b->first_move + 1) % RING;
+    } else {
+      b->tail = next;
+    }
+  }
+  if (b->length > 1) ring_put(b, b->first_move + b->length - 2, b->dir);
+  set_cell(b, next);
+  b->head = next;
+  if (!ate) return SNAKE_MOVED;
+  b->food = SNAKE_NO_FOOD;
+  return SNAKE_ATE;
+}
+
+void snake_place_food(SnakeBoard *b, uint16_t k) {
+  b->food = SNAKE_NO_FOOD;
+  if (k >= snake_free_cells(b)) return;
+  for (uint16_t w = 0; w < SNAKE_WORDS; w++) {
+    uint32_t valid = (w == SNAKE_WORDS - 1 && SNAKE_CELLS % 32) ? (1u << (SNAKE_CELLS % 32)) - 1 : 0xFFFFFFFFu;
+    uint32_t free_bits = ~b->occupied[w] & valid;
+    uint16_t n = __builtin_popcount(free_bits);
+    if (k >= n) {
+      k -= n;
+      continue;
+    }
+    while (k--) free_bits &= free_bits - 1;      // drop the k lowest
+    b->food = w * 32 + __builtin_ctz(free_bits);
+    return;
+  }
+}
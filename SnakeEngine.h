@@ -0,0 +1,64 @@
+/*
+ * SnakeEngine.h - Constant-time Snake core
+ *
+ * The body is a ring of 2-bit moves from the tail to the head plus a
+ * one-bit-per-cell occupancy bitmap, so a move (new head in, tail out)
+ * and the collision test are O(1) at any length, up to a full board.
+ * Food goes on a uniformly chosen free cell: the k-th clear bit of the
+ * bitmap, found with a popcount per 32-bit word, so placement costs the
+ * same bounded time however full the board is and never retries.
+ *
+ * 20 x 30 cells in 240 bytes. No Arduino dependencies: GameSnake.cpp
+ * plays it, and tools/snake_bench drives it headless.
+ */
+
+#ifndef SNAKE_ENGINE_H
+#define SNAKE_ENGINE_H
+
+#include <stdint.h>
+
+#define SNAKE_W        20
+#define SNAKE_H        30
+#define SNAKE_CELLS    (SNAKE_W * SNAKE_H)
+#define SNAKE_WORDS    ((SNAKE_CELLS + 31) / 32)
+#define SNAKE_NO_FOOD  0xFFFF         // the snake fills the board
+
+enum SnakeDir : uint8_t { SNAKE_RIGHT, SNAKE_DOWN, SNAKE_LEFT, SNAKE_UP };
+
+enum SnakeResult : uint8_t {
+  SNAKE_MOVED,
+  SNAKE_ATE,                          // grew; place the next food
+  SNAKE_DIED,                         // hit a wall or itself; board unchanged
+};
+
+struct SnakeBoard {
+  uint32_t occupied[SNAKE_WORDS];     // bit y * SNAKE_W + x per body cell
+  uint8_t  moves[SNAKE_CELLS / 4];    // ring of 2-bit SnakeDirs, tail to head
+  uint16_t first_move;                // ring index of the move out of the tail
+  uint16_t head, tail;                // cells, y * SNAKE_W + x
+  uint16_t length;
+  uint16_t food;
+  uint8_t  dir;                       // SnakeDir of the next move
+};
+
+// Snake of length cells ending at head (x, y), lying straight behind it
+// against dir; no food yet
+void snake_reset(SnakeBoard *b, uint8_t x, uint8_t y, uint8_t length, uint8_t dir);
+
+// Move the head one cell in b->dir
+SnakeResult snake_step(SnakeBoard *b);
+
+// Cells not under the snake
+static inline uint16_t snake_free_cells(const SnakeBoard *b) {
+  return SNAKE_CELLS - b->length;
+}
+
+// Put the food on free cell number k (0 <= k < snake_free_cells(), in cell
+// order); a uniform k gives a uniform cell. SNAKE_NO_FOOD if none is free.
+void snake_place_food(SnakeBoard *b, uint16_t k);
+
+static inline bool snake_occupied(const SnakeBoard *b, uint16_t cell) {
+  return (b->occupied[cell >> 5] >> (cell & 31)) & 1;
+}
+
+#endif // SNAKE_ENGINE_H
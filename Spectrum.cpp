@@ -0,0 +1,140 @@
+/*
+ * Spectrum.cpp - Live microphone spectrum implementation
+ */
+
+#include "Spectrum.h"
+#include "Fft.h"
+#include "AudioIn.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+
+#define MIN_HZ       80
+#define FLOOR_DB     12                        // bars start this far above one LSB
+#define RANGE_DB     54                        // ...and are full height this much above that
+#define FALL_PER_UPDATE 10
+
+static int16_t  history[FFT_MAX_POINTS];       // newest samples, circular
+static volatile uint32_t written = 0;          // samples captured since start
+static int16_t  work[FFT_MAX_POINTS] __attribute__((aligned(4)));
+static uint8_t  db[FFT_MAX_POINTS / 2];
+static uint8_t  shown[SPECTRUM_MAX_BARS];
+static uint16_t edges[SPECTRUM_MAX_BARS + 1];  // first bin of each bar
+static uint8_t  edge_count = 0;
+static int8_t   handle = -1;
+static uint32_t last_cycles = 0;
+
+static void on_block(const int16_t *samples, uint32_t frames, void *ctx) {
+  uint32_t w = written;
+  for (uint32_t i = 0; i < frames; i++) history[(w + i) % FFT_MAX_POINTS] = samples[i];
+  written = w + frames;
+}
+
+// Log-spaced bar edges from MIN_HZ to Nyquist, at least one bin per bar
+static void build_edges(uint8_t count) {
+  uint16_t bins = fft_points() / 2;
+  uint32_t rate = audio_in_sample_rate();
+  float lo = (float)MIN_HZ * fft_points() / rate;
+  if (lo < 1) lo = 1;
+  float ratio = powf(bins / lo, 1.0f / count);
+  float edge = lo;
+  uint16_t prev = (uint16_t)lo;
+  for (uint8_t b = 0; b <= count; b++) {
+    uint16_t e = (uint16_t)(edge + 0.5f);
+    if (b && e <= prev) e = prev + 1;
+    if (e > bins) e = bins;
+    edges[b] = e;
+    prev = e;
+    edge *= ratio;
+  }
+  edges[count] = bins;
+  edge_count = count;
+}
+
+bool spectrum_start(uint16_t points) {
+  if (!fft_init(points)) return false;
+  edge_count = 0;
+  memset(shown, 0, sizeof(shown));
+  if (handle >= 0) return true;
+  written = 0;
+  handle = audio_in_subscribe(on_block, nullptr);
+  return handle >= 0;
+}
+
+void spectrum_stop() {
+  if (handle < 0) return;
+  audio_in_unsubscribe(handle);
+  handle = -1;
+}
+
+bool spectrum_active() {
+  return handle >= 0;
+}
+
+uint16_t spectrum_points() {
+  return fft_points();
+}
+
+bool spectrum_update(uint8_t *bars, uint8_t count) {
+  uint16_t n = fft_points();
+  uint32_t w = written;
+  if (count > SPECTRUM_MAX_BARS) count = SPECTRUM_MAX_BARS;
+  if (handle < 0 || w < n) return false;
+
+  uint32_t t0 = rp2040.getCycleCount();
+  for (uint16_t i = 0; i < n; i++) work[i] = history[(w - n + i) % FFT_MAX_POINTS];
+  fft_window(work);
+  fft_real(work);
+  fft_magnitude_db(work, db);
+
+  if (edge_count != count) build_edges(count);
+  for (uint8_t b = 0; b < count; b++) {
+    uint8_t peak = 0;
+    for (uint16_t k = edges[b]; k < edges[b + 1]; k++) {
+      if (db[k] > peak) peak = db[k];
+    }
+    int32_t h = peak <= FLOOR_DB ? 0 : (peak - FLOOR_DB) * 255 / RANGE_DB;
+    if (h > 255) h = 255;
+    int32_t fallen = shown[b] - FALL_PER_UPDATE;
+    shown[b] = h > fallen ? h : (fallen > 0 ? fallen : 0);
+    bars[b] = shown[b];
+  }
+  last_cycles = rp2040.getCycleCount() - t0;
+  return true;
+}
+
+uint32_t spectrum_last_cycles() {
+  return last_cycles;
+}
+
+void spectrum_benchmark(Print &out) {
+  const uint32_t RUNS = 64;
+  uint16_t saved = fft_points();
+  uint32_t hz = clock_get_hz(clk_sys);
+
+  for (uint16_t n = 256; n <= FFT_MAX_POINTS; n *= 2) {
+    fft_init(n);
+    uint32_t best = UINT32_MAX, total = 0;
+    for (uint32_t r = 0; r < RUNS; r++) {
+      for (uint16_t i = 0; i < n; i++) work[i] = (int16_t)((i * 2654435761u) >> 17) - 16384;
+      uint32_t irq = save_and_disable_interrupts();
+      uint32_t t0 = rp2040.getCycleCount();
+      fft_window(work);
+      fft_real(work);
+      fft_magnitude_db(work, db);
+      uint32_t c = rp2040.getCycleCount() - t0;
+      restore_interrupts(irq);
+      total += c;
+      if (c < best) best = c;
+    }
+    uint32_t avg = total / RUNS;
+    // Share of one core at 30 frames per second, in tenths of a percent
+    uint32_t permille = (uint32_t)((uint64_t)avg * 30 * 1000 / hz);
+    char line[96];
+    snprintf(line, sizeof(line), "FFT %u: %lu cycles avg, %lu best, %lu us, %lu.%lu%% of a core at 30 FPS (%lu MHz)",
+             n, (unsigned long)avg, (unsigned long)best, (unsigned long)((uint64_t)avg * 1000000 / hz),
+             (unsigned long)permille / 10, (unsigned long)permille % 10, (unsigned long)(hz / 1000000));
+    out.println(line);
+  }
+  fft_init(saved);
+  edge_count = 0;
+}
@@ -0,0 +1,34 @@
+/*
+ * Spectrum.h - Live microphone spectrum for the visualiser screen
+ *
+ * Subscribes to AudioIn and keeps the newest FFT_MAX_POINTS samples in a
+ * small history ring. Each spectrum_update() windows and transforms the
+ * latest fft_points() of them and folds the bins into log-spaced bars
+ * (roughly 80 Hz up to Nyquist) that rise instantly and fall back
+ * smoothly. The work happens only when a frame is drawn, so the cost
+ * follows the frame rate rather than the sample rate.
+ */
+
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+#include <Arduino.h>
+
+#define SPECTRUM_MAX_BARS  48
+
+// Start capture with a 256- or 512-point transform
+bool spectrum_start(uint16_t points);
+void spectrum_stop();
+bool spectrum_active();
+uint16_t spectrum_points();
+
+// Heights 0-255 for count bars; false until a full window has been captured
+bool spectrum_update(uint8_t *bars, uint8_t count);
+
+// Cycles spent in the last spectrum_update() (window, FFT, dB and bars)
+uint32_t spectrum_last_cycles();
+
+// Time both transform lengths on the device and print the load at 30 FPS
+void spectrum_benchmark(Print &out);
+
+#endif // SPECTRUM_H
@@ -0,0 +1,305 @@
+/*
+ * Synth.cpp - Fixed-point wavetable synthesiser implementation
+ */
+
+#include "Synth.h"
+#include "ConstMath.h"
+#include <string.h>
+
+#define TABLE_SIZE   (1 << SYNTH_TABLE_BITS)
+#define ENV_ONE      (1 << 30)                 // envelope level, Q30
+#define CHUNK        64                        // mix accumulator, frames
+#define ALL_BUSES    0xFF
+
+enum EnvStage : uint8_t { ENV_IDLE, ENV_ATTACK, ENV_DECAY, ENV_SUSTAIN, ENV_RELEASE };
+
+struct Voice {
+  uint32_t phase;
+  uint32_t inc;
+  int32_t  slide;          // added to inc every sample while slide_left > 0
+  uint32_t slide_left;
+  uint32_t gate_left;      // samples until note off, 0 = held
+  int32_t  level;          // Q30
+  int32_t  env_delta;      // per sample within the current stage
+  uint32_t env_left;       // samples left in the current stage
+  int32_t  sustain;        // Q30
+  uint32_t decay_samples;
+  uint32_t release_samples;
+  int32_t  volume;         // Q15
+  uint32_t lfsr;
+  int16_t  noise;
+  SynthWave wave;
+  EnvStage stage;
+  uint8_t  tag;
+  uint8_t  bus;
+};
+
+// ---------- Wavetables (generated at compile time) ----------
+
+struct Wavetables {
+  int16_t t[4][TABLE_SIZE];
+};
+
+static constexpr Wavetables make_tables() {
+  Wavetables w{};
+  for (int i = 0; i < TABLE_SIZE; i++) {
+    double x = 2 * PI_D * i / TABLE_SIZE;
+    if (x > PI_D) x -= 2 * PI_D;
+    double s = cx_sin(x) * 32767;
+    w.t[WAVE_SINE][i] = (int16_t)(s < 0 ? s - 0.5 : s + 0.5);
+    w.t[WAVE_SQUARE][i] = i < TABLE_SIZE / 2 ? 24000 : -24000;        // ~-3 dB to match the sine's loudness
+    int q = TABLE_SIZE / 4;
+    int tri = i < q ? i : (i < 3 * q ? 2 * q - i : i - 4 * q);        // -q..q
+    w.t[WAVE_TRIANGLE][i] = (int16_t)(tri * 32767 / q);
+    w.t[WAVE_SAW][i] = (int16_t)((i - TABLE_SIZE / 2) * 65535 / TABLE_SIZE);
+  }
+  return w;
+}
+
+static constexpr Wavetables TABLES = make_tables();
+static_assert(TABLES.t[WAVE_SINE][TABLE_SIZE / 4] == 32767, "sine peak");
+static_assert(TABLES.t[WAVE_SINE][3 * TABLE_SIZE / 4] == -32767, "sine trough");
+
+// SRAM copy for the mixer IRQ (see ConstMath.h)
+static Wavetables tables = TABLES;
+
+const SynthEnvelope SYNTH_ENV_PLUCK = {   2, 180,     0,  20 };
+const SynthEnvelope SYNTH_ENV_ORGAN = {   5,   0, 32767,  30 };
+const SynthEnvelope SYNTH_ENV_SOFT  = {  60, 100, 24000, 250 };
+
+static Voice    voices[SYNTH_VOICES];
+static uint32_t rate = 24000;
+
+static inline uint32_t ms_to_samples(uint16_t ms) {
+  uint32_t n = rate * ms / 1000;
+  return n ? n : 1;
+}
+
+static inline uint32_t hz_to_inc(uint16_t hz) {
+  return (uint32_t)(((uint64_t)hz << 32) / rate);
+}
+
+// ---------- Envelope ----------
+
+static void enter_stage(Voice &v, EnvStage stage) {
+  v.stage = stage;
+  switch (stage) {
+    case ENV_DECAY:
+      v.level = ENV_ONE;
+      v.env_left = v.decay_samples;
+      v.env_delta = (v.sustain - ENV_ONE) / (int32_t)v.env_left;
+      break;
+    case ENV_SUSTAIN:
+      v.level = v.sustain;
+      v.env_delta = 0;
+      v.env_left = UINT32_MAX;
+      if (v.sustain == 0) v.stage = ENV_IDLE;          // plucked: nothing left to hold
+      break;
+    case ENV_RELEASE:
+      v.gate_left = 0;
+      v.env_left = v.release_samples;
+      v.env_delta = -v.level / (int32_t)v.env_left;
+      break;
+    default:
+      v.level = 0;
+      v.stage = ENV_IDLE;
+      break;
+  }
+}
+
+static void end_stage(Voice &v) {
+  switch (v.stage) {
+    case ENV_ATTACK:  enter_stage(v, ENV_DECAY); break;
+    case ENV_DECAY:   enter_stage(v, ENV_SUSTAIN); break;
+    default:          enter_stage(v, ENV_IDLE); break;
+  }
+}
+
+// ---------- Rendering ----------
+
+// n samples with no stage, gate or slide boundary inside
+static void render_run(Voice &v, int32_t *acc, uint32_t n) {
+  uint32_t phase = v.phase, inc = v.inc;
+  int32_t level = v.level, delta = v.env_delta, slide = v.slide, vol = v.volume;
+
+  if (v.wave == WAVE_NOISE) {
+    uint32_t lfsr = v.lfsr;
+    int32_t noise = v.noise;
+    for (uint32_t i = 0; i < n; i++) {
+      uint32_t next = phase + inc;
+      if ((next ^ phase) >> (32 - SYNTH_TABLE_BITS)) {     // clock the LFSR at table rate
+        lfsr ^= lfsr << 13;
+        lfsr ^= lfsr >> 17;
+        lfsr ^= lfsr << 5;
+        noise = (int16_t)lfsr;
+      }
+      phase = next;
+      inc += slide;
+      level += delta;
+      int32_t gain = ((level >> 15) * vol) >> 15;
+      acc[i] += (noise * gain) >> 15;
+    }
+    v.lfsr = lfsr;
+    v.noise = (int16_t)noise;
+  } else {
+    const int16_t *table = tables.t[v.wave];
+    for (uint32_t i = 0; i < n; i++) {
+      int32_t s = table[phase >> (32 - SYNTH_TABLE_BITS)];
+      phase += inc;
+      inc += slide;
+      level += delta;
+      int32_t gain = ((level >> 15) * vol) >> 15;
+      acc[i] += (s * gain) >> 15;
+    }
+  }
+
+  v.phase = phase;
+  v.inc = inc;
+  v.level = level;
+}
+
+static void render_voice(Voice &v, int32_t *acc, uint32_t frames) {
+  uint32_t done = 0;
+  while (done < frames && v.stage != ENV_IDLE) {
+    uint32_t n = frames - done;
+    if (v.env_left < n) n = v.env_left;
+    if (v.gate_left && v.gate_left < n) n = v.gate_left;
+    if (v.slide_left && v.slide_left < n) n = v.slide_left;
+
+    render_run(v, acc + done, n);
+    done += n;
+
+    if (v.slide_left && (v.slide_left -= n) == 0) v.slide = 0;
+    if (v.env_left != UINT32_MAX) v.env_left -= n;
+    if (v.gate_left && (v.gate_left -= n) == 0 && v.stage != ENV_RELEASE) {
+      enter_stage(v, ENV_RELEASE);
+    } else if (v.env_left == 0) {
+      end_stage(v);
+    }
+  }
+}
+
+// ---------- API ----------
+
+void synth_init(uint32_t sample_rate) {
+  rate = sample_rate;
+  memset(voices, 0, sizeof(voices));
+  for (uint8_t i = 0; i < SYNTH_VOICES; i++) voices[i].lfsr = 0x12345678u + i * 0x9E3779B9u;
+}
+
+int8_t synth_note_on(const SynthNote &note, uint8_t tag) {
+  int8_t pick = 0;
+  for (int8_t i = 0; i < SYNTH_VOICES; i++) {
+    if (voices[i].stage == ENV_IDLE) {
+      pick = i;
+      break;
+    }
+    bool releasing = voices[i].stage == ENV_RELEASE, pick_releasing = voices[pick].stage == ENV_RELEASE;
+    if (releasing != pick_releasing ? releasing : voices[i].level < voices[pick].level) pick = i;
+  }
+
+  Voice &v = voices[pick];
+  v.tag = tag;
+  v.bus = note.bus;
+  v.wave = note.wave;
+  v.phase = 0;
+  v.inc = hz_to_inc(note.freq_hz);
+  v.gate_left = note.gate_ms ? ms_to_samples(note.gate_ms) : 0;
+  v.slide = 0;
+  v.slide_left = 0;
+  if (note.end_freq_hz && v.gate_left) {
+    v.slide = ((int32_t)hz_to_inc(note.end_freq_hz) - (int32_t)v.inc) / (int32_t)v.gate_left;
+    v.slide_left = v.gate_left;
+  }
+  v.volume = note.volume;
+  v.sustain = (int32_t)note.env.sustain << 15;
+  v.decay_samples = ms_to_samples(note.env.decay_ms);
+  v.release_samples = ms_to_samples(note.env.release_ms);
+
+  // Attack ramps from wherever a stolen voice was, so steals do not click
+  if (v.stage == ENV_IDLE) v.level = 0;
+  v.stage = ENV_ATTACK;
+  v.env_left = ms_to_samples(note.env.attack_ms);
+  v.env_delta = (ENV_ONE - v.level) / (int32_t)v.env_left;
+  return pick;
+}
+
+void synth_note_off(int8_t voice) {
+  if (voice < 0 || voice >= SYNTH_VOICES) return;
+  Voice &v = voices[voice];
+  if (v.stage != ENV_IDLE && v.stage != ENV_RELEASE) enter_stage(v, ENV_RELEASE);
+}
+
+bool synth_voice_set(int8_t voice, uint8_t tag, uint32_t freq_q8, uint16_t volume) {
+  if (voice < 0 || voice >= SYNTH_VOICES) return false;
+  Voice &v = voices[voice];
+  if (v.tag != tag || v.stage == ENV_IDLE) return false;
+  v.inc = (uint32_t)(((uint64_t)freq_q8 << 24) / rate);
+  v.slide = 0;
+  v.slide_left = 0;
+  v.volume = volume;
+  return true;
+}
+
+bool synth_release_tag(uint8_t tag) {
+  bool any = false;
+  for (int8_t i = 0; i < SYNTH_VOICES; i++) {
+    if (voices[i].tag != tag || voices[i].stage == ENV_IDLE) continue;
+    synth_note_off(i);
+    any = true;
+  }
+  return any;
+}
+
+bool synth_tag_active(uint8_t tag) {
+  for (uint8_t i = 0; i < SYNTH_VOICES; i++) {
+    if (voices[i].tag == tag && voices[i].stage != ENV_IDLE) return true;
+  }
+  return false;
+}
+
+void synth_release_all() {
+  for (int8_t i = 0; i < SYNTH_VOICES; i++) synth_note_off(i);
+}
+
+void synth_stop_all() {
+  for (uint8_t i = 0; i < SYNTH_VOICES; i++) enter_stage(voices[i], ENV_IDLE);
+}
+
+uint8_t synth_active_voices() {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < SYNTH_VOICES; i++) n += voices[i].stage != ENV_IDLE;
+  return n;
+}
+
+static inline bool on_bus(const Voice &v, uint8_t bus) {
+  return v.stage != ENV_IDLE && (bus == ALL_BUSES || v.bus == bus);
+}
+
+static bool render(int16_t *out, uint32_t frames, uint8_t bus) {
+  uint8_t first = 0;
+  while (first < SYNTH_VOICES && !on_bus(voices[first], bus)) first++;
+  if (first == SYNTH_VOICES) return false;
+
+  int32_t acc[CHUNK];
+  for (uint32_t done = 0; done < frames; done += CHUNK) {
+    uint32_t n = frames - done < CHUNK ? frames - done : CHUNK;
+    memset(acc, 0, n * sizeof(int32_t));
+    for (uint8_t i = 0; i < SYNTH_VOICES; i++) {
+      if (on_bus(voices[i], bus)) render_voice(voices[i], acc, n);
+    }
+    for (uint32_t i = 0; i < n; i++) {
+      int32_t s = acc[i];
+      out[done + i] = s > 32767 ? 32767 : (s < -32768 ? -32768 : s);
+    }
+  }
+  return true;
+}
+
+bool synth_render(int16_t *out, uint32_t frames) {
+  return render(out, frames, ALL_BUSES);
+}
+
+bool synth_render_bus(int16_t *out, uint32_t frames, uint8_t bus) {
+  return render(out, frames, bus);
+}
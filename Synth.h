@@ -0,0 +1,83 @@
+/*
+ * Synth.h - Fixed-point wavetable synthesiser
+ *
+ * SYNTH_VOICES voices, each a 32-bit phase accumulator over a 256-entry
+ * wavetable (sine, square, triangle, saw; built at compile time) or an
+ * LFSR clocked by the accumulator for noise, with an optional linear
+ * pitch slide, an ADSR envelope and a Q15 volume. Voices are summed in
+ * 32 bits and saturated to int16 once per sample. Everything is integer
+ * so a block renders from the DMA IRQ, and the code has no Arduino
+ * dependencies so tools/synth_bench measures exactly what the watch runs.
+ *
+ * Not reentrant: callers serialise note_on/note_off against render.
+ */
+
+#ifndef SYNTH_H
+#define SYNTH_H
+
+#include <stdint.h>
+
+#define SYNTH_VOICES      8
+#define SYNTH_TABLE_BITS  8
+
+enum SynthWave : uint8_t {
+  WAVE_SINE,
+  WAVE_SQUARE,
+  WAVE_TRIANGLE,
+  WAVE_SAW,
+  WAVE_NOISE,
+};
+
+struct SynthEnvelope {
+  uint16_t attack_ms;
+  uint16_t decay_ms;
+  uint16_t sustain;       // Q15 level held while the gate is open
+  uint16_t release_ms;
+};
+
+struct SynthNote {
+  SynthWave wave;
+  uint16_t freq_hz;
+  uint16_t end_freq_hz;   // slide target over the gate, 0 = no slide
+  uint16_t gate_ms;       // note off after this long, 0 = wait for synth_note_off()
+  uint16_t volume;        // Q15
+  SynthEnvelope env;
+  uint8_t  bus;           // mixer channel, see synth_render_bus()
+};
+
+// Common envelopes
+extern const SynthEnvelope SYNTH_ENV_PLUCK;   // fast attack, decays to silence
+extern const SynthEnvelope SYNTH_ENV_ORGAN;   // flat while held, short release
+extern const SynthEnvelope SYNTH_ENV_SOFT;    // slow attack and release
+
+void synth_init(uint32_t sample_rate);
+
+// Start a note on a free voice (or steal the quietest); returns the voice.
+// tag groups voices so an owner (e.g. an SFX player) can release its own.
+int8_t synth_note_on(const SynthNote &note, uint8_t tag = 0);
+
+// Move a voice to its release stage
+void synth_note_off(int8_t voice);
+
+// Retune (Q8 Hz, cancelling any slide) and re-level a sounding voice, for
+// players that drive pitch and volume themselves; false once the voice has
+// finished or been taken by a note with another tag
+bool synth_voice_set(int8_t voice, uint8_t tag, uint32_t freq_q8, uint16_t volume);
+
+// Release every voice started with tag; true if any were sounding
+bool synth_release_tag(uint8_t tag);
+bool synth_tag_active(uint8_t tag);
+
+// Release every voice / silence every voice immediately
+void synth_release_all();
+void synth_stop_all();
+
+uint8_t synth_active_voices();
+
+// Render frames of mono audio; returns false (out untouched) when idle
+bool synth_render(int16_t *out, uint32_t frames);
+
+// As synth_render(), but only the voices started with note.bus == bus
+bool synth_render_bus(int16_t *out, uint32_t frames, uint8_t bus);
+
+#endif // SYNTH_H
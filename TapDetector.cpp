@@ -0,0 +1,48 @@
+/*
+ * TapDetector.cpp - Tap-to-wake filter and detector implementation
+ */
+
+#include "TapDetector.h"
+#include <math.h>
+#include <string.h>
+
+void tap_detector_init(TapDetector *td, const TapConfig *cfg) {
+  memset(td, 0, sizeof(*td));
+  td->cfg = *cfg;
+}
+
+bool tap_detector_feed(TapDetector *td, const int16_t raw[3], uint16_t acc_lsb_div, uint32_t now_ms) {
+  // Same scaling as QMI8658_read_acc_xyz
+  float gx = (raw[0] * ONE_G) / acc_lsb_div;
+  float gy = (raw[1] * ONE_G) / acc_lsb_div;
+  float gz = (raw[2] * ONE_G) / acc_lsb_div;
+
+  const float lpf = td->cfg.lpf_alpha;
+  const float hpf = td->cfg.hpf_alpha;
+
+  // Slow gravity adaptation to filter out orientation changes
+  td->ax_f = (1.0f - lpf) * td->ax_f + lpf * gx;
+  td->ay_f = (1.0f - lpf) * td->ay_f + lpf * gy;
+  td->az_f = (1.0f - lpf) * td->az_f + lpf * gz;
+
+  // Remove gravity to get dynamic acceleration
+  float dx = gx - td->ax_f;
+  float dy = gy - td->ay_f;
+  float dz = gz - td->az_f;
+
+  // High-pass filter to isolate impulses
+  td->hx = hpf * td->hx + (1.0f - hpf) * dx;
+  td->hy = hpf * td->hy + (1.0f - hpf) * dy;
+  td->hz = hpf * td->hz + (1.0f - hpf) * dz;
+
+  // Calculate total acceleration magnitude
+  float mag = sqrt(td->hx*td->hx + td->hy*td->hy + td->hz*td->hz);
+  td->last_mag = mag;
+
+  // Simple threshold check - should detect deliberate taps
+  if (mag >= td->cfg.thresh && now_ms - td->last_tap_ms >= td->cfg.debounce_ms) {
+    td->last_tap_ms = now_ms;
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,43 @@
+/*
+ * TapDetector.h - Tap-to-wake filter and detector
+ *
+ * Gravity low-pass, impulse high-pass and threshold/debounce stage used by
+ * the watch to detect wrist taps from raw QMI8658 accelerometer samples.
+ * Has no Arduino dependencies so the host replay tool (tools/imu_replay)
+ * runs exactly the same code over recorded traces.
+ */
+
+#ifndef TAP_DETECTOR_H
+#define TAP_DETECTOR_H
+
+#include <stdint.h>
+
+#ifndef ONE_G
+#define ONE_G (9.807f)
+#endif
+
+// Tunable parameters (units follow QMI8658_read_acc_xyz: m/s^2)
+struct TapConfig {
+  float    lpf_alpha;     // gravity tracking rate
+  float    hpf_alpha;     // high-pass for impulses
+  float    thresh;        // magnitude needed to count as a tap
+  uint32_t debounce_ms;   // minimum spacing between taps
+};
+
+struct TapDetector {
+  TapConfig cfg;
+  float ax_f, ay_f, az_f;   // low-pass gravity estimate
+  float hx, hy, hz;         // high-passed dynamic acceleration
+  float last_mag;           // magnitude of the most recent sample
+  uint32_t last_tap_ms;
+};
+
+// Reset filter state and load a configuration
+void tap_detector_init(TapDetector *td, const TapConfig *cfg);
+
+// Feed one raw accelerometer sample (as read from the QMI8658 data
+// registers) taken at now_ms. acc_lsb_div is the sensor's LSB/g for the
+// configured range. Returns true when a tap is detected.
+bool tap_detector_feed(TapDetector *td, const int16_t raw[3], uint16_t acc_lsb_div, uint32_t now_ms);
+
+#endif // TAP_DETECTOR_H
@@ -0,0 +1,136 @@
+/*
+ * TetrisEngine.cpp - Bitboard Tetris core implementation
+ */
+
+#include "TetrisEngine.h"
+#include <string.h>
+
+// Collision works on the row shifted up by PAD bits with everything
+// outside the well set, so a box hanging off either side (the kicks move
+// it at most 2 past a legal spot) hits a wall bit instead of shifting out
+#define PAD 4
+static const uint32_t WALLS = ~((uint32_t)TETRIS_FULL_ROW << PAD);
+
+// [piece][rotation][row], bit c = box column c; SRS spawn orientations,
+// JLSTZ rotating in the top-left 3x3 of the box, I and O in the full 4x4
+static const uint8_t SHAPES[TETRIS_PIECES][4][4] = {
+  { {0x0,0xF,0x0,0x0}, {0x4,0x4,0x4,0x4}, {0x0,0x0,0xF,0x0}, {0x2,0x2,0x2,0x2} },   // I
+  { {0x6,0x6,0x0,0x0}, {0x6,0x6,0x0,0x0}, {0x6,0x6,0x0,0x0}, {0x6,0x6,0x0,0x0} },   // O
+  { {0x6,0x3,0x0,0x0}, {0x2,0x6,0x4,0x0}, {0x0,0x6,0x3,0x0}, {0x1,0x3,0x2,0x0} },   // S
+  { {0x3,0x6,0x0,0x0}, {0x4,0x6,0x2,0x0}, {0x0,0x3,0x6,0x0}, {0x2,0x3,0x1,0x0} },   // Z
+  { {0x2,0x7,0x0,0x0}, {0x2,0x6,0x2,0x0}, {0x0,0x7,0x2,0x0}, {0x2,0x3,0x2,0x0} },   // T
+  { {0x4,0x7,0x0,0x0}, {0x2,0x2,0x6,0x0}, {0x0,0x7,0x1,0x0}, {0x3,0x2,0x2,0x0} },   // L
+  { {0x1,0x7,0x0,0x0}, {0x6,0x2,0x2,0x0}, {0x0,0x7,0x4,0x0}, {0x2,0x2,0x3,0x0} },   // J
+};
+
+// SRS wall kicks [from rotation][0 = clockwise, 1 = counter-clockwise][test],
+// as {dx, dy} with y down (the guideline tables have y up)
+static const int8_t KICKS_JLSTZ[4][2][5][2] = {
+  { {{0,0},{-1,0},{-1,-1},{0, 2},{-1, 2}},      // 0->R
+    {{0,0},{ 1,0},{ 1,-1},{0, 2},{ 1, 2}} },    // 0->L
+  { {{0,0},{ 1,0},{ 1, 1},{0,-2},{ 1,-2}},      // R->2
+    {{0,0},{ 1,0},{ 1, 1},{0,-2},{ 1,-2}} },    // R->0
+  { {{0,0},{ 1,0},{ 1,-1},{0, 2},{ 1, 2}},      // 2->L
+    {{0,0},{-1,0},{-1,-1},{0, 2},{-1, 2}} },    // 2->R
+  { {{0,0},{-1,0},{-1, 1},{0,-2},{-1,-2}},      // L->0
+    {{0,0},{-1,0},{-1, 1},{0,-2},{-1,-2}} },    // L->2
+};
+
+static const int8_t KICKS_I[4][2][5][2] = {
+  { {{0,0},{-2,0},{ 1,0},{-2, 1},{ 1,-2}},      // 0->R
+    {{0,0},{-1,0},{ 2,0},{-1,-2},{ 2, 1}} },    // 0->L
+  { {{0,0},{-1,0},{ 2,0},{-1,-2},{ 2, 1}},      // R->2
+    {{0,0},{ 2,0},{-1,0},{ 2,-1},{-1, 2}} },    // R->0
+  { {{0,0},{ 2,0},{-1,0},{ 2,-1},{-1, 2}},      // 2->L
+    {{0,0},{ 1,0},{-2,0},{ 1, 2},{-2,-1}} },    // 2->R
+  { {{0,0},{ 1,0},{-2,0},{ 1, 2},{-2,-1}},      // L->0
+    {{0,0},{-2,0},{ 1,0},{-2, 1},{ 1,-2}} },    // L->2
+};
+
+void tetris_reset(TetrisBoard *b) {
+  memset(b, 0, sizeof(*b));
+}
+
+bool tetris_fits(const TetrisBoard *b, uint8_t piece, uint8_t rot, int x, int y) {
+  if (x < -PAD || x > TETRIS_W) return false;
+  const uint8_t *shape = SHAPES[piece][rot & 3];
+  for (int r = 0; r < 4; r++) {
+    if (!shape[r]) continue;
+    int row = y + r;
+    if (row >= TETRIS_H) return false;
+    uint32_t solid = WALLS;
+    if (row >= 0) solid |= (uint32_t)b->rows[row] << PAD;
+    if (((uint32_t)shape[r] << (x + PAD)) & solid) return false;
+  }
+  return true;
+}
+
+bool tetris_spawn(TetrisBoard *b, uint8_t piece) {
+  b->piece = piece;
+  b->rot = 0;
+  b->x = (TETRIS_W - 4) / 2;
+  b->y = 0;
+  return tetris_fits(b, piece, 0, b->x, b->y);
+}
+
+bool tetris_move(TetrisBoard *b, int dx, int dy) {
+  if (!tetris_fits(b, b->piece, b->rot, b->x + dx, b->y + dy)) return false;
+  b->x += dx;
+  b->y += dy;
+  return true;
+}
+
+bool tetris_rotate(TetrisBoard *b, int dir) {
+  if (b->piece == TETRIS_O) return true;
+  uint8_t to = (b->rot + (dir > 0 ? 1 : 3)) & 3;
+  const int8_t (*kicks)[2] = (b->piece == TETRIS_I ? KICKS_I : KICKS_JLSTZ)[b->rot][dir > 0 ? 0 : 1];
+  for (int i = 0; i < 5; i++) {
+    int x = b->x + kicks[i][0];
+    int y = b->y + kicks[i][1];
+    if (tetris_fits(b, b->piece, to, x, y)) {
+      b->x = x;
+      b->y = y;
+      b->rot = to;
+      return true;
+    }
+  }
+  return false;
+}
+
+int tetris_drop_distance(const TetrisBoard *b) {
+  int d = 0;
+  while (tetris_fits(b, b->piece, b->rot, b->x, b->y + d + 1)) d++;
+  return d;
+}
+
+uint8_t tetris_lock(TetrisBoard *b) {
+  const uint8_t *shape = SHAPES[b->piece][b->rot];
+  uint32_t color = b->piece + 1;
+  for (int r = 0; r < 4; r++) {
+    int row = b->y + r;
+    if (!shape[r] || row < 0 || row >= TETRIS_H) continue;
+    b->rows[row] |= (uint16_t)((((uint32_t)shape[r] << (b->x + PAD)) >> PAD) & TETRIS_FULL_ROW);
+    for (int c = 0; c < 4; c++) {
+      int col = b->x + c;
+      if ((shape[r] >> c) & 1 && col >= 0 && col < TETRIS_W) b->colors[row] |= color << (3 * col);
+    }
+  }
+
+  // Only the piece's rows can have filled up; top to bottom, so a clear
+  // (everything above moves down one) leaves the rows still to check alone
+  uint8_t cleared = 0;
+  for (int r = 0; r < 4; r++) {
+    int row = b->y + r;
+    if (row < 0 || row >= TETRIS_H || b->rows[row] != TETRIS_FULL_ROW) continue;
+    memmove(&b->rows[1], &b->rows[0], row * sizeof(b->rows[0]));
+    memmove(&b->colors[1], &b->colors[0], row * sizeof(b->colors[0]));
+    b->rows[0] = 0;
+    b->colors[0] = 0;
+    cleared++;
+  }
+  return cleared;
+}
+
+uint8_t tetris_piece_row(uint8_t piece, uint8_t rot, uint8_t r) {
+  return SHAPES[piece][rot & 3][r];
+}
@@ -0,0 +1,69 @@
+/*
+ * TetrisEngine.h - Bitboard Tetris core
+ *
+ * The well is one uint16_t per row (bit c = column c, row 0 at the top)
+ * plus a packed colour word per row for drawing. Every piece in every
+ * rotation is a precomputed 4-row mask, so a collision test is four
+ * shift/AND/ORs and a line clear is a row memmove. Rotation is SRS: the
+ * standard spawn orientations and the standard JLSTZ and I wall-kick
+ * tables (O does not kick).
+ *
+ * No Arduino dependencies: GameTetris.cpp plays it, and tools/tetris_bench
+ * drives the same code headless with a placement AI.
+ */
+
+#ifndef TETRIS_ENGINE_H
+#define TETRIS_ENGINE_H
+
+#include <stdint.h>
+
+#define TETRIS_W       10
+#define TETRIS_H       20
+#define TETRIS_PIECES  7
+#define TETRIS_FULL_ROW ((uint16_t)((1u << TETRIS_W) - 1))
+
+// Piece types, in spawn-colour order
+enum TetrisPiece : uint8_t {
+  TETRIS_I, TETRIS_O, TETRIS_S, TETRIS_Z, TETRIS_T, TETRIS_L, TETRIS_J
+};
+
+struct TetrisBoard {
+  uint16_t rows[TETRIS_H];       // occupied cells
+  uint32_t colors[TETRIS_H];     // 3 bits per column: piece + 1, 0 = empty
+  uint8_t  piece, rot;           // falling piece, rotation 0-3 (0 = spawn, 1 = R)
+  int8_t   x, y;                 // its 4x4 box, top-left cell
+};
+
+// Empty well, no piece
+void tetris_reset(TetrisBoard *b);
+
+// Put piece at the top in spawn orientation; false if it does not fit
+// (the well is topped out)
+bool tetris_spawn(TetrisBoard *b, uint8_t piece);
+
+// Whether piece/rot fits with its box at x, y (rows above the well are open)
+bool tetris_fits(const TetrisBoard *b, uint8_t piece, uint8_t rot, int x, int y);
+
+// Shift the falling piece; false (and unchanged) if blocked
+bool tetris_move(TetrisBoard *b, int dx, int dy);
+
+// Rotate the falling piece, dir +1 clockwise, -1 counter-clockwise, trying
+// the SRS kicks in order; false (and unchanged) if none fits
+bool tetris_rotate(TetrisBoard *b, int dir);
+
+// Rows the falling piece can still drop
+int tetris_drop_distance(const TetrisBoard *b);
+
+// Write the falling piece into the well and clear full rows; returns the
+// number of rows cleared. The piece is gone until the next tetris_spawn().
+uint8_t tetris_lock(TetrisBoard *b);
+
+// Cell contents for drawing: 0 empty, else piece + 1
+static inline uint8_t tetris_cell(const TetrisBoard *b, int x, int y) {
+  return (b->colors[y] >> (3 * x)) & 7;
+}
+
+// Row r (0-3) of a piece's 4x4 box, bit c = box column c
+uint8_t tetris_piece_row(uint8_t piece, uint8_t rot, uint8_t r);
+
+#endif // TETRIS_ENGINE_H
@@ -0,0 +1,269 @@
+/*
+ * Timeline.cpp - Time-indexed event store in flash implementation
+ */
+
+#include "Timeline.h"
+#include "FlashStore.h"
+
+#define TL_SECTORS        (FLASH_TIMELINE_SIZE / FLASH_SECTOR_SIZE)
+#define TL_SECTOR_MAGIC   0x4E4C4D54u   // "TMLN"
+#define TL_RECORD_MAGIC   0x3254u       // "T2"; "TL" records had no CRC
+#define TL_FLAG_LIVE      0x01          // cleared in place to delete
+
+struct TimelineSectorHeader {
+  uint32_t magic;
+  uint32_t seq;             // increases by one per opened sector
+};
+
+struct TimelineRecordHeader {
+  uint16_t magic;
+  uint16_t crc;             // of everything after flags, then time
+  uint32_t time;
+  uint8_t  flags;           // outside the CRC: cleared in place to delete
+  uint8_t  title_len;
+  uint8_t  subtitle_len;
+  uint8_t  body_len;
+};
+
+struct __attribute__((packed)) TimelineIndexEntry {
+  uint32_t time;
+  uint16_t off8;            // record offset in the partition / 8
+};
+
+static TimelineIndexEntry index_[TIMELINE_MAX_EVENTS];
+static uint16_t count = 0;
+static bool     ready = false;
+
+static uint8_t  head_sector = 0;
+static uint32_t head_seq = 0;
+static uint32_t write_off = 0;          // next free byte, partition relative
+
+static inline uint32_t align8(uint32_t v) {
+  return (v + 7) & ~7u;
+}
+
+static inline const TimelineSectorHeader *sector_at(uint8_t s) {
+  return (const TimelineSectorHeader *)flash_store_ptr(FLASH_TIMELINE_OFFSET + s * FLASH_SECTOR_SIZE);
+}
+
+static inline const TimelineRecordHeader *record_at(uint32_t off) {
+  return (const TimelineRecordHeader *)flash_store_ptr(FLASH_TIMELINE_OFFSET + off);
+}
+
+static inline bool sector_valid(uint8_t s) {
+  return sector_at(s)->magic == TL_SECTOR_MAGIC;
+}
+
+// Header + strings, before padding
+static inline uint16_t record_len(const TimelineRecordHeader *r) {
+  return sizeof(TimelineRecordHeader) + r->title_len + 1 + r->subtitle_len + 1 + r->body_len + 1;
+}
+
+static uint16_t record_crc(const TimelineRecordHeader *r) {
+  uint16_t crc = flash_store_crc16(0xFFFF, &r->title_len, record_len(r) - offsetof(TimelineRecordHeader, title_len));
+  return flash_store_crc16(crc, &r->time, sizeof(r->time));
+}
+
+// ---------- Index ----------
+
+// First index whose time is > time
+static uint16_t upper_bound(uint32_t time) {
+  uint16_t lo = 0, hi = count;
+  while (lo < hi) {
+    uint16_t mid = (lo + hi) / 2;
+    if (index_[mid].time <= time) lo = mid + 1; else hi = mid;
+  }
+  return lo;
+}
+
+uint16_t timeline_lower_bound(uint32_t time) {
+  uint16_t lo = 0, hi = count;
+  while (lo < hi) {
+    uint16_t mid = (lo + hi) / 2;
+    if (index_[mid].time < time) lo = mid + 1; else hi = mid;
+  }
+  return lo;
+}
+
+static bool index_insert(uint32_t time, uint32_t off) {
+  if (count >= TIMELINE_MAX_EVENTS) return false;
+  uint16_t pos = upper_bound(time);
+  memmove(&index_[pos + 1], &index_[pos], (count - pos) * sizeof(TimelineIndexEntry));
+  index_[pos].time = time;
+  index_[pos].off8 = off / 8;
+  count++;
+  return true;
+}
+
+static void index_drop_sector(uint8_t s) {
+  uint16_t lo = s * (FLASH_SECTOR_SIZE / 8);
+  uint16_t hi = lo + FLASH_SECTOR_SIZE / 8;
+  uint16_t n = 0;
+  for (uint16_t i = 0; i < count; i++) {
+    if (index_[i].off8 >= lo && index_[i].off8 < hi) continue;
+    index_[n++] = index_[i];
+  }
+  count = n;
+}
+
+// ---------- Log ----------
+
+static void open_sector(uint8_t s, uint32_t seq) {
+  flash_store_erase(FLASH_TIMELINE_OFFSET + s * FLASH_SECTOR_SIZE, FLASH_SECTOR_SIZE);
+  TimelineSectorHeader h = { TL_SECTOR_MAGIC, seq };
+  flash_store_program(FLASH_TIMELINE_OFFSET + s * FLASH_SECTOR_SIZE, &h, sizeof(h));
+  head_sector = s;
+  head_seq = seq;
+  write_off = s * FLASH_SECTOR_SIZE + sizeof(TimelineSectorHeader);
+}
+
+// Move the head to the next sector in the ring, recycling it if used
+static void advance_head() {
+  uint8_t next = (head_sector + 1) % TL_SECTORS;
+  if (sector_valid(next)) index_drop_sector(next);
+  open_sector(next, head_seq + 1);
+}
+
+// Free index space by erasing the sector with the oldest data
+static void recycle_oldest() {
+  int16_t oldest = -1;
+  for (uint8_t s = 0; s < TL_SECTORS; s++) {
+    if (s == head_sector || !sector_valid(s)) continue;
+    if (oldest < 0 || sector_at(s)->seq < sector_at(oldest)->seq) oldest = s;
+  }
+  if (oldest < 0) {                      // everything is in the head sector
+    advance_head();
+    return;
+  }
+  index_drop_sector(oldest);
+  flash_store_erase(FLASH_TIMELINE_OFFSET + oldest * FLASH_SECTOR_SIZE, FLASH_SECTOR_SIZE);
+}
+
+// Index the live records of one sector; returns the end of its data. A
+// record torn by a power cut (bad magic, lengths or CRC) is always the
+// last one written, so the scan stops there and does not index it.
+static uint32_t scan_sector(uint8_t s) {
+  uint32_t off = s * FLASH_SECTOR_SIZE + sizeof(TimelineSectorHeader);
+  uint32_t end = (s + 1) * FLASH_SECTOR_SIZE;
+  while (off + sizeof(TimelineRecordHeader) <= end) {
+    const TimelineRecordHeader *r = record_at(off);
+    if (r->magic != TL_RECORD_MAGIC) break;
+    if (r->title_len > TIMELINE_TITLE_MAX || r->subtitle_len > TIMELINE_SUBTITLE_MAX ||
+        r->body_len > TIMELINE_BODY_MAX || off + record_len(r) > end) break;
+    if (r->crc != record_crc(r)) break;
+    if (r->flags & TL_FLAG_LIVE) index_insert(r->time, off);
+    off += align8(record_len(r));
+  }
+  return off;
+}
+
+bool timeline_init() {
+  count = 0;
+  ready = flash_store_ok();
+  if (!ready) return false;
+
+  // Sectors in write order (by sequence number)
+  uint8_t order[TL_SECTORS];
+  uint8_t used = 0;
+  for (uint8_t s = 0; s < TL_SECTORS; s++) {
+    if (!sector_valid(s)) continue;
+    uint8_t i = used++;
+    while (i > 0 && sector_at(order[i - 1])->seq > sector_at(s)->seq) {
+      order[i] = order[i - 1];
+      i--;
+    }
+    order[i] = s;
+  }
+
+  if (!used) {
+    open_sector(0, 1);
+    return true;
+  }
+
+  for (uint8_t i = 0; i < used; i++) {
+    uint32_t end = scan_sector(order[i]);
+    if (i == used - 1) {
+      head_sector = order[i];
+      head_seq = sector_at(head_sector)->seq;
+      write_off = end;
+    }
+  }
+
+  // A torn write leaves programmed bytes past the last good record; the
+  // next add cannot go over them, so start a fresh sector instead
+  uint32_t sector_end = (head_sector + 1u) * FLASH_SECTOR_SIZE;
+  if (!flash_store_erased(FLASH_TIMELINE_OFFSET + write_off, sector_end - write_off)) advance_head();
+  return true;
+}
+
+static uint8_t clamp_len(const char *s, uint8_t max) {
+  size_t n = s ? strlen(s) : 0;
+  return n > max ? max : n;
+}
+
+bool timeline_add(uint32_t time, const char *title, const char *subtitle, const char *body) {
+  if (!ready) return false;
+
+  uint8_t tl = clamp_len(title, TIMELINE_TITLE_MAX);
+  uint8_t sl = clamp_len(subtitle, TIMELINE_SUBTITLE_MAX);
+  uint8_t bl = clamp_len(body, TIMELINE_BODY_MAX);
+  uint16_t len = sizeof(TimelineRecordHeader) + tl + 1 + sl + 1 + bl + 1;
+
+  while (count >= TIMELINE_MAX_EVENTS) recycle_oldest();
+  if (write_off + align8(len) > (head_sector + 1u) * FLASH_SECTOR_SIZE) advance_head();
+
+  alignas(4) uint8_t buf[sizeof(TimelineRecordHeader) + TIMELINE_TITLE_MAX + TIMELINE_SUBTITLE_MAX + TIMELINE_BODY_MAX + 3];
+  TimelineRecordHeader *h = (TimelineRecordHeader *)buf;
+  *h = { TL_RECORD_MAGIC, 0, time, TL_FLAG_LIVE, tl, sl, bl };
+  uint8_t *p = buf + sizeof(*h);
+  memcpy(p, title, tl);     p += tl; *p++ = 0;
+  memcpy(p, subtitle, sl);  p += sl; *p++ = 0;
+  memcpy(p, body, bl);      p += bl; *p++ = 0;
+  h->crc = record_crc(h);
+
+  if (!flash_store_program(FLASH_TIMELINE_OFFSET + write_off, buf, len)) return false;
+  index_insert(time, write_off);
+  write_off += align8(len);
+  return true;
+}
+
+uint16_t timeline_count() {
+  return count;
+}
+
+bool timeline_get(uint16_t idx, TimelineEvent *out) {
+  if (idx >= count) return false;
+  const TimelineRecordHeader *r = record_at(index_[idx].off8 * 8u);
+  const char *text = (const char *)(r + 1);
+  out->time = r->time;
+  out->title = text;
+  out->subtitle = text + r->title_len + 1;
+  out->body = out->subtitle + r->subtitle_len + 1;
+  return true;
+}
+
+bool timeline_remove(uint16_t idx) {
+  if (idx >= count) return false;
+  uint32_t off = index_[idx].off8 * 8u;
+  uint8_t flags = record_at(off)->flags & ~TL_FLAG_LIVE;
+  flash_store_program(FLASH_TIMELINE_OFFSET + off + offsetof(TimelineRecordHeader, flags), &flags, 1);
+  memmove(&index_[idx], &index_[idx + 1], (count - idx - 1) * sizeof(TimelineIndexEntry));
+  count--;
+  return true;
+}
+
+void timeline_clear() {
+  if (!ready) return;
+  flash_store_erase(FLASH_TIMELINE_OFFSET, FLASH_TIMELINE_SIZE);
+  count = 0;
+  open_sector(0, 1);
+}
+
+uint32_t timeline_bytes_used() {
+  if (!ready) return 0;
+  uint32_t full = 0;
+  for (uint8_t s = 0; s < TL_SECTORS; s++) {
+    if (s != head_sector && sector_valid(s)) full += FLASH_SECTOR_SIZE;
+  }
+  return full + write_off - head_sector * FLASH_SECTOR_SIZE;
+}
@@ -0,0 +1,59 @@
+/*
+ * Timeline.h - Time-indexed event store in flash
+ *
+ * Events are appended to a log in the timeline flash partition and never
+ * rewritten; deleting one clears a flag bit in place. The partition is a
+ * ring of sectors, each starting with a sequence number, and the oldest
+ * sector is erased when the log wraps.
+ *
+ * Record format (8-byte aligned, little-endian):
+ *   uint16 magic, uint16 crc, uint32 time (RTC epoch seconds),
+ *   uint8 flags, uint8 title_len, uint8 subtitle_len, uint8 body_len,
+ *   then title, subtitle and body, each NUL terminated
+ *
+ * The CRC-16 covers everything but magic and flags, so a record torn by
+ * a power cut is never indexed. If the log does not end in erased flash
+ * at boot, the next sector is opened rather than writing over the tear.
+ *
+ * RAM holds only a fixed-size index sorted by time: 6 bytes per event
+ * (time, record offset / 8). Finding "now" is a binary search, paging is
+ * a step through the index, and event text is read in place through XIP.
+ */
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <Arduino.h>
+
+#define TIMELINE_MAX_EVENTS   2048      // 12 KB index
+#define TIMELINE_TITLE_MAX    31
+#define TIMELINE_SUBTITLE_MAX 47
+#define TIMELINE_BODY_MAX     127
+
+struct TimelineEvent {
+  uint32_t    time;         // RTC epoch seconds
+  const char *title;        // XIP pointers, valid until the next add/remove
+  const char *subtitle;
+  const char *body;
+};
+
+// Scan the log and build the index; false if flash is unusable
+bool timeline_init();
+
+bool timeline_add(uint32_t time, const char *title, const char *subtitle, const char *body);
+
+// Events in time order, index 0 = oldest
+uint16_t timeline_count();
+bool timeline_get(uint16_t idx, TimelineEvent *out);
+
+// First index whose time is >= time (timeline_count() if none)
+uint16_t timeline_lower_bound(uint32_t time);
+
+bool timeline_remove(uint16_t idx);
+
+// Erase the whole log
+void timeline_clear();
+
+uint32_t timeline_bytes_used();
+
+#endif // TIMELINE_H
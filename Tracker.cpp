@@ -0,0 +1,479 @@
+/*
+ * Tracker.cpp - Pattern-based music player implementation
+ */
+
+#include "Tracker.h"
+#include "Synth.h"
+#include "ConstMath.h"
+#include <string.h>
+
+#define TRACKER_BARRIER() __asm__ volatile("" ::: "memory")
+
+#define PITCH_OCTAVE   192                       // 1/16 semitones
+#define PITCH_MAX      (96 * 16 - 1)
+#define FX_NONE        0xFF
+
+enum Request : uint8_t { REQ_NONE, REQ_PLAY, REQ_STOP };
+
+struct Event {
+  uint8_t flags;
+  uint8_t note;
+  uint8_t inst;
+  uint8_t volume;
+  uint8_t fx;
+  uint8_t param;
+};
+
+// Row decoder over one pattern; bounds-checked so validation and playback share it
+struct Cursor {
+  const uint8_t *p;
+  const uint8_t *end;
+  uint8_t skip;              // empty rows still to hand out
+};
+
+struct Channel {
+  int8_t   voice;
+  uint8_t  inst;             // 1-based, 0 = none yet
+  uint8_t  volume;           // 0-64
+  bool     sounding;
+  int16_t  pitch;            // 1/16 semitones above C-0
+  int16_t  target;           // slide-to-note destination
+  uint8_t  fx;
+  uint8_t  param;
+  uint8_t  porta_speed;      // remembered by 3xx
+  uint8_t  vib_speed;        // remembered by 4xy
+  uint8_t  vib_depth;
+  uint8_t  vib_pos;
+};
+
+// ---------- Pitch table (generated at compile time) ----------
+
+static constexpr double C7_HZ = 2093.0045224047;
+
+struct PitchTable {
+  uint32_t q8[PITCH_OCTAVE];       // top octave (C-7 up), Q8 Hz
+};
+
+static constexpr PitchTable make_pitches() {
+  PitchTable t{};
+  for (int i = 0; i < PITCH_OCTAVE; i++) t.q8[i] = (uint32_t)(C7_HZ * cx_exp(LN2 * i / PITCH_OCTAVE) * 256 + 0.5);
+  return t;
+}
+
+static constexpr PitchTable PITCHES = make_pitches();
+static_assert(PITCHES.q8[9 * 16] == 3520 * 256, "A-7 is 3520 Hz");
+
+// SRAM copy for the tick (see ConstMath.h)
+static PitchTable pitches = PITCHES;
+
+// ProTracker's vibrato half-wave
+static const uint8_t VIBRATO[32] = {
+    0,  24,  49,  74,  97, 120, 141, 161, 180, 197, 212, 224, 235, 244, 250, 253,
+  255, 253, 250, 244, 235, 224, 212, 197, 180, 161, 141, 120,  97,  74,  49,  24,
+};
+
+// ---------- State ----------
+
+static uint32_t rate = 24000;
+static uint8_t  bus = 0;
+
+// Song (valid while playing)
+static const uint8_t *song = nullptr;
+static const uint8_t *song_end = nullptr;
+static uint8_t  n_channels, n_orders, n_rows, restart;
+static const uint8_t *inst_table, *order_table, *pattern_table;
+
+// Position
+static uint8_t  speed, tempo, tick;
+static volatile uint8_t order, row;
+static int16_t  jump_order = -1, break_row = -1;
+static bool     looping = false;
+static volatile bool playing = false;
+static Cursor   cursor;
+static uint32_t next_at;
+static uint32_t tick_q8;                 // samples per tick, Q8
+static uint32_t tick_frac;
+static Channel  channels[TRACKER_CHANNELS];
+
+// Requests from loop()
+static volatile uint8_t  request = REQ_NONE;
+static const uint8_t    *pending_song = nullptr;
+static uint32_t          pending_size = 0;
+static bool              pending_loop = false;
+
+static inline uint16_t le16(const uint8_t *p) {
+  return p[0] | p[1] << 8;
+}
+
+static inline uint8_t tag_of(uint8_t c) {
+  return TRACKER_TAG_BASE + c;
+}
+
+// ---------- Decoding ----------
+
+static bool seek_pattern(Cursor &c, const uint8_t *start, const uint8_t *end, uint8_t pattern,
+                         const uint8_t *patterns) {
+  uint16_t off = le16(patterns + 2 * pattern);
+  if (start + off >= end) return false;
+  c.p = start + off;
+  c.end = end;
+  c.skip = 0;
+  return true;
+}
+
+// Next row's events (flags 0 where a channel is idle); false on malformed data
+static bool read_row(Cursor &c, uint8_t chans, Event *ev) {
+  for (uint8_t i = 0; i < chans; i++) ev[i].flags = 0;
+  if (c.skip) {
+    c.skip--;
+    return true;
+  }
+  if (c.p >= c.end) return false;
+  uint8_t mask = *c.p++;
+  if (mask & 0x80) {
+    c.skip = mask & 0x7F;
+    return true;
+  }
+  if (!mask || mask >> chans) return false;
+  for (uint8_t i = 0; i < chans; i++) {
+    if (!(mask & (1u << i))) continue;
+    if (c.p >= c.end) return false;
+    Event &e = ev[i];
+    e.flags = *c.p++;
+    if (!e.flags || e.flags & 0xF0) return false;
+    uint8_t need = !!(e.flags & TRACKER_HAS_NOTE) + !!(e.flags & TRACKER_HAS_INST) +
+                   !!(e.flags & TRACKER_HAS_VOLUME) + 2 * !!(e.flags & TRACKER_HAS_EFFECT);
+    if (c.end - c.p < need) return false;
+    if (e.flags & TRACKER_HAS_NOTE) e.note = *c.p++;
+    if (e.flags & TRACKER_HAS_INST) e.inst = *c.p++;
+    if (e.flags & TRACKER_HAS_VOLUME) e.volume = *c.p++;
+    if (e.flags & TRACKER_HAS_EFFECT) {
+      e.fx = *c.p++;
+      e.param = *c.p++;
+    }
+  }
+  return true;
+}
+
+bool tracker_validate(const uint8_t *data, uint32_t size, TrackerInfo *info) {
+  if (!data || size < TRACKER_HEADER_BYTES) return false;
+  if ((uint32_t)(data[0] | data[1] << 8 | data[2] << 16 | (uint32_t)data[3] << 24) != TRACKER_MAGIC) return false;
+  uint8_t chans = data[4], insts = data[5], pats = data[6], ords = data[7];
+  uint8_t spd = data[8], bpm = data[9], rst = data[10], rows = data[11];
+  if (!chans || chans > TRACKER_CHANNELS || !insts || !pats || !ords) return false;
+  if (!spd || spd >= 32 || bpm < 32 || rst >= ords || !rows || rows > TRACKER_MAX_ROWS) return false;
+
+  const uint8_t *insts_at = data + TRACKER_HEADER_BYTES;
+  const uint8_t *orders_at = insts_at + insts * TRACKER_INST_BYTES;
+  const uint8_t *patterns_at = orders_at + ords;
+  const uint8_t *end = data + size;
+  if (patterns_at + 2 * pats > end) return false;
+
+  for (uint8_t i = 0; i < insts; i++) {
+    const uint8_t *in = insts_at + i * TRACKER_INST_BYTES;
+    if (in[0] > WAVE_NOISE || in[1] > 64) return false;
+  }
+  for (uint8_t i = 0; i < ords; i++) {
+    if (orders_at[i] >= pats) return false;
+  }
+  for (uint8_t p = 0; p < pats; p++) {
+    Cursor c;
+    if (!seek_pattern(c, data, end, p, patterns_at)) return false;
+    Event ev[TRACKER_CHANNELS];
+    for (uint8_t r = 0; r < rows; r++) {
+      if (!read_row(c, chans, ev)) return false;
+      for (uint8_t i = 0; i < chans; i++) {
+        const Event &e = ev[i];
+        if ((e.flags & TRACKER_HAS_NOTE) && (!e.note || e.note > TRACKER_NOTE_OFF)) return false;
+        if ((e.flags & TRACKER_HAS_INST) && (!e.inst || e.inst > insts)) return false;
+        if ((e.flags & TRACKER_HAS_VOLUME) && e.volume > 64) return false;
+        if (e.flags & TRACKER_HAS_EFFECT) {
+          if (e.fx > 0x0F) return false;
+          if (e.fx == 0x0B && e.param >= ords) return false;
+          if (e.fx == 0x0D && e.param >= rows) return false;
+        }
+      }
+    }
+    if (c.skip) return false;                    // a run past the last row
+  }
+
+  if (info) {
+    memcpy(info->title, data + 12, TRACKER_TITLE_LEN);
+    info->title[TRACKER_TITLE_LEN] = 0;
+    info->channels = chans;
+    info->instruments = insts;
+    info->patterns = pats;
+    info->orders = ords;
+    info->rows = rows;
+  }
+  return true;
+}
+
+// ---------- Playback ----------
+
+static void set_tempo(uint8_t bpm) {
+  tempo = bpm;
+  tick_q8 = rate * 5 * 256 / (2 * (uint32_t)bpm);
+}
+
+static uint32_t freq_q8(int16_t pitch) {
+  if (pitch < 0) pitch = 0;
+  if (pitch > PITCH_MAX) pitch = PITCH_MAX;
+  return pitches.q8[pitch % PITCH_OCTAVE] >> (7 - pitch / PITCH_OCTAVE);
+}
+
+static void release(uint8_t c) {
+  synth_release_tag(tag_of(c));
+  channels[c].sounding = false;
+  channels[c].voice = -1;
+}
+
+static void trigger(uint8_t c, int16_t pitch) {
+  Channel &ch = channels[c];
+  release(c);
+  if (!ch.inst) return;
+  const uint8_t *in = inst_table + (ch.inst - 1) * TRACKER_INST_BYTES;
+  SynthNote n;
+  n.wave = (SynthWave)in[0];
+  n.freq_hz = freq_q8(pitch) >> 8;
+  n.end_freq_hz = 0;
+  n.gate_ms = 0;                               // held until the next note or an off
+  n.volume = 0;                                // set with the pitch on this tick
+  n.env.attack_ms = le16(in + 4);
+  n.env.decay_ms = le16(in + 6);
+  n.env.sustain = (uint16_t)(in[2] * 32767u / 255);
+  n.env.release_ms = le16(in + 8);
+  n.bus = bus;
+  ch.voice = synth_note_on(n, tag_of(c));
+  ch.sounding = true;
+  ch.pitch = pitch;
+  ch.vib_pos = 0;
+}
+
+static void start_row(uint8_t c, const Event &e) {
+  Channel &ch = channels[c];
+  if (e.flags & TRACKER_HAS_INST) {
+    ch.inst = e.inst;
+    ch.volume = inst_table[(e.inst - 1) * TRACKER_INST_BYTES + 1];
+  }
+  if (e.flags & TRACKER_HAS_VOLUME) ch.volume = e.volume;
+  ch.fx = (e.flags & TRACKER_HAS_EFFECT) ? e.fx : FX_NONE;
+  ch.param = (e.flags & TRACKER_HAS_EFFECT) ? e.param : 0;
+
+  if (e.flags & TRACKER_HAS_NOTE) {
+    int16_t pitch = (e.note - 1) * 16;
+    if (e.note == TRACKER_NOTE_OFF) {
+      synth_release_tag(tag_of(c));
+      ch.sounding = false;
+    } else if (ch.fx == 0x03 && ch.sounding) {
+      ch.target = pitch;                         // slide there instead of retriggering
+    } else {
+      trigger(c, pitch);
+    }
+  }
+
+  switch (ch.fx) {
+    case 0x03:
+      if (ch.param) ch.porta_speed = ch.param;
+      break;
+    case 0x04:
+      if (ch.param >> 4) ch.vib_speed = ch.param >> 4;
+      if (ch.param & 0x0F) ch.vib_depth = ch.param & 0x0F;
+      break;
+    case 0x0B:
+      jump_order = ch.param;
+      break;
+    case 0x0C:
+      ch.volume = ch.param > 64 ? 64 : ch.param;
+      break;
+    case 0x0D:
+      break_row = ch.param;
+      break;
+    case 0x0F:
+      if (ch.param >= 32) set_tempo(ch.param);
+      else if (ch.param) speed = ch.param;
+      break;
+  }
+}
+
+static void run_effect(Channel &ch) {
+  switch (ch.fx) {
+    case 0x01:
+      ch.pitch = ch.pitch + ch.param > PITCH_MAX ? PITCH_MAX : ch.pitch + ch.param;
+      break;
+    case 0x02:
+      ch.pitch = ch.pitch - ch.param < 0 ? 0 : ch.pitch - ch.param;
+      break;
+    case 0x03:
+      if (ch.pitch < ch.target) ch.pitch = ch.pitch + ch.porta_speed > ch.target ? ch.target : ch.pitch + ch.porta_speed;
+      else if (ch.pitch > ch.target) ch.pitch = ch.pitch - ch.porta_speed < ch.target ? ch.target : ch.pitch - ch.porta_speed;
+      break;
+    case 0x04:
+      ch.vib_pos = (ch.vib_pos + ch.vib_speed) & 63;
+      break;
+    case 0x0A: {
+      int v = ch.volume + (ch.param >> 4) - (ch.param & 0x0F);
+      ch.volume = v < 0 ? 0 : (v > 64 ? 64 : v);
+      break;
+    }
+  }
+}
+
+// Push each channel's pitch (with arpeggio / vibrato) and volume to its voice
+static void update_voices() {
+  for (uint8_t c = 0; c < n_channels; c++) {
+    Channel &ch = channels[c];
+    if (ch.voice < 0) continue;
+    int16_t pitch = ch.pitch;
+    if (ch.fx == 0x00 && ch.param) {
+      uint8_t step = tick % 3;
+      if (step) pitch += 16 * (step == 1 ? ch.param >> 4 : ch.param & 0x0F);
+    } else if (ch.fx == 0x04) {
+      int16_t v = VIBRATO[ch.vib_pos & 31] * ch.vib_depth >> 7;
+      pitch += ch.vib_pos & 32 ? -v : v;
+    }
+    // Four full channels peak at 2x full scale; the mixer saturates the rest
+    uint16_t vol = (uint16_t)(ch.volume * inst_table[(ch.inst - 1) * TRACKER_INST_BYTES + 1] * 4);
+    if (!synth_voice_set(ch.voice, tag_of(c), freq_q8(pitch), vol)) {
+      ch.voice = -1;                             // finished, or stolen by an effect
+      ch.sounding = false;
+    }
+  }
+}
+
+static void stop_now() {
+  for (uint8_t c = 0; c < TRACKER_CHANNELS; c++) release(c);
+  playing = false;
+  song = nullptr;
+}
+
+// Point the cursor at (ord, r); false ends the song
+static bool go_to(int16_t ord, uint8_t r) {
+  if (ord >= n_orders) {
+    if (!looping) return false;
+    ord = restart;
+  }
+  order = (uint8_t)ord;
+  row = r;
+  seek_pattern(cursor, song, song_end, order_table[order], pattern_table);
+  Event skipped[TRACKER_CHANNELS];
+  for (uint8_t i = 0; i < r; i++) read_row(cursor, n_channels, skipped);
+  return true;
+}
+
+static void advance_row() {
+  int16_t ord = order;
+  uint8_t r = row + 1;
+  if (jump_order >= 0 || break_row >= 0) {
+    if (jump_order >= 0 && jump_order <= order && !looping) {
+      stop_now();                                // a loop back: the end of a one-shot song
+      return;
+    }
+    ord = jump_order >= 0 ? jump_order : order + 1;
+    r = break_row >= 0 ? break_row : 0;
+    jump_order = break_row = -1;
+  } else if (r >= n_rows) {
+    ord = order + 1;
+    r = 0;
+  }
+  if (ord != order || r != row + 1) {
+    if (!go_to(ord, r)) stop_now();
+  } else {
+    row = r;
+  }
+}
+
+static void run_tick() {
+  if (tick == 0) {
+    Event ev[TRACKER_CHANNELS];
+    read_row(cursor, n_channels, ev);
+    for (uint8_t c = 0; c < n_channels; c++) start_row(c, ev[c]);
+  } else {
+    for (uint8_t c = 0; c < n_channels; c++) run_effect(channels[c]);
+  }
+  update_voices();
+
+  uint32_t len = tick_frac + tick_q8;
+  next_at += len >> 8;
+  tick_frac = len & 0xFF;
+  if (++tick >= speed) {
+    tick = 0;
+    advance_row();
+  }
+}
+
+static void start_song(const uint8_t *data, uint32_t size, bool loop, uint32_t now) {
+  stop_now();
+  song = data;
+  song_end = data + size;
+  n_channels = data[4];
+  n_orders = data[7];
+  speed = data[8];
+  restart = data[10];
+  n_rows = data[11];
+  inst_table = data + TRACKER_HEADER_BYTES;
+  order_table = inst_table + data[5] * TRACKER_INST_BYTES;
+  pattern_table = order_table + n_orders;
+  set_tempo(data[9]);
+  looping = loop;
+  for (uint8_t c = 0; c < TRACKER_CHANNELS; c++) {
+    memset(&channels[c], 0, sizeof(Channel));
+    channels[c].voice = -1;
+    channels[c].fx = FX_NONE;
+  }
+  tick = 0;
+  tick_frac = 0;
+  jump_order = break_row = -1;
+  next_at = now;
+  go_to(0, 0);
+  playing = true;
+}
+
+// ---------- API ----------
+
+void tracker_init(uint32_t sample_rate, uint8_t mixer_bus) {
+  rate = sample_rate;
+  bus = mixer_bus;
+  playing = false;
+  song = nullptr;
+  request = REQ_NONE;
+}
+
+bool tracker_play(const uint8_t *data, uint32_t size, bool loop) {
+  if (!tracker_validate(data, size, nullptr)) return false;
+  pending_song = data;
+  pending_size = size;
+  pending_loop = loop;
+  TRACKER_BARRIER();
+  request = REQ_PLAY;
+  return true;
+}
+
+void tracker_stop() {
+  request = REQ_STOP;
+}
+
+bool tracker_playing() {
+  return request == REQ_PLAY || (playing && request != REQ_STOP);
+}
+
+const uint8_t *tracker_song() {
+  return request == REQ_PLAY ? pending_song : (playing ? song : nullptr);
+}
+
+void tracker_position(uint8_t *ord, uint8_t *r) {
+  *ord = order;
+  *r = row;
+}
+
+uint32_t tracker_service(uint32_t now) {
+  uint8_t req = request;
+  if (req != REQ_NONE) {
+    TRACKER_BARRIER();
+    request = REQ_NONE;
+    if (req == REQ_PLAY) start_song(pending_song, pending_size, pending_loop, now);
+    else stop_now();
+  }
+  while (playing && (int32_t)(next_at - now) <= 0) run_tick();
+  return playing ? next_at - now : UINT32_MAX;
+}
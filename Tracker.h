@@ -0,0 +1,90 @@
+/*
+ * Tracker.h - Pattern-based music player
+ *
+ * Songs are MOD-style: a list of orders, each naming a pattern of rows,
+ * each row holding at most one event per channel (note, instrument,
+ * volume, effect). Instruments are synth wavetables with an ADSR, so a
+ * song is only its note data: a few KB for minutes of looping music.
+ * tools/tracker_convert builds songs from a text score or a ProTracker
+ * .mod and reports their size and cost.
+ *
+ * The player runs from the audio refill interrupt like the SFX sequencer:
+ * tracker_service() is called with the sample clock, plays every tick
+ * that is due (rows start on tick 0, effects update on every tick) and
+ * says how long until the next one. Its cost is per tick, not per sample,
+ * and bounded by the channel count. Song data is read in place (XIP).
+ *
+ * Song layout (little endian, no alignment required):
+ *
+ *   header:      "TRK1", uint8 channels, instruments, patterns, orders,
+ *                speed (ticks per row), tempo (BPM; a tick is 2.5/tempo s),
+ *                restart (order to loop to), rows (per pattern), char title[20]
+ *   instruments: wave, volume (0-64), sustain (0-255), 0,
+ *                uint16 attack_ms, decay_ms, release_ms
+ *   orders:      one pattern number each
+ *   patterns:    uint16 offset of each pattern's data from the song start
+ *   data:        per row either 0x80 | (n - 1) for n empty rows, or a mask
+ *                of the channels with events followed by, per channel, a
+ *                flags byte (TRACKER_HAS_*) and the fields it announces
+ *
+ * Notes are 1-96 (C-0 to B-7), TRACKER_NOTE_OFF releases the channel.
+ * Effects are ProTracker's, with pitch in 1/16 semitones:
+ *   0xy arpeggio         1xx slide up         2xx slide down
+ *   3xx slide to note    4xy vibrato          Axy volume slide
+ *   Bxx jump to order    Cxx set volume       Dxx break to row xx
+ *   Fxx speed (< 32) or tempo
+ *
+ * No Arduino dependencies. Not reentrant: tracker_play()/tracker_stop()
+ * only post a request, which the next tracker_service() acts on.
+ */
+
+#ifndef TRACKER_H
+#define TRACKER_H
+
+#include <stdint.h>
+
+#define TRACKER_MAGIC        0x314B5254u   // "TRK1"
+#define TRACKER_CHANNELS     4
+#define TRACKER_MAX_ROWS     128
+#define TRACKER_HEADER_BYTES 32
+#define TRACKER_INST_BYTES   10
+#define TRACKER_TITLE_LEN    20
+#define TRACKER_NOTE_OFF     97
+#define TRACKER_TAG_BASE     0x40          // synth tags TRACKER_TAG_BASE + channel
+
+// Event flags
+#define TRACKER_HAS_NOTE     0x01
+#define TRACKER_HAS_INST     0x02
+#define TRACKER_HAS_VOLUME   0x04
+#define TRACKER_HAS_EFFECT   0x08
+
+struct TrackerInfo {
+  char     title[TRACKER_TITLE_LEN + 1];
+  uint8_t  channels;
+  uint8_t  instruments;
+  uint8_t  patterns;
+  uint8_t  orders;
+  uint8_t  rows;
+};
+
+// Check a song end to end (header, tables and every pattern); the player
+// trusts songs that pass. info may be null.
+bool tracker_validate(const uint8_t *song, uint32_t size, TrackerInfo *info);
+
+void tracker_init(uint32_t sample_rate, uint8_t bus);
+
+// Start a validated song from the top; loop = go back to the restart
+// order at the end (a backward jump ends a non-looping song too).
+// false if the song does not validate.
+bool tracker_play(const uint8_t *song, uint32_t size, bool loop);
+void tracker_stop();
+
+bool tracker_playing();
+const uint8_t *tracker_song();
+void tracker_position(uint8_t *order, uint8_t *row);
+
+// Refill side: play every tick due at sample clock now; returns samples
+// until the next tick (UINT32_MAX when stopped)
+uint32_t tracker_service(uint32_t now);
+
+#endif // TRACKER_H
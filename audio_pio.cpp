@@ -34,6 +34,7 @@
 #include "hardware/pio.h"
 #include "hardware/clocks.h"
 #include "audio_pio.h"
+#include "AudioOut.h"
 // #include "audio_data.h"   // Commented out - file too large
 // #include "music.h"        // Commented out - file too large
 #include "audio_pio.pio.h"
@@ -74,6 +75,24 @@ int32_t* data_treating(const int16_t *audio , uint32_t len)
 	return samples;
 }
 
+/******************************************************************************
+function: queue samples, waiting only while the engine's queue is full
+parameter:
+    samples :  16-bit mono samples
+    len     :  number of samples
+******************************************************************************/	
+static void audio_out_write_all(const int16_t *samples, uint32_t len)
+{
+	while (len)
+	{
+		uint32_t n = audio_out_write(samples, len);
+		samples += n;
+		len -= n;
+		if (len)
+			tight_loop_contents();
+	}
+}
+
 /******************************************************************************
 function: audio out
 parameter:
@@ -82,8 +101,16 @@ parameter:
 ******************************************************************************/	
 void audio_out(int32_t *samples, int32_t len) 
 {
-	for(uint16_t i = 0; i < len; i++)
-	   	pio_sm_put_blocking(pico_audio.pio_2, pico_audio.sm_dout, samples[i]);
+	// Left slot only (the codec is mono); queued for the DMA engine
+	int16_t chunk[64];
+	for(int32_t i = 0; i < len; )
+	{
+		int32_t n = len - i < 64 ? len - i : 64;
+		for(int32_t j = 0; j < n; j++)
+			chunk[j] = (int16_t)(samples[i + j] >> 16);
+		audio_out_write_all(chunk, n);
+		i += n;
+	}
 }
 
 /******************************************************************************
@@ -108,24 +135,12 @@ void pico_audio_write(pico_audio_t config, uint8_t* data, size_t len)
     if (!initialized) {
         mclk_pio_init();
         dout_pio_init();
+        audio_out_init();
         initialized = true;
     }
     
-    // Process and output each sample
-    for (uint32_t i = 0; i < sample_count; i++) {
-        int32_t sample_32bit;
-        
-        if (config.channel_count == 1) {
-            // Mono: duplicate the sample for left and right channels
-            sample_32bit = audio_samples[i] * 65536;
-        } else {
-            // Stereo: samples already interleaved
-            sample_32bit = audio_samples[i] * 65536 + audio_samples[i];
-        }
-        
-        // Write sample to PIO
-        pio_sm_put_blocking(config.pio_2, config.sm_dout, sample_32bit);
-    }
+    // Queue for the DMA engine; both channel layouts carry one mono stream
+    audio_out_write_all(audio_samples, sample_count);
 }
 
 #ifdef __cplusplus
@@ -173,36 +188,23 @@ void mclk_pio_init()
 
 
 /******************************************************************************
-function: Recording and playback loopback test
+function: Microphone to speaker loopback test
+info:     Streams each captured frame straight back out. Both state machines
+          follow the codec's LRCLK, so the FIFOs stay in step and memory use
+          is constant (the old record-then-play version malloc'd 480 KB).
 ******************************************************************************/	
 void Loopback_test()
 {
-    static int32_t *mic_sample_buffers;
-    static int mic_num_samples = 120000;
-
-    mic_sample_buffers = (int32_t*)malloc(mic_num_samples * sizeof(int32_t));
-    memset(mic_sample_buffers, 0, mic_num_samples * sizeof(int32_t)); 
-
     //MCLK
     mclk_pio_init();
     //READ
     din_pio_init();
     //WRITE
     dout_pio_init();
-    pio_sm_set_enabled(pico_audio.pio_2, pico_audio.sm_dout, false);
-    
+
     while (true) 
     {	
-        //READ
-        pio_sm_set_enabled(pico_audio.pio_1, pico_audio.sm_din, true);
-        for (int i = 0; i < mic_num_samples; i ++)
-            mic_sample_buffers[i] = pio_sm_get_blocking(pico_audio.pio_1, pico_audio.sm_din);
-        pio_sm_set_enabled(pico_audio.pio_1, pico_audio.sm_din, false);
-
-        //WRITE
-        pio_sm_set_enabled(pico_audio.pio_2, pico_audio.sm_dout, true);
-        for(int i = 0; i < mic_num_samples; i++)
-            pio_sm_put_blocking(pico_audio.pio_2, pico_audio.sm_dout, mic_sample_buffers[i]);
-        pio_sm_set_enabled(pico_audio.pio_2, pico_audio.sm_dout, false);
+        pio_sm_put_blocking(pico_audio.pio_2, pico_audio.sm_dout,
+                            pio_sm_get_blocking(pico_audio.pio_1, pico_audio.sm_din));
     }
 }
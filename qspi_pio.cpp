@@ -97,6 +97,17 @@ void QSPI_PIO_Init(pio_qspi_t qspi){
     pio_sm_set_enabled(qspi.pio, qspi.sm_1wire, false);  
 }
 
+/******************************************************************************
+function : Set the PIO clock divider of both QSPI state machines
+parameter:
+    qspi : QSPI structure
+    div  : clk_sys divider (1.0 = one PIO cycle per system clock)
+******************************************************************************/	
+void QSPI_Set_Clkdiv(pio_qspi_t qspi, float div){
+    pio_sm_set_clkdiv(qspi.pio, qspi.sm_4wire, div);
+    pio_sm_set_clkdiv(qspi.pio, qspi.sm_1wire, div);
+}
+
 /******************************************************************************
 function : QSPI PIO one-line mode, generally used to send commands
 parameter:
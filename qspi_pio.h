@@ -65,6 +65,7 @@ void QSPI_GPIO_Init(pio_qspi_t qspi);
 void QSPI_Select(pio_qspi_t qspi);
 void QSPI_Deselect(pio_qspi_t qspi);
 void QSPI_PIO_Init(pio_qspi_t qspi);
+void QSPI_Set_Clkdiv(pio_qspi_t qspi, float div);
 void QSPI_1Wrie_Mode(pio_qspi_t *qspi);
 void QSPI_4Wrie_Mode(pio_qspi_t *qspi);
 void QSPI_DATA_Write(pio_qspi_t qspi, uint32_t val);
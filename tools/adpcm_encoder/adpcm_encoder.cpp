@@ -0,0 +1,158 @@
+/*
+ * adpcm_encoder.cpp - Host IMA-ADPCM encoder and round-trip check
+ *
+ * Encodes a 16-bit PCM WAV (stereo is downmixed) into the clip format of
+ * Adpcm.h, then plays the result back through SamplePlayer.cpp, exactly
+ * as the watch would, and reports the size saving and the round-trip SNR.
+ * The asset packer's "adpcm" format uses the same encoder, so this is the
+ * place to audition a clip and pick a block size before packing it.
+ *
+ * Build:
+ *   g++ -O2 -std=c++17 -I../.. adpcm_encoder.cpp ../../SamplePlayer.cpp -o adpcm_encoder
+ *
+ * Usage:
+ *   adpcm_encoder in.wav out.ima [--block BYTES] [--wav decoded.wav]
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "Adpcm.h"
+#include "AssetPack.h"
+#include "SamplePlayer.h"
+
+#define BLOCK 256
+
+static uint32_t le32(const uint8_t *p) { return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24; }
+static uint16_t le16(const uint8_t *p) { return p[0] | p[1] << 8; }
+
+static bool read_wav(const char *path, std::vector<int16_t> &pcm, uint32_t &rate) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  std::vector<uint8_t> raw;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) raw.insert(raw.end(), buf, buf + n);
+  fclose(f);
+
+  if (raw.size() < 12 || memcmp(&raw[0], "RIFF", 4) || memcmp(&raw[8], "WAVE", 4)) {
+    fprintf(stderr, "%s: not a WAV file\n", path);
+    return false;
+  }
+  uint16_t channels = 0, bits = 0;
+  for (size_t p = 12; p + 8 <= raw.size();) {
+    uint32_t len = le32(&raw[p + 4]);
+    const uint8_t *body = &raw[p + 8];
+    if (p + 8 + len > raw.size()) break;
+    if (!memcmp(&raw[p], "fmt ", 4) && len >= 16) {
+      if (le16(body) != 1) break;           // PCM only
+      channels = le16(body + 2);
+      rate = le32(body + 4);
+      bits = le16(body + 14);
+    } else if (!memcmp(&raw[p], "data", 4) && channels && bits == 16) {
+      for (uint32_t i = 0; i + 2 * channels <= len; i += 2 * channels) {
+        int32_t sum = 0;
+        for (uint16_t c = 0; c < channels; c++) sum += (int16_t)le16(body + i + 2 * c);
+        pcm.push_back((int16_t)(sum / channels));
+      }
+      return true;
+    }
+    p += 8 + len + (len & 1);
+  }
+  fprintf(stderr, "%s: need 16-bit PCM with a data chunk\n", path);
+  return false;
+}
+
+static bool write_wav(const char *path, const std::vector<int16_t> &pcm, uint32_t rate) {
+  FILE *f = fopen(path, "wb");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  uint32_t data = pcm.size() * 2, riff = 36 + data, fmt_len = 16, byte_rate = rate * 2;
+  uint16_t pcm_fmt = 1, channels = 1, align = 2, bits = 16;
+  fwrite("RIFF", 1, 4, f); fwrite(&riff, 4, 1, f); fwrite("WAVE", 1, 4, f);
+  fwrite("fmt ", 1, 4, f); fwrite(&fmt_len, 4, 1, f);
+  fwrite(&pcm_fmt, 2, 1, f); fwrite(&channels, 2, 1, f); fwrite(&rate, 4, 1, f);
+  fwrite(&byte_rate, 4, 1, f); fwrite(&align, 2, 1, f); fwrite(&bits, 2, 1, f);
+  fwrite("data", 1, 4, f); fwrite(&data, 4, 1, f);
+  fwrite(pcm.data(), 2, pcm.size(), f);
+  fclose(f);
+  return true;
+}
+
+int main(int argc, char **argv) {
+  const char *in = nullptr, *out = nullptr, *wav = nullptr;
+  unsigned block_bytes = ADPCM_BLOCK_BYTES;
+  for (int i = 1; i < argc; i++) {
+    bool has_val = i + 1 < argc;
+    if (!strcmp(argv[i], "--block") && has_val)    block_bytes = strtoul(argv[++i], nullptr, 10);
+    else if (!strcmp(argv[i], "--wav") && has_val) wav = argv[++i];
+    else if (argv[i][0] != '-' && !in)             in = argv[i];
+    else if (argv[i][0] != '-' && !out)            out = argv[i];
+    else {
+      in = nullptr;
+      break;
+    }
+  }
+  if (!in || !out || block_bytes < 8 || block_bytes > 4096) {
+    fprintf(stderr, "usage: %s in.wav out.ima [--block BYTES (8-4096)] [--wav decoded.wav]\n", argv[0]);
+    return 1;
+  }
+
+  std::vector<int16_t> pcm;
+  uint32_t rate = 0;
+  if (!read_wav(in, pcm, rate)) return 1;
+  if (pcm.empty()) {
+    fprintf(stderr, "%s: no samples\n", in);
+    return 1;
+  }
+
+  std::vector<uint8_t> clip(adpcm_clip_bytes(pcm.size(), block_bytes));
+  clip.resize(adpcm_encode_clip(pcm.data(), pcm.size(), clip.data(), block_bytes));
+  FILE *f = fopen(out, "wb");
+  if (!f) {
+    perror(out);
+    return 1;
+  }
+  fwrite(clip.data(), 1, clip.size(), f);
+  fclose(f);
+
+  // Decode through the device player at the clip's own rate (no resampling)
+  sample_player_init(rate);
+  if (sample_player_start(clip.data(), clip.size(), ASSET_ADPCM, rate, 32767) < 0) {
+    fprintf(stderr, "player rejected the clip\n");
+    return 1;
+  }
+  std::vector<int16_t> decoded;
+  int16_t block[BLOCK];
+  while (decoded.size() < pcm.size()) {
+    memset(block, 0, sizeof(block));
+    if (!sample_player_mix(block, BLOCK, 0)) break;
+    decoded.insert(decoded.end(), block, block + BLOCK);
+  }
+  decoded.resize(pcm.size());
+
+  // Volume 32767 is a hair under unity; compare against the same gain
+  double signal = 0, noise = 0;
+  for (size_t i = 0; i < pcm.size(); i++) {
+    double ref = (pcm[i] * 32767) >> 15;
+    signal += ref * ref;
+    noise += (ref - decoded[i]) * (ref - decoded[i]);
+  }
+  double snr = noise > 0 ? 10 * log10(signal / noise) : INFINITY;
+
+  printf("%zu samples at %u Hz (%.2f s), %u-byte blocks of %u samples\n", pcm.size(), rate,
+         (double)pcm.size() / rate, block_bytes, adpcm_samples_per_block(block_bytes));
+  printf("PCM16 %zu bytes -> ADPCM %zu bytes (%.2f:1), round-trip SNR %.1f dB\n",
+         pcm.size() * 2, clip.size(), (double)pcm.size() * 2 / clip.size(), snr);
+
+  if (wav && !write_wav(wav, decoded, rate)) return 1;
+  return 0;
+}
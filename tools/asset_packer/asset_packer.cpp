@@ -0,0 +1,368 @@
+/*
+ * asset_packer.cpp - Host builder for the flash asset pack
+ *
+ * Reads a manifest and writes the pack described in AssetPack.h. One asset
+ * per line, '#' starts a comment; paths are relative to the manifest:
+ *
+ *   <name> raw    <file>
+ *   <name> font   <file> <width> <height>   C source (fontNN.cpp) or raw table
+ *   <name> rgb565 <file.ppm>                binary PPM (P6), 8-bit channels
+ *   <name> pcm16  <file.wav>                16-bit PCM WAV, stereo is downmixed
+ *   <name> adpcm  <file.wav> [block_bytes]  as pcm16, stored as IMA-ADPCM (Adpcm.h)
+ *   <name> song   <file.trk>                Tracker.h song from tools/tracker_convert
+ *
+ * Build:
+ *   g++ -O2 -std=c++17 -I../.. asset_packer.cpp -o asset_packer
+ *
+ * Usage:
+ *   asset_packer manifest.txt assets.bin [--uf2 assets.uf2] [--flash-size BYTES]
+ *
+ * The pack goes at FLASH_ASSETS_OFFSET, either with
+ *   picotool load -t bin assets.bin -o <address printed below>
+ * or by copying the UF2 (absolute family) onto the BOOTSEL drive.
+ */
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+static uint32_t flash_size = 16u * 1024u * 1024u;
+#define FLASH_SECTOR_SIZE      4096u
+#define PICO_FLASH_SIZE_BYTES  flash_size
+
+#include "AssetPack.h"
+#include "Adpcm.h"
+#include "Tracker.h"
+#include "FlashLayout.h"
+
+#define UF2_FAMILY_ABSOLUTE    0xE48BFF57u
+
+struct Item {
+  std::string name;
+  AssetEntry entry;
+  std::vector<uint8_t> data;
+};
+
+static bool read_file(const std::string &path, std::vector<uint8_t> &out) {
+  FILE *f = fopen(path.c_str(), "rb");
+  if (!f) {
+    perror(path.c_str());
+    return false;
+  }
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.insert(out.end(), buf, buf + n);
+  fclose(f);
+  return true;
+}
+
+// Bytes of the first initializer list in a C source, comments skipped
+static bool parse_c_array(const std::vector<uint8_t> &src, std::vector<uint8_t> &out) {
+  std::string s(src.begin(), src.end());
+  size_t i = s.find('{');
+  if (i == std::string::npos) return false;
+  for (i++; i < s.size() && s[i] != '}'; i++) {
+    if (s.compare(i, 2, "//") == 0) {
+      i = s.find('\n', i);
+      if (i == std::string::npos) return false;
+    } else if (s.compare(i, 2, "/*") == 0) {
+      i = s.find("*/", i);
+      if (i == std::string::npos) return false;
+      i++;
+    } else if (isdigit((unsigned char)s[i])) {
+      char *end;
+      unsigned long v = strtoul(&s[i], &end, 0);
+      if (v > 0xFF) return false;
+      out.push_back((uint8_t)v);
+      i = end - s.c_str() - 1;
+    }
+  }
+  return !out.empty();
+}
+
+static bool load_font(const std::string &path, uint16_t w, uint16_t h, Item &it) {
+  std::vector<uint8_t> raw;
+  if (!read_file(path, raw)) return false;
+  bool is_c = path.size() > 2 && (path.rfind(".c") == path.size() - 2 || path.rfind(".cpp") == path.size() - 4 ||
+                                  path.rfind(".h") == path.size() - 2);
+  if (is_c) {
+    if (!parse_c_array(raw, it.data)) {
+      fprintf(stderr, "%s: no byte array found\n", path.c_str());
+      return false;
+    }
+  } else {
+    it.data = raw;
+  }
+  size_t need = 95u * h * ((w + 7) / 8);
+  if (it.data.size() < need) {
+    fprintf(stderr, "%s: %zu bytes, %ux%u font needs %zu\n", path.c_str(), it.data.size(), w, h, need);
+    return false;
+  }
+  it.entry.format = ASSET_FONT;
+  it.entry.param = w | (uint32_t)h << 16;
+  return true;
+}
+
+static bool load_ppm(const std::string &path, Item &it) {
+  std::vector<uint8_t> raw;
+  if (!read_file(path, raw)) return false;
+  std::string s(raw.begin(), raw.end());
+  size_t pos = 0;
+  auto token = [&]() -> long {
+    for (;;) {
+      while (pos < s.size() && isspace((unsigned char)s[pos])) pos++;
+      if (pos < s.size() && s[pos] == '#') {
+        while (pos < s.size() && s[pos] != '\n') pos++;
+        continue;
+      }
+      break;
+    }
+    size_t start = pos;
+    while (pos < s.size() && !isspace((unsigned char)s[pos])) pos++;
+    return start == pos ? -1 : strtol(s.substr(start, pos - start).c_str(), nullptr, 10);
+  };
+  if (s.compare(0, 2, "P6") != 0) {
+    fprintf(stderr, "%s: not a binary PPM\n", path.c_str());
+    return false;
+  }
+  pos = 2;
+  long w = token(), h = token(), maxval = token();
+  pos++;                                  // single whitespace before the pixels
+  if (w <= 0 || h <= 0 || w > 0xFFFF || h > 0xFFFF || maxval != 255 || pos + w * h * 3 > s.size()) {
+    fprintf(stderr, "%s: unsupported PPM\n", path.c_str());
+    return false;
+  }
+  for (long i = 0; i < w * h; i++) {
+    const uint8_t *p = &raw[pos + i * 3];
+    uint16_t c = (p[0] >> 3) << 11 | (p[1] >> 2) << 5 | p[2] >> 3;
+    it.data.push_back(c & 0xFF);
+    it.data.push_back(c >> 8);
+  }
+  it.entry.format = ASSET_RGB565;
+  it.entry.param = (uint32_t)w | (uint32_t)h << 16;
+  return true;
+}
+
+static uint32_t le32(const uint8_t *p) { return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24; }
+static uint16_t le16(const uint8_t *p) { return p[0] | p[1] << 8; }
+
+static bool load_wav(const std::string &path, Item &it) {
+  std::vector<uint8_t> raw;
+  if (!read_file(path, raw)) return false;
+  if (raw.size() < 12 || memcmp(&raw[0], "RIFF", 4) || memcmp(&raw[8], "WAVE", 4)) {
+    fprintf(stderr, "%s: not a WAV file\n", path.c_str());
+    return false;
+  }
+  uint16_t channels = 0, bits = 0;
+  uint32_t rate = 0;
+  for (size_t p = 12; p + 8 <= raw.size();) {
+    uint32_t len = le32(&raw[p + 4]);
+    const uint8_t *body = &raw[p + 8];
+    if (p + 8 + len > raw.size()) break;
+    if (!memcmp(&raw[p], "fmt ", 4) && len >= 16) {
+      if (le16(body) != 1) break;           // PCM only
+      channels = le16(body + 2);
+      rate = le32(body + 4);
+      bits = le16(body + 14);
+    } else if (!memcmp(&raw[p], "data", 4) && channels && bits == 16) {
+      for (uint32_t i = 0; i + 2 * channels <= len; i += 2 * channels) {
+        int32_t sum = 0;
+        for (uint16_t c = 0; c < channels; c++) sum += (int16_t)le16(body + i + 2 * c);
+        int16_t v = (int16_t)(sum / channels);
+        it.data.push_back(v & 0xFF);
+        it.data.push_back((uint16_t)v >> 8);
+      }
+      it.entry.format = ASSET_PCM16;
+      it.entry.param = rate;
+      return true;
+    }
+    p += 8 + len + (len & 1);
+  }
+  fprintf(stderr, "%s: need 16-bit PCM with a data chunk\n", path.c_str());
+  return false;
+}
+
+static bool load_adpcm(const std::string &path, unsigned block_bytes, Item &it) {
+  if (!load_wav(path, it)) return false;
+  if (block_bytes < 8 || block_bytes > 4096) {
+    fprintf(stderr, "%s: ADPCM block size %u out of range\n", path.c_str(), block_bytes);
+    return false;
+  }
+  std::vector<int16_t> pcm(it.data.size() / 2);
+  for (size_t i = 0; i < pcm.size(); i++) pcm[i] = (int16_t)le16(&it.data[i * 2]);
+  it.data.assign(adpcm_clip_bytes(pcm.size(), block_bytes), 0);
+  it.data.resize(adpcm_encode_clip(pcm.data(), pcm.size(), it.data.data(), block_bytes));
+  it.entry.format = ASSET_ADPCM;
+  return true;
+}
+
+static bool load_song(const std::string &path, Item &it) {
+  if (!read_file(path, it.data)) return false;
+  if (it.data.size() < TRACKER_HEADER_BYTES || le32(&it.data[0]) != TRACKER_MAGIC) {
+    fprintf(stderr, "%s: not a tracker_convert song\n", path.c_str());
+    return false;
+  }
+  it.entry.format = ASSET_SONG;
+  return true;
+}
+
+static bool parse_manifest(const char *path, std::vector<Item> &items) {
+  FILE *f = fopen(path, "r");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  std::string dir(path);
+  size_t slash = dir.find_last_of('/');
+  dir = slash == std::string::npos ? "" : dir.substr(0, slash + 1);
+
+  char line[1024];
+  int lineno = 0;
+  bool ok = true;
+  while (ok && fgets(line, sizeof(line), f)) {
+    lineno++;
+    if (char *hash = strchr(line, '#')) *hash = 0;
+    char name[256], format[32], file[512];
+    unsigned w = 0, h = 0;
+    int n = sscanf(line, "%255s %31s %511s %u %u", name, format, file, &w, &h);
+    if (n <= 0) continue;
+    if (n < 3) {
+      fprintf(stderr, "%s:%d: expected <name> <format> <file>\n", path, lineno);
+      ok = false;
+      break;
+    }
+
+    Item it;
+    it.name = name;
+    memset(&it.entry, 0, sizeof(it.entry));
+    it.entry.hash = asset_hash(name);
+    std::string file_path = file[0] == '/' ? file : dir + file;
+    if (!strcmp(format, "raw")) {
+      ok = read_file(file_path, it.data);
+      it.entry.format = ASSET_RAW;
+    } else if (!strcmp(format, "font")) {
+      if (n < 5 || !w || !h || w > 0xFFFF || h > 0xFFFF) {
+        fprintf(stderr, "%s:%d: font needs <width> <height>\n", path, lineno);
+        ok = false;
+      } else {
+        ok = load_font(file_path, w, h, it);
+      }
+    } else if (!strcmp(format, "rgb565")) {
+      ok = load_ppm(file_path, it);
+    } else if (!strcmp(format, "pcm16")) {
+      ok = load_wav(file_path, it);
+    } else if (!strcmp(format, "adpcm")) {
+      ok = load_adpcm(file_path, n >= 4 ? w : ADPCM_BLOCK_BYTES, it);
+    } else if (!strcmp(format, "song")) {
+      ok = load_song(file_path, it);
+    } else {
+      fprintf(stderr, "%s:%d: unknown format '%s'\n", path, lineno, format);
+      ok = false;
+    }
+    if (ok) items.push_back(std::move(it));
+  }
+  fclose(f);
+  return ok;
+}
+
+static bool write_uf2(const char *path, const std::vector<uint8_t> &pack, uint32_t addr) {
+  FILE *f = fopen(path, "wb");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  uint32_t blocks = (pack.size() + 255) / 256;
+  for (uint32_t b = 0; b < blocks; b++) {
+    uint32_t block[128] = {};
+    uint32_t n = std::min<size_t>(256, pack.size() - b * 256);
+    block[0] = 0x0A324655;                  // magic start 0/1
+    block[1] = 0x9E5D5157;
+    block[2] = 0x00002000;                  // family ID present
+    block[3] = addr + b * 256;
+    block[4] = 256;
+    block[5] = b;
+    block[6] = blocks;
+    block[7] = UF2_FAMILY_ABSOLUTE;
+    memset(&block[8], 0xFF, 256);           // short last block pads with erased flash
+    memcpy(&block[8], &pack[b * 256], n);
+    block[127] = 0x0AB16F30;                // magic end
+    fwrite(block, sizeof(block), 1, f);
+  }
+  fclose(f);
+  return true;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s manifest.txt assets.bin [--uf2 assets.uf2] [--flash-size BYTES]\n", argv[0]);
+    return 1;
+  }
+  const char *uf2_path = nullptr;
+  for (int i = 3; i < argc; i++) {
+    bool has_val = i + 1 < argc;
+    if (!strcmp(argv[i], "--uf2") && has_val)             uf2_path = argv[++i];
+    else if (!strcmp(argv[i], "--flash-size") && has_val) flash_size = strtoul(argv[++i], nullptr, 0);
+    else {
+      fprintf(stderr, "unknown option %s\n", argv[i]);
+      return 1;
+    }
+  }
+
+  std::vector<Item> items;
+  if (!parse_manifest(argv[1], items)) return 1;
+  if (items.empty() || items.size() > 0xFFFF) {
+    fprintf(stderr, "%s: %zu assets\n", argv[1], items.size());
+    return 1;
+  }
+  std::sort(items.begin(), items.end(), [](const Item &a, const Item &b) { return a.entry.hash < b.entry.hash; });
+  for (size_t i = 1; i < items.size(); i++) {
+    if (items[i].entry.hash == items[i - 1].entry.hash) {
+      fprintf(stderr, "hash collision: '%s' and '%s', rename one\n", items[i - 1].name.c_str(), items[i].name.c_str());
+      return 1;
+    }
+  }
+
+  // Lay out the payloads after the index
+  uint32_t off = sizeof(AssetPackHeader) + items.size() * sizeof(AssetEntry);
+  for (Item &it : items) {
+    off = (off + ASSET_ALIGN - 1) & ~(ASSET_ALIGN - 1);
+    it.entry.offset = off;
+    it.entry.size = it.data.size();
+    off += it.data.size();
+  }
+  if (off > FLASH_ASSETS_SIZE) {
+    fprintf(stderr, "pack is %u bytes, partition holds %u\n", off, FLASH_ASSETS_SIZE);
+    return 1;
+  }
+
+  std::vector<uint8_t> pack(off, 0xFF);
+  std::vector<AssetEntry> index;
+  for (const Item &it : items) {
+    index.push_back(it.entry);
+    memcpy(&pack[it.entry.offset], it.data.data(), it.data.size());
+  }
+  AssetPackHeader hdr = { ASSET_PACK_MAGIC, ASSET_PACK_VERSION, (uint16_t)items.size(), off,
+                          asset_crc32(index.data(), index.size() * sizeof(AssetEntry)) };
+  memcpy(&pack[0], &hdr, sizeof(hdr));
+  memcpy(&pack[sizeof(hdr)], index.data(), index.size() * sizeof(AssetEntry));
+
+  FILE *f = fopen(argv[2], "wb");
+  if (!f || fwrite(pack.data(), 1, pack.size(), f) != pack.size()) {
+    perror(argv[2]);
+    return 1;
+  }
+  fclose(f);
+
+  uint32_t addr = 0x10000000u + FLASH_ASSETS_OFFSET;
+  for (const Item &it : items) {
+    printf("  %08x %-24s %7u bytes\n", it.entry.hash, it.name.c_str(), it.entry.size);
+  }
+  printf("%zu assets, %u of %u bytes\n", items.size(), off, FLASH_ASSETS_SIZE);
+  printf("picotool load -t bin %s -o 0x%08x\n", argv[2], addr);
+  if (uf2_path && !write_uf2(uf2_path, pack, addr)) return 1;
+  return 0;
+}
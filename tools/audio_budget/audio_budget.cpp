@@ -0,0 +1,205 @@
+/*
+ * audio_budget.cpp - Host refill budget check for the audio pipeline
+ *
+ * Runs the refill GameAudio's synth_source() does for every DMA block
+ * (SFX scripts, tracker ticks and the per-channel mixer, rendered in
+ * chunks that end on each event) through Synth.cpp, Sfx.cpp, Tracker.cpp,
+ * SamplePlayer.cpp and Mixer.cpp under a few workloads, and reports the
+ * mean and worst time per 256-frame block against the block period.
+ * Workloads are deterministic, so each runs several times and every block
+ * keeps its fastest pass; what is left is the code, not host scheduling.
+ *
+ * Host times are scaled by --slowdown to estimate the watch. The default
+ * is a rough host-to-RP2350 ratio at 150 MHz; calibrate it once against
+ * the "Refill" line of serial 'y' for the same workload. A workload whose
+ * worst block needs more than --budget percent of the period fails, and
+ * the exit status is 1, so the check can run before flashing.
+ *
+ * Build:
+ *   g++ -O2 -std=c++17 -I../.. audio_budget.cpp ../../Synth.cpp ../../Sfx.cpp ../../Tracker.cpp \
+ *       ../../SamplePlayer.cpp ../../Mixer.cpp -o audio_budget
+ *
+ * Usage:
+ *   audio_budget [--seconds S] [--rate HZ] [--slowdown X] [--budget PERCENT]
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "Adpcm.h"
+#include "AssetPack.h"
+#include "GameAudioScripts.h"
+#include "Mixer.h"
+#include "SamplePlayer.h"
+#include "Sfx.h"
+#include "Synth.h"
+#include "Tracker.h"
+#include "DemoSong.h"
+
+#define BLOCK 256
+#define PASSES 3       // each block's best pass is kept, so host preemption is not counted
+
+#define SCRIPT_COUNT (sizeof(SFX_SCRIPTS) / sizeof(SFX_SCRIPTS[0]))
+
+static bool render_channel(uint8_t channel, int16_t *buf, uint32_t frames) {
+  bool sound = synth_render_bus(buf, frames, channel);
+  if (!sound) memset(buf, 0, frames * sizeof(int16_t));
+  if (sample_player_mix(buf, frames, channel)) sound = true;
+  return sound;
+}
+
+// One refill, chunked on every script step and music tick like synth_source()
+static uint32_t sample_clock;
+
+static void refill(int16_t *out, uint32_t frames) {
+  for (uint32_t done = 0; done < frames;) {
+    uint32_t now = sample_clock + done;
+    uint32_t n = frames - done;
+    uint32_t step = sfx_service(now);
+    if (step < n) n = step;
+    step = tracker_service(now);
+    if (step < n) n = step;
+    mixer_mix(out + done, n, render_channel);
+    done += n;
+  }
+  sample_clock += frames;
+}
+
+enum Workload { IDLE, VOICES, SFX_STORM, MUSIC_SFX, CLIPS, WORKLOADS };
+
+static const char *const WORKLOAD_NAMES[WORKLOADS] = {
+  "idle", "8 voices", "sfx storm", "music + sfx", "music + 2 clips",
+};
+
+// A 16 kHz ADPCM clip, so the clip workload pays for decoding and resampling
+static std::vector<uint8_t> make_clip(uint32_t seconds) {
+  const uint32_t rate = 16000;
+  std::vector<int16_t> pcm(rate * seconds);
+  for (uint32_t i = 0; i < pcm.size(); i++) {
+    pcm[i] = (int16_t)(12000 * sinf(2 * (float)M_PI * 330 * i / rate) * (1.0f - (float)(i % rate) / rate));
+  }
+  std::vector<uint8_t> clip(adpcm_clip_bytes(pcm.size(), ADPCM_BLOCK_BYTES));
+  clip.resize(adpcm_encode_clip(pcm.data(), pcm.size(), clip.data(), ADPCM_BLOCK_BYTES));
+  return clip;
+}
+
+static void start_voices(uint32_t block_no) {
+  static const SynthWave WAVES[] = { WAVE_SINE, WAVE_SQUARE, WAVE_TRIANGLE, WAVE_SAW, WAVE_NOISE };
+  for (uint8_t i = 0; i < SYNTH_VOICES; i++) {
+    SynthNote n = {};
+    n.wave = WAVES[(i + block_no) % 5];
+    n.freq_hz = 220 + 110 * i;
+    n.end_freq_hz = (i & 1) ? n.freq_hz * 2 : 0;
+    n.gate_ms = 400;
+    n.volume = 32767 / SYNTH_VOICES;
+    n.env = SYNTH_ENV_SOFT;
+    n.bus = i % MIXER_CHANNELS;
+    synth_note_on(n);
+  }
+}
+
+static void setup(uint32_t rate) {
+  synth_init(rate);
+  sfx_init(SFX_SCRIPTS, SCRIPT_COUNT, rate);
+  tracker_init(rate, AUDIO_CH_MUSIC);
+  sample_player_init(rate);
+  mixer_init(rate);
+  mixer_set_duck(AUDIO_CH_MUSIC, DUCK_SOURCES, DUCK_DEPTH, DUCK_ATTACK_MS, DUCK_HOLD_MS, DUCK_RELEASE_MS);
+  mixer_set_master(MIXER_UNITY * 7 / 10, 0);
+  sample_clock = 0;
+}
+
+// Events due before block b of a workload
+static void drive(Workload w, uint32_t b, uint32_t rate, const std::vector<uint8_t> &clip) {
+  uint32_t per_second = rate / BLOCK;
+  switch (w) {
+    case IDLE:
+      break;
+    case VOICES:
+      if (b % (per_second / 2) == 0) {
+        synth_stop_all();
+        start_voices(b);
+      }
+      break;
+    case SFX_STORM:
+      sfx_trigger(b % SCRIPT_COUNT);
+      break;
+    case MUSIC_SFX:
+      if (b == 0) tracker_play(DEMO_SONG, sizeof(DEMO_SONG), true);
+      if (b % 8 == 0) sfx_trigger((b / 8) % SCRIPT_COUNT);
+      break;
+    case CLIPS:
+      if (b == 0) tracker_play(DEMO_SONG, sizeof(DEMO_SONG), true);
+      if (sample_player_active() < SAMPLE_VOICES) {
+        sample_player_start(clip.data(), clip.size(), ASSET_ADPCM, 16000, 24000,
+                            sample_player_active() ? AUDIO_CH_UI : AUDIO_CH_SFX);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+int main(int argc, char **argv) {
+  float seconds = 20.0f;
+  uint32_t rate = 24000;
+  double slowdown = 25.0;
+  double budget = 50.0;
+  for (int i = 1; i < argc; i++) {
+    bool has_val = i + 1 < argc;
+    if (!strcmp(argv[i], "--seconds") && has_val)       seconds = strtof(argv[++i], nullptr);
+    else if (!strcmp(argv[i], "--rate") && has_val)     rate = strtoul(argv[++i], nullptr, 10);
+    else if (!strcmp(argv[i], "--slowdown") && has_val) slowdown = strtod(argv[++i], nullptr);
+    else if (!strcmp(argv[i], "--budget") && has_val)   budget = strtod(argv[++i], nullptr);
+    else {
+      fprintf(stderr, "usage: %s [--seconds S] [--rate HZ] [--slowdown X] [--budget PERCENT]\n", argv[0]);
+      return 1;
+    }
+  }
+  if (rate < 8000 || seconds <= 0 || slowdown <= 0) {
+    fprintf(stderr, "bad rate, seconds or slowdown\n");
+    return 1;
+  }
+
+  std::vector<uint8_t> clip = make_clip(2);
+  uint32_t blocks = (uint32_t)(seconds * rate / BLOCK);
+  double period_us = 1e6 * BLOCK / rate;
+  bool over = false;
+
+  printf("block %u frames = %.2f ms at %u Hz, slowdown x%.1f, budget %.0f%%\n\n",
+         BLOCK, period_us / 1000, (unsigned)rate, slowdown, budget);
+  printf("workload           mean us  worst us   mean%%  worst%%\n");
+  for (int w = 0; w < WORKLOADS; w++) {
+    std::vector<double> best(blocks, 1e30);
+    for (int pass = 0; pass < PASSES; pass++) {
+      setup(rate);
+      int16_t out[BLOCK];
+      volatile int32_t sink = 0;
+      for (uint32_t b = 0; b < blocks; b++) {
+        drive((Workload)w, b, rate, clip);
+        auto t0 = std::chrono::steady_clock::now();
+        refill(out, BLOCK);
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        sink += out[BLOCK - 1];
+        if (ns < best[b]) best[b] = ns;
+      }
+    }
+    double total_ns = 0, worst_ns = 0;
+    for (double ns : best) {
+      total_ns += ns;
+      if (ns > worst_ns) worst_ns = ns;
+    }
+    double mean_us = total_ns / blocks / 1000 * slowdown;
+    double worst_us = worst_ns / 1000 * slowdown;
+    double worst_pct = worst_us * 100 / period_us;
+    bool fail = worst_pct > budget;
+    over |= fail;
+    printf("%-16s %9.1f %9.1f  %6.1f  %6.1f%s\n", WORKLOAD_NAMES[w], mean_us, worst_us,
+           mean_us * 100 / period_us, worst_pct, fail ? "  OVER" : "");
+  }
+  return over ? 1 : 0;
+}
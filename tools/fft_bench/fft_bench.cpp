@@ -0,0 +1,112 @@
+/*
+ * fft_bench.cpp - Host accuracy check and benchmark for Fft.cpp
+ *
+ * Transforms windowed test tones (and noise) at both lengths, compares
+ * every bin against a double-precision DFT of the same windowed input,
+ * and times the window + FFT + dB stages the spectrum screen runs per
+ * frame. Host timings only rank changes (the DSP SIMD path is ARM-only);
+ * the watch measures itself with the serial 'f' command.
+ *
+ * Build:
+ *   g++ -O2 -std=c++17 -I../.. fft_bench.cpp ../../Fft.cpp -o fft_bench
+ *
+ * Usage:
+ *   fft_bench [--iterations N]
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "Fft.h"
+
+static uint32_t lfsr = 0xACE1u;
+
+static int16_t noise() {
+  lfsr = lfsr * 1664525u + 1013904223u;
+  return (int16_t)(lfsr >> 16) / 4;
+}
+
+static void make_signal(int16_t *buf, uint16_t n, int kind) {
+  for (uint16_t i = 0; i < n; i++) {
+    double t = (double)i / n;
+    double v;
+    if (kind == 0)      v = 30000 * sin(2 * M_PI * 37 * t);                       // full scale, on a bin
+    else if (kind == 1) v = 3000 * sin(2 * M_PI * 61.3 * t) + 300 * sin(2 * M_PI * 100 * t);
+    else                v = noise();
+    buf[i] = (int16_t)lrint(v);
+  }
+}
+
+// Bins as fft_real() scales them: |X| of a full-scale on-bin sine is full scale
+static double check(uint16_t n, int kind, int *peak_bin) {
+  alignas(4) int16_t buf[FFT_MAX_POINTS];
+  make_signal(buf, n, kind);
+  fft_init(n);
+  fft_window(buf);
+  std::vector<double> x(buf, buf + n);
+  fft_real(buf);
+
+  double err = 0, ref_pow = 0, best = -1;
+  for (uint16_t k = 0; k < n / 2; k++) {
+    double re = 0, im = 0;
+    for (uint16_t i = 0; i < n; i++) {
+      re += x[i] * cos(2 * M_PI * k * i / n);
+      im -= x[i] * sin(2 * M_PI * k * i / n);
+    }
+    re *= 2.0 / n;
+    im *= 2.0 / n;
+    double gr = buf[2 * k], gi = k ? buf[2 * k + 1] : 0;
+    err += (gr - re) * (gr - re) + (gi - im) * (gi - im);
+    ref_pow += re * re + im * im;
+    if (re * re + im * im > best) {
+      best = re * re + im * im;
+      *peak_bin = k;
+    }
+  }
+  return 10 * log10(ref_pow / (err ? err : 1e-9));
+}
+
+int main(int argc, char **argv) {
+  uint32_t iterations = 20000;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--iterations") && i + 1 < argc) iterations = strtoul(argv[++i], nullptr, 10);
+    else {
+      fprintf(stderr, "usage: %s [--iterations N]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  static const char *KINDS[] = { "full-scale tone", "-20 dB tones", "noise" };
+  printf("points  signal            SNR dB  peak bin\n");
+  for (uint16_t n = 256; n <= FFT_MAX_POINTS; n *= 2) {
+    for (int kind = 0; kind < 3; kind++) {
+      int peak = -1;
+      double snr = check(n, kind, &peak);
+      printf("%6u  %-16s  %6.1f  %8d\n", n, KINDS[kind], snr, peak);
+    }
+  }
+
+  printf("\npoints  us/frame (window + fft + dB)\n");
+  for (uint16_t n = 256; n <= FFT_MAX_POINTS; n *= 2) {
+    alignas(4) int16_t src[FFT_MAX_POINTS], buf[FFT_MAX_POINTS];
+    uint8_t db[FFT_MAX_POINTS / 2];
+    make_signal(src, n, 1);
+    fft_init(n);
+    volatile uint32_t sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t it = 0; it < iterations; it++) {
+      memcpy(buf, src, n * sizeof(int16_t));
+      fft_window(buf);
+      fft_real(buf);
+      fft_magnitude_db(buf, db);
+      sink += db[it % (n / 2)];
+    }
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+    printf("%6u  %8.2f\n", n, us / iterations);
+  }
+  return 0;
+}
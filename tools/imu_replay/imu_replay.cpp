@@ -0,0 +1,163 @@
+/*
+ * imu_replay.cpp - Host replay of IMU traces through the tap detector
+ *
+ * Reads a serial capture containing an IMU trace dump (send 'r' to start
+ * and stop recording, then 'd' to dump), decodes it with the same codec
+ * as the recorder and runs the samples through TapDetector.cpp, so tap
+ * thresholds can be tuned and benchmarked offline.
+ *
+ * Build:
+ *   g++ -O2 -std=c++17 -I../.. imu_replay.cpp ../../TapDetector.cpp -o imu_replay
+ *
+ * Usage:
+ *   imu_replay trace.txt [--thresh F] [--lpf F] [--hpf F] [--debounce MS]
+ *                        [--sweep lo:hi:step] [--quiet]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "TapDetector.h"
+#include "ImuTrace.h"
+
+struct Sample {
+  uint32_t t_ms;
+  int16_t a[3];
+};
+
+static int hex_nibble(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  return -1;
+}
+
+static bool load_trace(const char *path, std::vector<Sample> &out, uint16_t &lsb_div) {
+  FILE *f = fopen(path, "r");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+
+  std::vector<uint8_t> blk;
+  char line[4096];
+  bool in_trace = false;
+  while (fgets(line, sizeof(line), f)) {
+    if (!strncmp(line, "#IMUTRACE", 9)) {
+      const char *p = strstr(line, "lsb=");
+      lsb_div = p ? (uint16_t)atoi(p + 4) : 4096;
+      out.clear();
+      in_trace = true;
+      continue;
+    }
+    if (!in_trace) continue;
+    if (!strncmp(line, "#END", 4)) break;
+    if (line[0] != 'B' || line[1] != ' ') continue;
+
+    char *p = line + 2;
+    unsigned count = strtoul(p, &p, 10);
+    while (*p == ' ') p++;
+    blk.clear();
+    while (hex_nibble(p[0]) >= 0 && hex_nibble(p[1]) >= 0) {
+      blk.push_back((uint8_t)(hex_nibble(p[0]) << 4 | hex_nibble(p[1])));
+      p += 2;
+    }
+    uint16_t got = imu_trace_decode_block(blk.data(), (uint16_t)blk.size(), (uint16_t)count,
+                                          [&](uint32_t t, const int16_t a[3]) {
+                                            out.push_back({t, {a[0], a[1], a[2]}});
+                                          });
+    if (got != count) {
+      fprintf(stderr, "warning: block decoded %u of %u samples\n", got, count);
+    }
+  }
+  fclose(f);
+
+  if (!in_trace) {
+    fprintf(stderr, "%s: no #IMUTRACE dump found\n", path);
+    return false;
+  }
+  return true;
+}
+
+static int run_detector(const std::vector<Sample> &trace, uint16_t lsb_div, const TapConfig &cfg, bool print) {
+  TapDetector td;
+  tap_detector_init(&td, &cfg);
+  int taps = 0;
+  for (const Sample &s : trace) {
+    if (tap_detector_feed(&td, s.a, lsb_div, s.t_ms)) {
+      taps++;
+      if (print) printf("tap  t=%lu ms  mag=%.3f\n", (unsigned long)s.t_ms, td.last_mag);
+    }
+  }
+  return taps;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s trace.txt [--thresh F] [--lpf F] [--hpf F] [--debounce MS] [--sweep lo:hi:step] [--quiet]\n", argv[0]);
+    return 2;
+  }
+
+  // Defaults match the firmware (Pico1.8.ino)
+  TapConfig cfg = { 0.05f, 0.95f, 2.5f, 400 };
+  bool sweep = false, quiet = false;
+  float sweep_lo = 0, sweep_hi = 0, sweep_step = 0;
+
+  for (int i = 2; i < argc; i++) {
+    bool has_val = i + 1 < argc;
+    if (!strcmp(argv[i], "--thresh") && has_val)        cfg.thresh = strtof(argv[++i], nullptr);
+    else if (!strcmp(argv[i], "--lpf") && has_val)      cfg.lpf_alpha = strtof(argv[++i], nullptr);
+    else if (!strcmp(argv[i], "--hpf") && has_val)      cfg.hpf_alpha = strtof(argv[++i], nullptr);
+    else if (!strcmp(argv[i], "--debounce") && has_val) cfg.debounce_ms = strtoul(argv[++i], nullptr, 10);
+    else if (!strcmp(argv[i], "--sweep") && has_val) {
+      if (sscanf(argv[++i], "%f:%f:%f", &sweep_lo, &sweep_hi, &sweep_step) != 3 || sweep_step <= 0) {
+        fprintf(stderr, "bad --sweep, expected lo:hi:step\n");
+        return 2;
+      }
+      sweep = true;
+    }
+    else if (!strcmp(argv[i], "--quiet")) quiet = true;
+    else {
+      fprintf(stderr, "unknown argument %s\n", argv[i]);
+      return 2;
+    }
+  }
+
+  std::vector<Sample> trace;
+  uint16_t lsb_div = 4096;
+  if (!load_trace(argv[1], trace, lsb_div)) return 1;
+  if (trace.empty()) {
+    fprintf(stderr, "trace is empty\n");
+    return 1;
+  }
+
+  uint32_t span = trace.back().t_ms - trace.front().t_ms;
+  printf("samples=%zu span=%.1f s lsb=%u\n", trace.size(), span / 1000.0, lsb_div);
+  printf("lpf=%.4f hpf=%.4f thresh=%.3f debounce=%lu ms\n",
+         cfg.lpf_alpha, cfg.hpf_alpha, cfg.thresh, (unsigned long)cfg.debounce_ms);
+
+  if (sweep) {
+    for (float th = sweep_lo; th <= sweep_hi + sweep_step * 0.5f; th += sweep_step) {
+      TapConfig c = cfg;
+      c.thresh = th;
+      printf("thresh=%.3f taps=%d\n", th, run_detector(trace, lsb_div, c, false));
+    }
+  } else {
+    int taps = run_detector(trace, lsb_div, cfg, !quiet);
+    printf("taps=%d\n", taps);
+  }
+
+  // Benchmark the detector over the whole trace
+  const int reps = 200;
+  auto t0 = std::chrono::steady_clock::now();
+  volatile int sink = 0;
+  for (int r = 0; r < reps; r++) sink += run_detector(trace, lsb_div, cfg, false);
+  auto t1 = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+  printf("detector: %.1f ns/sample (host)\n", ns / ((double)reps * trace.size()));
+  return 0;
+}
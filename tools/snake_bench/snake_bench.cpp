@@ -0,0 +1,232 @@
+/*
+ * snake_bench.cpp - Headless full-board Snake run and benchmark for SnakeEngine.cpp
+ *
+ * Steers SnakeEngine.cpp round a Hamiltonian cycle of the 20 x 30 board,
+ * which eats every food without ever dying, until the snake fills all
+ * 600 cells. Every move checks the bitmap and the move ring against each
+ * other. The same run is then played by the x[]/y[] arrays the game used
+ * before (shift the whole body each move, linear-scan collisions, retry
+ * random cells until one is free), kept below as the reference, and both
+ * are timed per move and per food placement as the snake grows. Host
+ * timings only rank the two; the ratio is what carries over to the watch.
+ *
+ * Build:
+ *   g++ -O2 -std=c++17 -I../.. snake_bench.cpp ../../SnakeEngine.cpp -o snake_bench
+ *
+ * Usage:
+ *   snake_bench [--seed S]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "SnakeEngine.h"
+
+#define BUCKETS      4                       // length ranges reported
+#define START_LENGTH 4
+
+static uint32_t rng_state = 1;
+
+static uint32_t rnd(uint32_t n) {
+  rng_state = rng_state * 1664525u + 1013904223u;
+  return (rng_state >> 8) % n;
+}
+
+static double now_ns() {
+  return std::chrono::duration<double, std::nano>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Next move on the cycle: along row 0 to the right edge, then boustrophedon
+// rows over columns 1..W-1, and back up column 0
+static uint8_t cycle_dir(int x, int y) {
+  if (x == 0) return y == 0 ? SNAKE_RIGHT : SNAKE_UP;
+  if (y % 2 == 0) return x < SNAKE_W - 1 ? SNAKE_RIGHT : SNAKE_DOWN;
+  if (x > 1) return SNAKE_LEFT;
+  return y == SNAKE_H - 1 ? SNAKE_LEFT : SNAKE_DOWN;
+}
+
+// ---------- Reference: the previous x[]/y[] snake ----------
+
+namespace Legacy {
+
+static uint8_t x[SNAKE_CELLS], y[SNAKE_CELLS];    // [0] is the head
+static uint16_t length;
+static uint8_t dir;
+static int food_x, food_y;
+
+static bool collides(int cx, int cy) {
+  if (cx < 0 || cx >= SNAKE_W || cy < 0 || cy >= SNAKE_H) return true;
+  for (int i = 0; i < length; i++) {
+    if (x[i] == cx && y[i] == cy) return true;
+  }
+  return false;
+}
+
+static void reset() {
+  length = START_LENGTH;
+  dir = SNAKE_RIGHT;
+  for (int i = 0; i < length; i++) {
+    x[i] = START_LENGTH - i;
+    y[i] = 0;
+  }
+}
+
+static bool place_food() {
+  if (length >= SNAKE_CELLS) return false;
+  do {
+    food_x = rnd(SNAKE_W);
+    food_y = rnd(SNAKE_H);
+  } while (collides(food_x, food_y));
+  return true;
+}
+
+static const int DX[4] = { 1, 0, -1, 0 };
+static const int DY[4] = { 0, 1, 0, -1 };
+
+static SnakeResult step() {
+  int nx = x[0] + DX[dir], ny = y[0] + DY[dir];
+  bool ate = nx == food_x && ny == food_y;
+  // The old game tested the whole body, tail included; the cycle never
+  // reaches the tail before the board is full, so the runs agree
+  if (collides(nx, ny)) return SNAKE_DIED;
+  if (ate) length++;
+  for (int i = length - 1; i > 0; i--) {
+    x[i] = x[i - 1];
+    y[i] = y[i - 1];
+  }
+  x[0] = nx;
+  y[0] = ny;
+  return ate ? SNAKE_ATE : SNAKE_MOVED;
+}
+
+}  // namespace Legacy
+
+// ---------- Checks ----------
+
+// The bitmap holds exactly the cells the move ring walks from tail to head
+static bool consistent(const SnakeBoard &b) {
+  uint32_t seen[SNAKE_WORDS] = {};
+  uint16_t cell = b.tail;
+  static const int8_t DX[4] = { 1, 0, -1, 0 };
+  static const int8_t DY[4] = { 0, 1, 0, -1 };
+  for (uint16_t i = 0; i < b.length; i++) {
+    if ((seen[cell >> 5] >> (cell & 31)) & 1) return false;
+    seen[cell >> 5] |= 1u << (cell & 31);
+    if (i == b.length - 1) break;
+    uint16_t ring = (b.first_move + i) % SNAKE_CELLS;
+    uint8_t d = (b.moves[ring >> 2] >> ((ring & 3) * 2)) & 3;
+    cell += DY[d] * SNAKE_W + DX[d];
+  }
+  return cell == b.head && !memcmp(seen, b.occupied, sizeof(seen));
+}
+
+// ---------- Runs ----------
+
+struct Bucket {
+  uint32_t moves, foods;
+  double move_ns, food_ns;
+};
+
+static int bucket_of(uint16_t length) {
+  int i = (length - START_LENGTH) * BUCKETS / (SNAKE_CELLS - START_LENGTH + 1);
+  return i < BUCKETS ? i : BUCKETS - 1;
+}
+
+// Full-board run on the engine; false if it died or an invariant broke
+static bool run_engine(Bucket *out, uint32_t *moves_total) {
+  SnakeBoard b;
+  snake_reset(&b, START_LENGTH, 0, START_LENGTH, SNAKE_RIGHT);
+  snake_place_food(&b, rnd(snake_free_cells(&b)));
+  uint32_t moves = 0;
+  while (b.food != SNAKE_NO_FOOD) {
+    b.dir = cycle_dir(b.head % SNAKE_W, b.head / SNAKE_W);
+    Bucket &k = out[bucket_of(b.length)];
+    double t0 = now_ns();
+    SnakeResult r = snake_step(&b);
+    double t1 = now_ns();
+    k.move_ns += t1 - t0;
+    k.moves++;
+    moves++;
+    if (r == SNAKE_DIED) {
+      fprintf(stderr, "engine: died at length %u after %u moves\n", b.length, moves);
+      return false;
+    }
+    if (r == SNAKE_ATE) {
+      double t2 = now_ns();
+      if (snake_free_cells(&b)) snake_place_food(&b, rnd(snake_free_cells(&b)));
+      k.food_ns += now_ns() - t2;
+      k.foods++;
+      if (!consistent(b)) {
+        fprintf(stderr, "engine: bitmap and ring disagree at length %u\n", b.length);
+        return false;
+      }
+    }
+  }
+  *moves_total = moves;
+  return b.length == SNAKE_CELLS && consistent(b);
+}
+
+static bool run_legacy(Bucket *out, uint32_t *moves_total) {
+  Legacy::reset();
+  Legacy::place_food();
+  uint32_t moves = 0;
+  for (;;) {
+    Legacy::dir = cycle_dir(Legacy::x[0], Legacy::y[0]);
+    Bucket &k = out[bucket_of(Legacy::length)];
+    double t0 = now_ns();
+    SnakeResult r = Legacy::step();
+    double t1 = now_ns();
+    k.move_ns += t1 - t0;
+    k.moves++;
+    moves++;
+    if (r == SNAKE_DIED) {
+      fprintf(stderr, "legacy: died at length %u after %u moves\n", Legacy::length, moves);
+      return false;
+    }
+    if (r == SNAKE_ATE) {
+      double t2 = now_ns();
+      bool more = Legacy::place_food();
+      k.food_ns += now_ns() - t2;
+      k.foods++;
+      if (!more) break;
+    }
+  }
+  *moves_total = moves;
+  return true;
+}
+
+int main(int argc, char **argv) {
+  uint32_t seed = 1;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = strtoul(argv[++i], nullptr, 10);
+    else {
+      fprintf(stderr, "usage: %s [--seed S]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  Bucket e[BUCKETS] = {}, l[BUCKETS] = {};
+  uint32_t e_moves = 0, l_moves = 0;
+  rng_state = seed ? seed : 1;
+  if (!run_engine(e, &e_moves)) return 1;
+  rng_state = seed ? seed : 1;
+  if (!run_legacy(l, &l_moves)) return 1;
+
+  printf("Full board (seed %u): %u cells filled in %u moves, bitmap and ring checked at every food\n",
+         seed, SNAKE_CELLS, e_moves);
+  printf("Reference run: %u moves\n", l_moves);
+  printf("\nLength         move: ring+bitmap  x[]/y[] arrays    food: rank select  retry+scan\n");
+  for (int i = 0; i < BUCKETS; i++) {
+    int lo = START_LENGTH + i * (SNAKE_CELLS - START_LENGTH + 1) / BUCKETS;
+    int hi = START_LENGTH + (i + 1) * (SNAKE_CELLS - START_LENGTH + 1) / BUCKETS - 1;
+    printf("  %3d-%-3d          %8.1f ns  %10.1f ns          %8.1f ns  %10.1f ns\n", lo, hi,
+           e[i].move_ns / e[i].moves, l[i].move_ns / l[i].moves,
+           e[i].food_ns / e[i].foods, l[i].food_ns / l[i].foods);
+  }
+  printf("\nState: SnakeBoard %zu bytes, x[]/y[] arrays for a full board %zu bytes\n",
+         sizeof(SnakeBoard), sizeof(Legacy::x) + sizeof(Legacy::y));
+  return 0;
+}
@@ -0,0 +1,100 @@
+/*
+ * synth_bench.cpp - Host benchmark and preview for Synth.cpp
+ *
+ * Renders the same 256-frame blocks the DMA engine asks for with 1..8
+ * voices busy and reports the cost per output sample, and can write the
+ * result to a WAV file to audition envelopes and slides. Host timings
+ * only rank changes; the watch reports its own cycles per sample on the
+ * serial 'y' command (GameAudio measures around every synth_render()).
+ *
+ * Build:
+ *   g++ -O2 -std=c++17 -I../.. synth_bench.cpp ../../Synth.cpp -o synth_bench
+ *
+ * Usage:
+ *   synth_bench [--seconds S] [--rate HZ] [--wav out.wav]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "Synth.h"
+
+#define BLOCK 256
+
+static void start_voices(uint8_t count, uint32_t block_no) {
+  static const SynthWave WAVES[] = { WAVE_SINE, WAVE_SQUARE, WAVE_TRIANGLE, WAVE_SAW, WAVE_NOISE };
+  for (uint8_t i = 0; i < count; i++) {
+    SynthNote n = {};
+    n.wave = WAVES[(i + block_no) % 5];
+    n.freq_hz = 220 + 110 * i;
+    n.end_freq_hz = (i & 1) ? n.freq_hz * 2 : 0;
+    n.gate_ms = 400;
+    n.volume = 32767 / 8;
+    n.env = SYNTH_ENV_SOFT;
+    synth_note_on(n);
+  }
+}
+
+static bool write_wav(const char *path, const std::vector<int16_t> &pcm, uint32_t rate) {
+  FILE *f = fopen(path, "wb");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  uint32_t data = pcm.size() * 2, riff = 36 + data, fmt_len = 16, byte_rate = rate * 2;
+  uint16_t pcm_fmt = 1, channels = 1, align = 2, bits = 16;
+  fwrite("RIFF", 1, 4, f); fwrite(&riff, 4, 1, f); fwrite("WAVE", 1, 4, f);
+  fwrite("fmt ", 1, 4, f); fwrite(&fmt_len, 4, 1, f);
+  fwrite(&pcm_fmt, 2, 1, f); fwrite(&channels, 2, 1, f); fwrite(&rate, 4, 1, f);
+  fwrite(&byte_rate, 4, 1, f); fwrite(&align, 2, 1, f); fwrite(&bits, 2, 1, f);
+  fwrite("data", 1, 4, f); fwrite(&data, 4, 1, f);
+  fwrite(pcm.data(), 2, pcm.size(), f);
+  fclose(f);
+  return true;
+}
+
+int main(int argc, char **argv) {
+  float seconds = 10.0f;
+  uint32_t rate = 24000;
+  const char *wav = nullptr;
+  for (int i = 1; i < argc; i++) {
+    bool has_val = i + 1 < argc;
+    if (!strcmp(argv[i], "--seconds") && has_val)   seconds = strtof(argv[++i], nullptr);
+    else if (!strcmp(argv[i], "--rate") && has_val) rate = strtoul(argv[++i], nullptr, 10);
+    else if (!strcmp(argv[i], "--wav") && has_val)  wav = argv[++i];
+    else {
+      fprintf(stderr, "usage: %s [--seconds S] [--rate HZ] [--wav out.wav]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  uint32_t blocks = (uint32_t)(seconds * rate / BLOCK);
+  uint32_t retrigger = rate / 2 / BLOCK;           // new notes every ~0.5 s
+  std::vector<int16_t> preview;
+
+  printf("voices  ns/sample  realtime%%\n");
+  for (uint8_t voices = 1; voices <= SYNTH_VOICES; voices++) {
+    synth_init(rate);
+    int16_t out[BLOCK];
+    volatile int32_t sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t b = 0; b < blocks; b++) {
+      if (b % retrigger == 0) {
+        synth_stop_all();
+        start_voices(voices, b / retrigger);
+      }
+      if (!synth_render(out, BLOCK)) memset(out, 0, sizeof(out));
+      sink += out[BLOCK - 1];
+      if (wav && voices == SYNTH_VOICES) preview.insert(preview.end(), out, out + BLOCK);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+    double per_sample = ns / ((double)blocks * BLOCK);
+    printf("%6u  %9.1f  %9.3f\n", voices, per_sample, per_sample * rate / 1e7);
+  }
+
+  if (wav && !write_wav(wav, preview, rate)) return 1;
+  return 0;
+}
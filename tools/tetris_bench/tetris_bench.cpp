@@ -0,0 +1,357 @@
+/*
+ * tetris_bench.cpp - Headless Tetris AI and benchmark for TetrisEngine.cpp
+ *
+ * Plays TetrisEngine.cpp with a one-piece placement AI (every rotation and
+ * column dropped straight down, scored on Dellacherie's features) and
+ * reports how it did. Then, on boards snapshotted from that game, times
+ * the per-move operations (collision tests, rotations, lock + line clear)
+ * against the int[20][10] / 4x4-matrix code the game used before, which
+ * is kept below as the reference. Host timings only rank the two; the
+ * ratio is what carries over to the watch.
+ *
+ * Build:
+ *   g++ -O2 -std=c++17 -I../.. tetris_bench.cpp ../../TetrisEngine.cpp -o tetris_bench
+ *
+ * Usage:
+ *   tetris_bench [--pieces N] [--seed S]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "TetrisEngine.h"
+
+static uint32_t rng_state = 1;
+
+static uint32_t rnd(uint32_t n) {
+  rng_state = rng_state * 1664525u + 1013904223u;
+  return (rng_state >> 8) % n;
+}
+
+static double now_us() {
+  return std::chrono::duration<double, std::micro>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ---------- Placement AI ----------
+
+// Pierre Dellacherie's features with the El-Tetris weights, higher is
+// better. b is the well after locking the piece whose box was at
+// (x, land_y) in rotation rot, eroded the piece cells its clears removed.
+static double evaluate(const TetrisBoard &b, uint8_t piece, uint8_t rot, int land_y,
+                       uint8_t lines, int eroded) {
+  int top = 3, bottom = 0;
+  for (int r = 0; r < 4; r++) {
+    if (!tetris_piece_row(piece, rot, r)) continue;
+    if (r < top) top = r;
+    bottom = r;
+  }
+  double landing = TETRIS_H - land_y - (top + bottom) / 2.0;
+
+  int row_trans = 0, col_trans = 0, holes = 0, wells = 0;
+  uint16_t seen = 0;
+  uint8_t depth[TETRIS_W] = {};
+  for (int y = 0; y < TETRIS_H; y++) {
+    uint16_t row = b.rows[y];
+    uint32_t walled = ((uint32_t)row << 1) | 1 | (1u << (TETRIS_W + 1));
+    row_trans += __builtin_popcount((walled ^ (walled >> 1)) & ((1u << (TETRIS_W + 1)) - 1));
+    uint16_t below = y + 1 < TETRIS_H ? b.rows[y + 1] : TETRIS_FULL_ROW;
+    col_trans += __builtin_popcount((row ^ below) & TETRIS_FULL_ROW);
+    holes += __builtin_popcount(~row & seen & TETRIS_FULL_ROW);
+    seen |= row;
+
+    // Open cells with both neighbours filled (walls count), deeper cells
+    // of a well weigh more
+    uint16_t left = (row << 1) | 1;
+    uint16_t right = (row >> 1) | (1u << (TETRIS_W - 1));
+    uint16_t well = ~row & left & right & TETRIS_FULL_ROW;
+    for (int c = 0; c < TETRIS_W; c++) {
+      if ((well >> c) & 1) wells += ++depth[c];
+      else depth[c] = 0;
+    }
+  }
+  return -4.500158825082766 * landing + 3.4181268101392694 * (lines * eroded)
+         - 3.2178882868487753 * row_trans - 9.348695305445199 * col_trans
+         - 7.899265427351652 * holes - 3.3855972247263626 * wells;
+}
+
+// Piece cells in rows the piece completes, before they are cleared
+static int eroded_cells(const TetrisBoard &b) {
+  int cells = 0;
+  for (int r = 0; r < 4; r++) {
+    int row = b.y + r;
+    uint8_t bits = tetris_piece_row(b.piece, b.rot, r);
+    if (!bits || row < 0 || row >= TETRIS_H) continue;
+    uint16_t mask = (uint16_t)(((uint32_t)bits << (b.x + 4)) >> 4);
+    if ((b.rows[row] | mask) == TETRIS_FULL_ROW) cells += __builtin_popcount(bits);
+  }
+  return cells;
+}
+
+// Drop the spawned piece at the best rotation/column; false if it topped out
+static bool place_best(TetrisBoard &b, uint32_t *evaluated) {
+  double best = -1e30;
+  int best_rot = -1, best_x = 0;
+  for (int rot = 0; rot < (b.piece == TETRIS_O ? 1 : 4); rot++) {
+    for (int x = -3; x < TETRIS_W; x++) {
+      if (!tetris_fits(&b, b.piece, rot, x, 0)) continue;
+      TetrisBoard t = b;
+      t.rot = rot;
+      t.x = x;
+      t.y += tetris_drop_distance(&t);
+      int land_y = t.y;
+      int eroded = eroded_cells(t);
+      uint8_t lines = tetris_lock(&t);
+      double score = evaluate(t, b.piece, rot, land_y, lines, eroded);
+      (*evaluated)++;
+      if (score > best) {
+        best = score;
+        best_rot = rot;
+        best_x = x;
+      }
+    }
+  }
+  if (best_rot < 0) return false;
+  b.rot = best_rot;
+  b.x = best_x;
+  b.y += tetris_drop_distance(&b);
+  return true;
+}
+
+// ---------- Reference: the int-matrix code this engine replaced ----------
+
+#define GRID_W TETRIS_W
+#define GRID_H TETRIS_H
+
+static const int LEGACY_PIECES[7][4][4] = {
+  {{0,1,0,0},{0,1,0,0},{0,1,0,0},{0,1,0,0}},
+  {{1,1,0,0},{1,1,0,0},{0,0,0,0},{0,0,0,0}},
+  {{0,1,1,0},{1,1,0,0},{0,0,0,0},{0,0,0,0}},
+  {{1,1,0,0},{0,1,1,0},{0,0,0,0},{0,0,0,0}},
+  {{1,1,1,0},{0,1,0,0},{0,0,0,0},{0,0,0,0}},
+  {{1,0,0,0},{1,0,0,0},{1,1,0,0},{0,0,0,0}},
+  {{0,1,0,0},{0,1,0,0},{1,1,0,0},{0,0,0,0}},
+};
+
+struct Legacy {
+  int grid[GRID_H][GRID_W];
+  int piece[4][4];
+  int type, x, y;
+};
+
+static bool legacy_can_place(const Legacy &g, int px, int py, const int piece[4][4]) {
+  for (int y = 0; y < 4; y++) {
+    for (int x = 0; x < 4; x++) {
+      if (piece[y][x]) {
+        int nx = px + x;
+        int ny = py + y;
+        if (nx < 0 || nx >= GRID_W || ny >= GRID_H) return false;
+        if (ny >= 0 && g.grid[ny][nx]) return false;
+      }
+    }
+  }
+  return true;
+}
+
+static void legacy_rotate(Legacy &g) {
+  int temp[4][4];
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) temp[i][j] = g.piece[3 - j][i];
+  }
+  if (legacy_can_place(g, g.x, g.y, temp)) {
+    memcpy(g.piece, temp, sizeof(temp));
+    return;
+  }
+  int kick_offsets[][2] = {{-1, 0}, {1, 0}, {-2, 0}, {2, 0}, {0, -1}};
+  for (int i = 0; i < 5; i++) {
+    int nx = g.x + kick_offsets[i][0];
+    int ny = g.y + kick_offsets[i][1];
+    if (legacy_can_place(g, nx, ny, temp)) {
+      g.x = nx;
+      g.y = ny;
+      memcpy(g.piece, temp, sizeof(temp));
+      return;
+    }
+  }
+}
+
+static int legacy_lock(Legacy &g) {
+  for (int y = 0; y < 4; y++) {
+    for (int x = 0; x < 4; x++) {
+      if (!g.piece[y][x]) continue;
+      int nx = g.x + x, ny = g.y + y;
+      if (ny >= 0 && ny < GRID_H && nx >= 0 && nx < GRID_W) g.grid[ny][nx] = g.type + 1;
+    }
+  }
+  int lines = 0;
+  for (int y = GRID_H - 1; y >= 0; y--) {
+    bool full = true;
+    for (int x = 0; x < GRID_W; x++) {
+      if (!g.grid[y][x]) {
+        full = false;
+        break;
+      }
+    }
+    if (full) {
+      lines++;
+      for (int move_y = y; move_y > 0; move_y--) {
+        for (int x = 0; x < GRID_W; x++) g.grid[move_y][x] = g.grid[move_y - 1][x];
+      }
+      for (int x = 0; x < GRID_W; x++) g.grid[0][x] = 0;
+      y++;
+    }
+  }
+  return lines;
+}
+
+static void to_legacy(const TetrisBoard &b, Legacy &g) {
+  for (int y = 0; y < GRID_H; y++) {
+    for (int x = 0; x < GRID_W; x++) g.grid[y][x] = tetris_cell(&b, x, y);
+  }
+  g.type = b.piece;
+  memcpy(g.piece, LEGACY_PIECES[b.piece], sizeof(g.piece));
+  g.x = b.x;
+  g.y = b.y;
+}
+
+// ---------- Timing ----------
+
+struct OpTimes {
+  double fits_ns, rotate_ns, lock_ns;
+};
+
+// Every operation runs over all snapshots, REPEAT times, fastest pass kept
+#define REPEAT 5
+
+static OpTimes time_engine(const std::vector<TetrisBoard> &boards) {
+  OpTimes best = {1e30, 1e30, 1e30};
+  volatile uint32_t sink = 0;
+  size_t fits = 0, rotates = 0, locks = 0;
+  for (int pass = 0; pass < REPEAT; pass++) {
+    fits = rotates = locks = 0;
+    double t0 = now_us();
+    for (const TetrisBoard &b : boards) {
+      for (int x = -2; x < TETRIS_W; x++) {
+        for (int y = 0; y < TETRIS_H; y += 2) {
+          sink += tetris_fits(&b, b.piece, b.rot, x, y);
+          fits++;
+        }
+      }
+    }
+    double t1 = now_us();
+    for (const TetrisBoard &b : boards) {
+      TetrisBoard t = b;
+      for (int i = 0; i < 4; i++) sink += tetris_rotate(&t, 1);
+      rotates += 4;
+    }
+    double t2 = now_us();
+    for (const TetrisBoard &b : boards) {
+      TetrisBoard t = b;
+      t.y += tetris_drop_distance(&t);
+      sink += tetris_lock(&t);
+      locks++;
+    }
+    double t3 = now_us();
+    OpTimes o = { (t1 - t0) * 1000 / fits, (t2 - t1) * 1000 / rotates, (t3 - t2) * 1000 / locks };
+    if (o.fits_ns < best.fits_ns) best.fits_ns = o.fits_ns;
+    if (o.rotate_ns < best.rotate_ns) best.rotate_ns = o.rotate_ns;
+    if (o.lock_ns < best.lock_ns) best.lock_ns = o.lock_ns;
+  }
+  return best;
+}
+
+static OpTimes time_legacy(const std::vector<TetrisBoard> &boards) {
+  std::vector<Legacy> games(boards.size());
+  for (size_t i = 0; i < boards.size(); i++) to_legacy(boards[i], games[i]);
+
+  OpTimes best = {1e30, 1e30, 1e30};
+  volatile uint32_t sink = 0;
+  size_t fits = 0, rotates = 0, locks = 0;
+  for (int pass = 0; pass < REPEAT; pass++) {
+    fits = rotates = locks = 0;
+    double t0 = now_us();
+    for (const Legacy &g : games) {
+      for (int x = -2; x < GRID_W; x++) {
+        for (int y = 0; y < GRID_H; y += 2) {
+          sink += legacy_can_place(g, x, y, g.piece);
+          fits++;
+        }
+      }
+    }
+    double t1 = now_us();
+    for (const Legacy &g : games) {
+      Legacy t = g;
+      for (int i = 0; i < 4; i++) legacy_rotate(t);
+      sink += t.x;
+      rotates += 4;
+    }
+    double t2 = now_us();
+    for (const Legacy &g : games) {
+      Legacy t = g;
+      while (legacy_can_place(t, t.x, t.y + 1, t.piece)) t.y++;
+      sink += legacy_lock(t);
+      locks++;
+    }
+    double t3 = now_us();
+    OpTimes o = { (t1 - t0) * 1000 / fits, (t2 - t1) * 1000 / rotates, (t3 - t2) * 1000 / locks };
+    if (o.fits_ns < best.fits_ns) best.fits_ns = o.fits_ns;
+    if (o.rotate_ns < best.rotate_ns) best.rotate_ns = o.rotate_ns;
+    if (o.lock_ns < best.lock_ns) best.lock_ns = o.lock_ns;
+  }
+  return best;
+}
+
+int main(int argc, char **argv) {
+  uint32_t pieces = 10000;
+  uint32_t seed = 1;
+  for (int i = 1; i < argc; i++) {
+    bool has_val = i + 1 < argc;
+    if (!strcmp(argv[i], "--pieces") && has_val)     pieces = strtoul(argv[++i], nullptr, 10);
+    else if (!strcmp(argv[i], "--seed") && has_val)  seed = strtoul(argv[++i], nullptr, 10);
+    else {
+      fprintf(stderr, "usage: %s [--pieces N] [--seed S]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (!pieces) {
+    fprintf(stderr, "bad piece count\n");
+    return 2;
+  }
+  rng_state = seed ? seed : 1;
+
+  // The game: AI placements, snapshotting each board at spawn
+  TetrisBoard b;
+  tetris_reset(&b);
+  std::vector<TetrisBoard> boards;
+  boards.reserve(pieces);
+  uint32_t placed = 0, lines = 0, evaluated = 0, tetrises = 0;
+  double t0 = now_us();
+  while (placed < pieces) {
+    if (!tetris_spawn(&b, rnd(TETRIS_PIECES))) break;
+    boards.push_back(b);
+    if (!place_best(b, &evaluated)) break;
+    uint8_t n = tetris_lock(&b);
+    lines += n;
+    tetrises += n == 4;
+    placed++;
+  }
+  double game_us = now_us() - t0;
+
+  printf("AI game (seed %u): %u pieces, %u lines (%u tetrises)%s\n", seed, placed, lines, tetrises,
+         placed < pieces ? ", topped out" : "");
+  printf("  %u placements evaluated, %.2f us per piece, %.0f ns per placement\n",
+         evaluated, game_us / (placed ? placed : 1), game_us * 1000 / (evaluated ? evaluated : 1));
+
+  OpTimes e = time_engine(boards);
+  OpTimes l = time_legacy(boards);
+  printf("\nPer operation over %zu boards     bitboard    int matrix   speedup\n", boards.size());
+  printf("  collision test                %8.1f ns  %8.1f ns   %5.1fx\n", e.fits_ns, l.fits_ns, l.fits_ns / e.fits_ns);
+  printf("  rotate (with kicks)           %8.1f ns  %8.1f ns   %5.1fx\n", e.rotate_ns, l.rotate_ns, l.rotate_ns / e.rotate_ns);
+  printf("  drop + lock + line clear      %8.1f ns  %8.1f ns   %5.1fx\n", e.lock_ns, l.lock_ns, l.lock_ns / e.lock_ns);
+  printf("\nState: TetrisBoard %zu bytes, int grid + piece %zu bytes\n",
+         sizeof(TetrisBoard), sizeof(Legacy::grid) + sizeof(Legacy::piece));
+  return 0;
+}
@@ -0,0 +1,627 @@
+/*
+ * tracker_convert.cpp - Host converter and preview for Tracker.cpp songs
+ *
+ * Builds the song format of Tracker.h from a text score or a 4-channel
+ * ProTracker .mod, checks it with the player's own validator, plays it
+ * through Tracker.cpp and Synth.cpp exactly as the watch would and reports
+ * its size, length and cost. Identical patterns are stored once.
+ *
+ * Text scores (';' starts a comment):
+ *
+ *   title   Night Drive
+ *   tempo   125                     BPM, default 125
+ *   speed   6                       ticks per row, default 6
+ *   rows    32                      rows per pattern, default 64
+ *   channels 4
+ *   instrument 1 square vol=40 a=2 d=120 s=96 r=60
+ *   pattern 0
+ *   C-4 01 .. ... | --- .. .. ... | E-3 02 48 401 | ...
+ *   order   0 0 1 2                 may be repeated, appends
+ *   restart 1
+ *
+ * Each row line has one cell per channel separated by '|'; a cell is
+ * note (C-4, C#4, === or OFF for key off, --- for none), instrument (hex),
+ * volume (decimal 00-64) and effect (three hex digits, see Tracker.h),
+ * with '.' for empty fields and trailing fields optional. Short patterns
+ * are padded with empty rows. Waves: sine square triangle saw noise.
+ *
+ * A .mod keeps its notes and effects (slides rescaled to 1/16 semitones);
+ * samples become wavetable instruments picked from their names (sine,
+ * square, tri, saw, noise/drum/hat/snare/kick, default square), or per
+ * sample with --wave N=name. Looped samples sustain, others decay over the
+ * sample's length. Effects the player lacks are reported and dropped.
+ *
+ * Build:
+ *   g++ -O2 -std=c++17 -I../.. tracker_convert.cpp ../../Tracker.cpp ../../Synth.cpp -o tracker_convert
+ *
+ * Usage:
+ *   tracker_convert in.txt|in.mod out.trk [--header out.h --name SYMBOL] [--wav preview.wav]
+ *                   [--wave N=name]... [--rate HZ]
+ */
+
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+#include <strings.h>
+
+#include "Tracker.h"
+#include "Synth.h"
+
+#define BLOCK       256
+#define MAX_SECONDS 1200           // preview cut-off for songs that never end
+
+struct Cell {
+  uint8_t note = 0;                // 1-96, TRACKER_NOTE_OFF, 0 = none
+  uint8_t inst = 0;
+  int     volume = -1;
+  int     fx = -1;
+  uint8_t param = 0;
+};
+
+struct Instrument {
+  uint8_t  wave = WAVE_SQUARE;
+  uint8_t  volume = 64;
+  uint8_t  sustain = 255;
+  uint16_t attack_ms = 2, decay_ms = 0, release_ms = 40;
+  bool     defined = false;
+};
+
+typedef std::vector<std::vector<Cell>> Pattern;   // [row][channel]
+
+struct Song {
+  std::string title;
+  uint8_t channels = 4, speed = 6, tempo = 125, restart = 0, rows = 64;
+  std::vector<Instrument> instruments;            // [0] is instrument 1
+  std::map<int, Pattern> patterns;
+  std::vector<int> orders;
+};
+
+static const char *WAVE_NAMES[] = { "sine", "square", "triangle", "saw", "noise" };
+
+static int wave_by_name(const char *s) {
+  for (int w = 0; w <= WAVE_NOISE; w++) {
+    if (!strcmp(s, WAVE_NAMES[w])) return w;
+  }
+  return -1;
+}
+
+static bool read_file(const char *path, std::vector<uint8_t> &out) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.insert(out.end(), buf, buf + n);
+  fclose(f);
+  return true;
+}
+
+// ---------- Text scores ----------
+
+static bool parse_note(const std::string &t, uint8_t &note) {
+  static const char NAMES[] = "C-C#D-D#E-F-F#G-G#A-A#B-";
+  if (t == "---" || t == "...") {
+    note = 0;
+    return true;
+  }
+  if (t == "===" || t == "OFF") {
+    note = TRACKER_NOTE_OFF;
+    return true;
+  }
+  if (t.size() != 3 || t[2] < '0' || t[2] > '7') return false;
+  for (int i = 0; i < 12; i++) {
+    if (t[0] == NAMES[2 * i] && t[1] == NAMES[2 * i + 1]) {
+      note = (t[2] - '0') * 12 + i + 1;
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool parse_cell(const std::string &text, Cell &c) {
+  char tok[4][16] = {};
+  int n = sscanf(text.c_str(), "%15s %15s %15s %15s", tok[0], tok[1], tok[2], tok[3]);
+  if (n >= 1 && !parse_note(tok[0], c.note)) return false;
+  if (n >= 2 && strcmp(tok[1], "..")) {
+    char *end;
+    unsigned long v = strtoul(tok[1], &end, 16);
+    if (*end || !v || v > 255) return false;
+    c.inst = (uint8_t)v;
+  }
+  if (n >= 3 && strcmp(tok[2], "..")) {
+    char *end;
+    unsigned long v = strtoul(tok[2], &end, 10);
+    if (*end || v > 64) return false;
+    c.volume = (int)v;
+  }
+  if (n >= 4 && strcmp(tok[3], "...")) {
+    char *end;
+    unsigned long v = strtoul(tok[3], &end, 16);
+    if (*end || strlen(tok[3]) != 3) return false;
+    c.fx = (int)(v >> 8);
+    c.param = (uint8_t)v;
+  }
+  return true;
+}
+
+static bool load_text(const char *path, Song &s) {
+  FILE *f = fopen(path, "r");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  char line[1024];
+  int lineno = 0, pattern = -1;
+  bool ok = true;
+  while (ok && fgets(line, sizeof(line), f)) {
+    lineno++;
+    if (char *semi = strchr(line, ';')) *semi = 0;
+    char word[32];
+    int consumed = 0;
+    if (sscanf(line, "%31s %n", word, &consumed) < 1) continue;
+    const char *rest = line + consumed;
+    unsigned a = 0, b = 0;
+    uint8_t note;
+
+    if (!strcmp(word, "title")) {
+      s.title = rest;
+      while (!s.title.empty() && isspace((unsigned char)s.title.back())) s.title.pop_back();
+    } else if (!strcmp(word, "tempo") && sscanf(rest, "%u", &a) == 1 && a >= 32 && a <= 255) {
+      s.tempo = a;
+    } else if (!strcmp(word, "speed") && sscanf(rest, "%u", &a) == 1 && a >= 1 && a < 32) {
+      s.speed = a;
+    } else if (!strcmp(word, "rows") && sscanf(rest, "%u", &a) == 1 && a >= 1 && a <= TRACKER_MAX_ROWS) {
+      s.rows = a;
+    } else if (!strcmp(word, "channels") && sscanf(rest, "%u", &a) == 1 && a >= 1 && a <= TRACKER_CHANNELS) {
+      s.channels = a;
+    } else if (!strcmp(word, "restart") && sscanf(rest, "%u", &a) == 1) {
+      s.restart = a;
+    } else if (!strcmp(word, "order")) {
+      int n;
+      while (sscanf(rest, "%u %n", &a, &n) == 1) {
+        s.orders.push_back(a);
+        rest += n;
+      }
+    } else if (!strcmp(word, "pattern") && sscanf(rest, "%u", &a) == 1 && a < 256) {
+      pattern = a;
+      s.patterns[pattern].clear();
+    } else if (!strcmp(word, "instrument") && sscanf(rest, "%u %n", &a, &consumed) == 1 && a >= 1 && a < 256) {
+      rest += consumed;
+      char wave[16];
+      if (sscanf(rest, "%15s %n", wave, &consumed) < 1 || wave_by_name(wave) < 0) {
+        fprintf(stderr, "%s:%d: unknown wave\n", path, lineno);
+        ok = false;
+        break;
+      }
+      rest += consumed;
+      if (s.instruments.size() < a) s.instruments.resize(a);
+      Instrument &in = s.instruments[a - 1];
+      in.wave = wave_by_name(wave);
+      in.defined = true;
+      char key[8];
+      while (sscanf(rest, " %7[a-z]=%u%n", key, &b, &consumed) == 2) {
+        rest += consumed;
+        if (!strcmp(key, "vol") && b <= 64)       in.volume = b;
+        else if (!strcmp(key, "a") && b < 65536)  in.attack_ms = b;
+        else if (!strcmp(key, "d") && b < 65536)  in.decay_ms = b;
+        else if (!strcmp(key, "s") && b <= 255)   in.sustain = b;
+        else if (!strcmp(key, "r") && b < 65536)  in.release_ms = b;
+        else {
+          fprintf(stderr, "%s:%d: bad instrument setting %s=%u\n", path, lineno, key, b);
+          ok = false;
+        }
+      }
+    } else if (pattern >= 0 && (strchr(line, '|') || parse_note(word, note))) {
+      std::vector<Cell> row;
+      std::string text(line);
+      size_t start = 0;
+      while (start <= text.size()) {
+        size_t bar = text.find('|', start);
+        std::string cell = text.substr(start, bar == std::string::npos ? std::string::npos : bar - start);
+        Cell c;
+        if (!parse_cell(cell, c)) {
+          fprintf(stderr, "%s:%d: bad cell '%s'\n", path, lineno, cell.c_str());
+          ok = false;
+          break;
+        }
+        row.push_back(c);
+        if (bar == std::string::npos) break;
+        start = bar + 1;
+      }
+      s.patterns[pattern].push_back(row);
+    } else {
+      fprintf(stderr, "%s:%d: cannot parse '%s'\n", path, lineno, word);
+      ok = false;
+    }
+  }
+  fclose(f);
+  return ok;
+}
+
+// ---------- ProTracker modules ----------
+
+static uint16_t be16(const uint8_t *p) { return p[0] << 8 | p[1]; }
+
+static int wave_for_sample(const char *name) {
+  std::string n(name);
+  for (char &ch : n) ch = tolower((unsigned char)ch);
+  static const struct { const char *key; int wave; } KEYS[] = {
+    { "sine", WAVE_SINE }, { "sin", WAVE_SINE }, { "flute", WAVE_SINE },
+    { "tri", WAVE_TRIANGLE }, { "bass", WAVE_TRIANGLE },
+    { "saw", WAVE_SAW }, { "string", WAVE_SAW }, { "brass", WAVE_SAW },
+    { "noise", WAVE_NOISE }, { "drum", WAVE_NOISE }, { "hat", WAVE_NOISE },
+    { "snare", WAVE_NOISE }, { "kick", WAVE_NOISE }, { "crash", WAVE_NOISE },
+    { "sq", WAVE_SQUARE },
+  };
+  for (const auto &k : KEYS) {
+    if (n.find(k.key) != std::string::npos) return k.wave;
+  }
+  return WAVE_SQUARE;
+}
+
+// ProTracker slides are in period units; near C-4 one unit is ~0.65/16 semitone
+static uint8_t slide_units(uint8_t param) {
+  return param ? (uint8_t)(param * 2 / 3 ? param * 2 / 3 : 1) : 0;
+}
+
+static bool load_mod(const std::vector<uint8_t> &raw, const char *path, Song &s, int &dropped) {
+  if (raw.size() < 1084) {
+    fprintf(stderr, "%s: too short for a module\n", path);
+    return false;
+  }
+  const char *tag = (const char *)&raw[1080];
+  if (memcmp(tag, "M.K.", 4) && memcmp(tag, "M!K!", 4) && memcmp(tag, "4CHN", 4) && memcmp(tag, "FLT4", 4)) {
+    fprintf(stderr, "%s: only 4-channel 31-sample modules are supported\n", path);
+    return false;
+  }
+  s.title.assign((const char *)&raw[0], strnlen((const char *)&raw[0], 20));
+  s.channels = 4;
+  s.rows = 64;
+
+  for (int i = 0; i < 31; i++) {
+    const uint8_t *h = &raw[20 + i * 30];
+    char name[23] = {};
+    memcpy(name, h, 22);
+    uint32_t len = be16(h + 22) * 2, loop_len = be16(h + 28) * 2;
+    Instrument in;
+    in.defined = len > 0;
+    in.wave = wave_for_sample(name);
+    in.volume = h[25] > 64 ? 64 : h[25];
+    if (loop_len > 2) {
+      in.sustain = 255;
+      in.decay_ms = 0;
+    } else {
+      in.sustain = 0;                              // one-shot: decay over the sample's length at C-4
+      uint32_t ms = len * 1000 / 8363;
+      in.decay_ms = ms < 40 ? 40 : (ms > 2000 ? 2000 : ms);
+    }
+    s.instruments.push_back(in);
+  }
+  while (!s.instruments.empty() && !s.instruments.back().defined) s.instruments.pop_back();
+
+  uint8_t length = raw[950];
+  s.restart = raw[951] < length ? raw[951] : 0;
+  int max_pattern = 0;
+  for (int i = 0; i < 128; i++) {
+    if (i < length) s.orders.push_back(raw[952 + i]);
+    if (raw[952 + i] > max_pattern) max_pattern = raw[952 + i];
+  }
+  if (raw.size() < 1084 + (size_t)(max_pattern + 1) * 1024) {
+    fprintf(stderr, "%s: truncated pattern data\n", path);
+    return false;
+  }
+
+  for (int p = 0; p <= max_pattern; p++) {
+    Pattern &pat = s.patterns[p];
+    for (int r = 0; r < 64; r++) {
+      std::vector<Cell> row(4);
+      for (int c = 0; c < 4; c++) {
+        const uint8_t *d = &raw[1084 + p * 1024 + r * 16 + c * 4];
+        Cell &cell = row[c];
+        uint8_t sample = (d[0] & 0xF0) | d[2] >> 4;
+        uint16_t period = (d[0] & 0x0F) << 8 | d[1];
+        uint8_t fx = d[2] & 0x0F, param = d[3];
+        if (period) {
+          int n = (int)lround(12 * log2(428.0 / period)) + 48;  // ProTracker C-2 plays as C-4
+          cell.note = (uint8_t)((n < 0 ? 0 : (n > 95 ? 95 : n)) + 1);
+        }
+        if (sample && sample <= s.instruments.size()) cell.inst = sample;
+        switch (fx) {
+          case 0x0: if (param) { cell.fx = 0; cell.param = param; } break;
+          case 0x1: case 0x2: case 0x3:
+            cell.fx = fx; cell.param = slide_units(param); break;
+          case 0x4: case 0xA: case 0xC: case 0xF:
+            cell.fx = fx; cell.param = param; break;
+          case 0x5: cell.fx = 0x3; cell.param = 0; dropped++; break;    // keep the slide, lose the fade
+          case 0x6: cell.fx = 0x4; cell.param = 0; dropped++; break;
+          case 0xB: if (param < length) { cell.fx = fx; cell.param = param; } else dropped++; break;
+          case 0xD: {
+            uint8_t row_no = (param >> 4) * 10 + (param & 0x0F);
+            cell.fx = fx;
+            cell.param = row_no < 64 ? row_no : 0;
+            break;
+          }
+          default: dropped++; break;
+        }
+      }
+      pat.push_back(row);
+    }
+  }
+  return true;
+}
+
+// ---------- Encoding ----------
+
+static void encode_pattern(const Song &s, const Pattern &pat, std::vector<uint8_t> &out) {
+  int empty = 0;
+  auto flush = [&]() {
+    while (empty > 0) {
+      int n = empty > 128 ? 128 : empty;
+      out.push_back(0x80 | (n - 1));
+      empty -= n;
+    }
+  };
+  for (int r = 0; r < s.rows; r++) {
+    uint8_t mask = 0;
+    uint8_t flags[TRACKER_CHANNELS] = {};
+    for (int c = 0; c < s.channels; c++) {
+      if (r >= (int)pat.size() || c >= (int)pat[r].size()) continue;
+      const Cell &cell = pat[r][c];
+      flags[c] = (cell.note ? TRACKER_HAS_NOTE : 0) | (cell.inst ? TRACKER_HAS_INST : 0) |
+                 (cell.volume >= 0 ? TRACKER_HAS_VOLUME : 0) | (cell.fx >= 0 ? TRACKER_HAS_EFFECT : 0);
+      if (flags[c]) mask |= 1 << c;
+    }
+    if (!mask) {
+      empty++;
+      continue;
+    }
+    flush();
+    out.push_back(mask);
+    for (int c = 0; c < s.channels; c++) {
+      if (!flags[c]) continue;
+      const Cell &cell = pat[r][c];
+      out.push_back(flags[c]);
+      if (cell.note) out.push_back(cell.note);
+      if (cell.inst) out.push_back(cell.inst);
+      if (cell.volume >= 0) out.push_back(cell.volume);
+      if (cell.fx >= 0) {
+        out.push_back(cell.fx);
+        out.push_back(cell.param);
+      }
+    }
+  }
+  flush();
+}
+
+static bool build(const Song &s, std::vector<uint8_t> &out, int &unique) {
+  if (s.orders.empty() || s.orders.size() > 255 || s.instruments.empty() || s.instruments.size() > 255) {
+    fprintf(stderr, "need 1-255 orders and 1-255 instruments\n");
+    return false;
+  }
+  for (const auto &kv : s.patterns) {
+    if (kv.second.size() > s.rows) {
+      fprintf(stderr, "pattern %d has %zu rows, more than the song's %u\n", kv.first, kv.second.size(), s.rows);
+      return false;
+    }
+  }
+
+  // Only patterns the order list uses, each distinct encoding stored once
+  std::vector<std::vector<uint8_t>> blobs;
+  std::map<int, int> index;
+  std::vector<uint8_t> orders;
+  for (int o : s.orders) {
+    auto it = s.patterns.find(o);
+    if (it == s.patterns.end()) {
+      fprintf(stderr, "order list names missing pattern %d\n", o);
+      return false;
+    }
+    if (!index.count(o)) {
+      std::vector<uint8_t> blob;
+      encode_pattern(s, it->second, blob);
+      int found = -1;
+      for (size_t i = 0; i < blobs.size(); i++) {
+        if (blobs[i] == blob) found = (int)i;
+      }
+      if (found < 0) {
+        found = (int)blobs.size();
+        blobs.push_back(blob);
+      }
+      index[o] = found;
+    }
+    orders.push_back(index[o]);
+  }
+  unique = (int)blobs.size();
+
+  out.clear();
+  uint32_t magic = TRACKER_MAGIC;
+  for (int i = 0; i < 4; i++) out.push_back(magic >> (8 * i));
+  out.push_back(s.channels);
+  out.push_back(s.instruments.size());
+  out.push_back(blobs.size());
+  out.push_back(orders.size());
+  out.push_back(s.speed);
+  out.push_back(s.tempo);
+  out.push_back(s.restart < orders.size() ? s.restart : 0);
+  out.push_back(s.rows);
+  char title[TRACKER_TITLE_LEN] = {};
+  memcpy(title, s.title.c_str(), s.title.size() < TRACKER_TITLE_LEN ? s.title.size() : TRACKER_TITLE_LEN);
+  out.insert(out.end(), title, title + TRACKER_TITLE_LEN);
+
+  for (const Instrument &in : s.instruments) {
+    uint8_t rec[TRACKER_INST_BYTES] = { in.wave, in.volume, in.sustain, 0,
+                                        (uint8_t)in.attack_ms, (uint8_t)(in.attack_ms >> 8),
+                                        (uint8_t)in.decay_ms, (uint8_t)(in.decay_ms >> 8),
+                                        (uint8_t)in.release_ms, (uint8_t)(in.release_ms >> 8) };
+    out.insert(out.end(), rec, rec + TRACKER_INST_BYTES);
+  }
+  out.insert(out.end(), orders.begin(), orders.end());
+  size_t table = out.size();
+  out.resize(out.size() + 2 * blobs.size());
+  for (size_t i = 0; i < blobs.size(); i++) {
+    if (out.size() > 0xFFFF) {
+      fprintf(stderr, "song is over 64 KB\n");
+      return false;
+    }
+    out[table + 2 * i] = out.size() & 0xFF;
+    out[table + 2 * i + 1] = out.size() >> 8;
+    out.insert(out.end(), blobs[i].begin(), blobs[i].end());
+  }
+  return true;
+}
+
+// ---------- Output ----------
+
+static bool write_file(const char *path, const std::vector<uint8_t> &data) {
+  FILE *f = fopen(path, "wb");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  fwrite(data.data(), 1, data.size(), f);
+  fclose(f);
+  return true;
+}
+
+static bool write_header(const char *path, const char *symbol, const char *source, const std::string &title,
+                         const std::vector<uint8_t> &data) {
+  FILE *f = fopen(path, "w");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  std::string base(path);
+  size_t slash = base.find_last_of('/');
+  if (slash != std::string::npos) base = base.substr(slash + 1);
+  std::string guard;
+  for (size_t i = 0; i < base.size(); i++) {        // DemoSong.h -> DEMO_SONG_H
+    unsigned char ch = base[i];
+    if (i && isupper(ch) && islower((unsigned char)base[i - 1])) guard += '_';
+    guard += isalnum(ch) ? toupper(ch) : '_';
+  }
+  const char *src = strrchr(source, '/') ? strrchr(source, '/') + 1 : source;
+
+  fprintf(f, "/*\n * %s - \"%s\", a Tracker.h song\n *\n", base.c_str(), title.c_str());
+  fprintf(f, " * Generated by tools/tracker_convert from %s; edit that and convert again.\n */\n\n", src);
+  fprintf(f, "#ifndef %s\n#define %s\n\n#include <stdint.h>\n\n", guard.c_str(), guard.c_str());
+  fprintf(f, "static const uint8_t %s[%zu] = {", symbol, data.size());
+  for (size_t i = 0; i < data.size(); i++) fprintf(f, "%s0x%02X,", i % 16 ? " " : "\n  ", data[i]);
+  fprintf(f, "\n};\n\n#endif // %s\n", guard.c_str());
+  fclose(f);
+  return true;
+}
+
+static bool write_wav(const char *path, const std::vector<int16_t> &pcm, uint32_t rate) {
+  FILE *f = fopen(path, "wb");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  uint32_t data = pcm.size() * 2, riff = 36 + data, fmt_len = 16, byte_rate = rate * 2;
+  uint16_t pcm_fmt = 1, channels = 1, align = 2, bits = 16;
+  fwrite("RIFF", 1, 4, f); fwrite(&riff, 4, 1, f); fwrite("WAVE", 1, 4, f);
+  fwrite("fmt ", 1, 4, f); fwrite(&fmt_len, 4, 1, f);
+  fwrite(&pcm_fmt, 2, 1, f); fwrite(&channels, 2, 1, f); fwrite(&rate, 4, 1, f);
+  fwrite(&byte_rate, 4, 1, f); fwrite(&align, 2, 1, f); fwrite(&bits, 2, 1, f);
+  fwrite("data", 1, 4, f); fwrite(&data, 4, 1, f);
+  fwrite(pcm.data(), 2, pcm.size(), f);
+  fclose(f);
+  return true;
+}
+
+int main(int argc, char **argv) {
+  const char *in = nullptr, *out = nullptr, *header = nullptr, *symbol = nullptr, *wav = nullptr;
+  uint32_t rate = 24000;
+  std::map<int, int> wave_override;
+  bool usage = false;
+  for (int i = 1; i < argc && !usage; i++) {
+    bool has_val = i + 1 < argc;
+    if (!strcmp(argv[i], "--header") && has_val)    header = argv[++i];
+    else if (!strcmp(argv[i], "--name") && has_val) symbol = argv[++i];
+    else if (!strcmp(argv[i], "--wav") && has_val)  wav = argv[++i];
+    else if (!strcmp(argv[i], "--rate") && has_val) rate = strtoul(argv[++i], nullptr, 10);
+    else if (!strcmp(argv[i], "--wave") && has_val) {
+      char name[16];
+      int n;
+      if (sscanf(argv[++i], "%d=%15s", &n, name) != 2 || wave_by_name(name) < 0) usage = true;
+      else wave_override[n] = wave_by_name(name);
+    }
+    else if (argv[i][0] != '-' && !in)              in = argv[i];
+    else if (argv[i][0] != '-' && !out)             out = argv[i];
+    else usage = true;
+  }
+  if (usage || !in || !out || (header && !symbol) || rate < 8000) {
+    fprintf(stderr, "usage: %s in.txt|in.mod out.trk [--header out.h --name SYMBOL] [--wav preview.wav]\n"
+                    "       [--wave N=sine|square|triangle|saw|noise]... [--rate HZ]\n", argv[0]);
+    return 1;
+  }
+
+  Song song;
+  int dropped = 0;
+  const char *ext = strrchr(in, '.');
+  if (ext && !strcasecmp(ext, ".mod")) {
+    std::vector<uint8_t> raw;
+    if (!read_file(in, raw) || !load_mod(raw, in, song, dropped)) return 1;
+  } else if (!load_text(in, song)) {
+    return 1;
+  }
+  for (const auto &w : wave_override) {
+    if (w.first < 1 || w.first > (int)song.instruments.size()) {
+      fprintf(stderr, "--wave: no instrument %d\n", w.first);
+      return 1;
+    }
+    song.instruments[w.first - 1].wave = w.second;
+  }
+
+  std::vector<uint8_t> data;
+  int unique = 0;
+  if (!build(song, data, unique)) return 1;
+  TrackerInfo info;
+  if (!tracker_validate(data.data(), data.size(), &info)) {
+    fprintf(stderr, "internal error: the player rejects the converted song\n");
+    return 1;
+  }
+  if (!write_file(out, data)) return 1;
+  if (header && !write_header(header, symbol, in, song.title, data)) return 1;
+
+  // Play it once through, as the watch would, to time it
+  synth_init(rate);
+  tracker_init(rate, 0);
+  tracker_play(data.data(), data.size(), false);
+  std::vector<int16_t> pcm;
+  int16_t block[BLOCK];
+  uint64_t frames = 0, tracker_ns = 0, synth_ns = 0;
+  using clk = std::chrono::steady_clock;
+  while (frames < (uint64_t)MAX_SECONDS * rate) {
+    auto t0 = clk::now();
+    uint32_t n = tracker_service((uint32_t)frames);
+    auto t1 = clk::now();
+    tracker_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    if (n == UINT32_MAX && synth_active_voices() == 0) break;
+    if (n > BLOCK) n = BLOCK;
+    if (!synth_render(block, n)) memset(block, 0, n * sizeof(int16_t));
+    synth_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(clk::now() - t1).count();
+    if (wav) pcm.insert(pcm.end(), block, block + n);
+    frames += n;
+  }
+
+  double seconds = (double)frames / rate;
+  printf("\"%s\": %u channels, %u instruments, %u orders, %d patterns (%zu in the source), %u rows\n",
+         info.title, info.channels, info.instruments, info.orders, unique, song.patterns.size(), info.rows);
+  printf("%zu bytes for %d:%04.1f (%.0f bytes/min)%s\n", data.size(), (int)seconds / 60,
+         fmod(seconds, 60), data.size() * 60 / (seconds > 0 ? seconds : 1),
+         frames >= (uint64_t)MAX_SECONDS * rate ? ", preview cut off" : "");
+  printf("host: tracker %.1f us per second of music, synth %.1f ns/sample\n",
+         seconds > 0 ? tracker_ns / 1000.0 / seconds : 0.0, frames ? (double)synth_ns / frames : 0.0);
+  if (dropped) printf("%d unsupported effects dropped\n", dropped);
+
+  if (wav && !write_wav(wav, pcm, rate)) return 1;
+  return 0;
+}